@@ -1,10 +1,16 @@
 #include "app.h"
 #include "appconfig.h"
 #include "engine/engine.h"
+#include "engine/random.h"
+#include "engine/memorystats.h"
 #include "app_state/game.h"
 #include "app_state/menu.h"
 #include "soundmanager.h"
+#include "eventbus.h"
+#include "inputmanager.h"
 
+#include <algorithm>
+#include <csignal>
 #include <ctime>
 #include <iostream>
 #include <stdlib.h>
@@ -14,17 +20,40 @@
 
 #define VERSION "1.2.1"
 
-// Construtor da classe App. Inicializa ponteiro da janela como nulo.
+// Modo turbo: nenhum tick é maior que um frame normal, então o passo da simulação não muda com o multiplicador
+static const Uint32 TURBO_MAX_TICK = 16;
+// Modo turbo sem limite: tempo de atualização por frame apresentado
+static const Uint32 TURBO_FRAME_TIME = 15;
+
+// Consumidor dos eventos da partida: sons (respeitando o silêncio do modo turbo) e estatísticas
+static void deliverEvent(const GameEvent& event)
+{
+    SoundManager::getInstance().playEvent(event);
+    EventStats::record(event);
+}
+
+// Construtor da classe App. Inicializa o ponteiro da janela como nulo e registra o consumidor dos eventos da partida.
 App::App()
 {
     m_window = nullptr;
+    EventBus::getInstance().setConsumer(deliverEvent);
+}
+
+// Tratador de SIGUSR1: o relatório de memória é gravado no próximo frame, fora do tratador
+static void requestMemoryReport(int)
+{
+    MemoryStats::requestDump();
 }
 
-// Destrutor da classe App. Libera o estado atual da aplicação, se existir.
+// Destrutor da classe App. Libera os estados da pilha, do topo para a base.
 App::~App()
 {
-    if(m_app_state != nullptr)
-        delete m_app_state;
+    EventBus::getInstance().setConsumer(nullptr);
+    while(!m_states.empty())
+    {
+        delete m_states.back();
+        m_states.pop_back();
+    }
 }
 
 // Função principal que executa o loop do aplicativo.
@@ -40,6 +69,9 @@ void App::run()
         if (!SoundManager::getInstance().init()) return;
         SoundManager::getInstance().loadSounds();
 
+        // Abre os controles conectados (mantidos em cache pelo InputManager)
+        InputManager::getInstance().init();
+
         // Cria a janela principal do jogo
         m_window = SDL_CreateWindow("TANKS", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
                                     AppConfig::windows_rect.w, AppConfig::windows_rect.h, SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE);
@@ -51,8 +83,8 @@ void App::run()
         // Inicializa suporte a fontes TrueType
         if(TTF_Init() == -1) return;
 
-        // Inicializa o gerador de números aleatórios
-        srand(time(NULL));
+        // Inicializa o gerador de números aleatórios da simulação
+        Random::getInstance().seed(time(NULL));
 
         // Inicializa os módulos do motor gráfico
         Engine& engine = Engine::getEngine();
@@ -61,7 +93,12 @@ void App::run()
         engine.getRenderer()->loadFont();
 
         // Estado inicial do aplicativo é o menu principal
-        m_app_state = new Menu;
+        m_states.push_back(new Menu);
+        // Objetos vivos no menu sem partida: referência para encontrar vazamentos ao voltar ao menu
+        MemoryStats::markBaseline();
+#ifdef SIGUSR1
+        if(!AppConfig::memory_report_path.empty()) std::signal(SIGUSR1, requestMemoryReport);
+#endif
 
         double FPS;
         Uint32 time1, time2, dt, fps_time = 0, fps_count = 0, delay = 15;
@@ -70,29 +107,37 @@ void App::run()
         // Loop principal do aplicativo
         while(is_running)
         {
+            // Aguarda um pequeno tempo para controlar o FPS.
+            // A espera fica antes da leitura de eventos para que a entrada seja amostrada
+            // o mais perto possível da atualização e da apresentação do frame.
+            // Sem limite de multiplicador, o frame inteiro é usado para atualizar.
+            if(AppConfig::turbo != 0) SDL_Delay(delay);
+
             time2 = SDL_GetTicks();
             dt = time2 - time1;
             time1 = time2;
 
-            // Verifica se o estado atual terminou e troca para o próximo estado
-            if(m_app_state->finished())
-            {
-                AppState* new_state = m_app_state->nextState();
-                delete m_app_state;
-                m_app_state = new_state;
-            }
-            if(m_app_state == nullptr) break;
+            // Empilha, desempilha ou troca o estado atual
+            updateStack();
+            if(m_states.empty()) break;
+            if(MemoryStats::dumpRequested()) MemoryStats::writeJson(AppConfig::memory_report_path);
 
             // Processa eventos de entrada (teclado, mouse, janela)
             eventProces();
+            if(AppConfig::turbo == 1)
+            {
+                // Aplica ao tick os pressionamentos capturados desde o tick anterior
+                InputManager::getInstance().beginTick();
 
-            // Atualiza a lógica do estado atual
-            m_app_state->update(dt);
+                // Atualiza a lógica do estado atual
+                m_states.back()->update(dt);
+                dispatchEvents();
+            }
+            else
+                updateTurbo(dt);
             // Desenha o estado atual na tela
-            m_app_state->draw();
-
-            // Aguarda um pequeno tempo para controlar o FPS
-            SDL_Delay(delay);
+            drawStates();
+            InputManager::getInstance().framePresented();
 
             // Cálculo e ajuste dinâmico do FPS
             fps_time += dt; 
@@ -107,6 +152,15 @@ void App::run()
             }
         }
 
+        // Encerra os estados; o relatório de memória mostra os picos, os recursos ainda carregados e os vazamentos
+        while(!m_states.empty())
+        {
+            delete m_states.back();
+            m_states.pop_back();
+        }
+        MemoryStats::checkLeaks("fim do programa", true);
+        if(!AppConfig::memory_report_path.empty()) MemoryStats::writeJson(AppConfig::memory_report_path);
+
         // Libera recursos dos módulos do motor gráfico
         engine.destroyModules();
     }
@@ -117,12 +171,89 @@ void App::run()
 
     // No final da run()
     SoundManager::getInstance().cleanup();
+    InputManager::getInstance().cleanup();
 
     TTF_Quit();
     IMG_Quit();
     SDL_Quit();
 }
 
+// Aplica a troca de estado pedida pelo estado do topo
+void App::updateStack()
+{
+    AppState* top = m_states.back();
+
+    // Novo estado sobre o atual, que fica suspenso
+    AppState* pushed = top->pushState();
+    if(pushed != nullptr)
+    {
+        top->suspend();
+        m_states.push_back(pushed);
+        return;
+    }
+    if(!top->finished()) return;
+
+    AppState* next = top->nextState();
+    if(next == nullptr && m_states.size() > 1)
+    {
+        // Fim de um estado empilhado: o de baixo volta sem ser reconstruído
+        delete top;
+        m_states.pop_back();
+        m_states.back()->resume();
+        return;
+    }
+
+    // Troca de cena: a pilha inteira é substituída (vazia: fim da aplicação)
+    while(!m_states.empty())
+    {
+        delete m_states.back();
+        m_states.pop_back();
+    }
+    if(next == nullptr) return;
+    m_states.push_back(next);
+    // A partida terminou: nada dela deve continuar vivo
+    if(dynamic_cast<Menu*>(next) != nullptr) MemoryStats::checkLeaks("volta ao menu");
+}
+
+// Desenha o estado atual, sobre os estados de baixo se for uma sobreposição
+void App::drawStates()
+{
+    Renderer* renderer = Engine::getEngine().getRenderer();
+    renderer->clear();
+    std::size_t first = m_states.size() - 1;
+    while(first > 0 && m_states[first]->overlay()) first--;
+    for(std::size_t i = first; i < m_states.size(); i++) m_states[i]->draw();
+    renderer->flush();
+}
+
+// Executa vários ticks por frame; apenas o último estado é desenhado
+void App::updateTurbo(Uint32 dt)
+{
+    SoundManager& sound = SoundManager::getInstance();
+    unsigned turbo = AppConfig::turbo;
+    Uint32 tick_dt = std::min(dt, TURBO_MAX_TICK);
+    Uint32 start = SDL_GetTicks();
+
+    for(unsigned i = 0; turbo == 0 || i < turbo; i++)
+    {
+        sound.setMuted(turbo == 0 || i + 1 < turbo);
+        InputManager::getInstance().beginTick();
+        m_states.back()->update(tick_dt);
+        dispatchEvents();
+
+        // O estado terminou: a troca acontece no início do próximo frame
+        if(m_states.back()->finished()) break;
+        if(turbo == 0 && SDL_GetTicks() - start >= TURBO_FRAME_TIME) break;
+    }
+    sound.setMuted(false);
+}
+
+// Os sons seguem o silêncio do modo turbo (ver updateTurbo)
+void App::dispatchEvents()
+{
+    EventBus::getInstance().flush();
+}
+
 // Processa todos os eventos SDL (teclado, mouse, janela, etc)
 void App::eventProces()
 {
@@ -152,8 +283,23 @@ void App::eventProces()
                 );
             }
         }
+        else if(event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_TAB && event.key.repeat == 0)
+        {
+            // Modo turbo: 1x -> 2x -> 4x -> 16x -> sem limite -> 1x
+            switch(AppConfig::turbo)
+            {
+            case 1: AppConfig::turbo = 2; break;
+            case 2: AppConfig::turbo = 4; break;
+            case 4: AppConfig::turbo = 16; break;
+            case 16: AppConfig::turbo = 0; break;
+            default: AppConfig::turbo = 1; break;
+            }
+        }
+
+        // Atualiza o cache de controles (conexão/desconexão)
+        InputManager::getInstance().eventProcess(&event);
 
-        // Encaminha o evento para o estado atual do aplicativo
-        m_app_state->eventProcess(&event);
+        // Encaminha o evento para o estado do topo da pilha; os suspensos não recebem eventos
+        m_states.back()->eventProcess(&event);
     }
 }
@@ -3,6 +3,8 @@
 
 #include "app_state/appstate.h"
 
+#include <vector>
+
 /**
  * @brief
  * Classe principal da aplicação. Sua execução representa o ciclo de vida da aplicação.
@@ -17,8 +19,9 @@ public:
      * Executa a aplicação.
      * Responsável por inicializar a biblioteca SDL2, o motor do jogo, carregar texturas e fontes.
      * Após a inicialização bem-sucedida, entra no loop principal do programa, que:
+     *   - aplica as trocas de estado (empilhar, desempilhar, substituir),
      *   - processa eventos,
-     *   - atualiza o estado atual da aplicação,
+     *   - atualiza o estado do topo da pilha,
      *   - desenha os objetos na tela.
      */
     void run();
@@ -30,6 +33,32 @@ public:
     void eventProces();
 
 private:
+    friend class Soak;
+
+    /**
+     * Aplica a troca pedida pelo estado do topo: empilha o estado de pushState(), desempilha o estado que terminou
+     * sem próximo estado (o de baixo volta ao topo) ou substitui a pilha inteira pelo próximo estado.
+     */
+    void updateStack();
+
+    /**
+     * Modo turbo: executa várias atualizações do estado atual antes de desenhar o frame.
+     * Os sons tocam apenas no último tick de cada frame (e em nenhum sem limite de multiplicador).
+     * @param dt - tempo desde o frame anterior
+     */
+    void updateTurbo(Uint32 dt);
+
+    /**
+     * Limpa a tela, desenha o estado do topo (e os de baixo, se ele for uma sobreposição) e apresenta o frame.
+     */
+    void drawStates();
+
+    /**
+     * Entrega aos consumidores (sons e estatísticas) os eventos da partida ainda pendentes no @a EventBus (a partida
+     * já entrega os de cada fase do tick). Chamada depois de cada atualização, fora das colisões.
+     */
+    void dispatchEvents();
+
     /**
      * Variável que mantém o loop principal do programa em execução.
      * Quando false, o loop principal é encerrado e a aplicação termina.
@@ -37,10 +66,10 @@ private:
     bool is_running;
 
     /**
-     * Ponteiro para o estado atual da aplicação (menu, jogo, etc).
-     * Permite alternar entre diferentes estados da aplicação.
+     * Pilha de estados da aplicação (menu, jogo, placar, menu de pausa...). O último é o estado atual;
+     * os demais estão suspensos. Vazia: a aplicação termina.
      */
-    AppState* m_app_state;
+    std::vector<AppState*> m_states;
 
     /**
      * Ponteiro para o objeto da janela principal da aplicação.
@@ -8,6 +8,10 @@
  * @brief
  * Classe interface base para os estados do aplicativo/jogo.
  * As classes @a Game, @a Menu, @a Scores devem herdar desta interface.
+ *
+ * Os estados ficam em uma pilha (@a App): apenas o do topo recebe eventos e atualizações. Um estado pode empilhar
+ * outro sobre si (pushState), como o menu de pausa sobre a partida; o de baixo fica suspenso, com tudo o que carregou,
+ * e volta sem ser reconstruído quando o de cima termina.
  */
 class AppState 
 {
@@ -22,6 +26,7 @@ public:
 
     /**
      * Desenha os elementos do jogo pertencentes a este estado.
+     * A tela é limpa e apresentada pelo @a App, que desenha antes os estados de baixo das sobreposições (ver overlay).
      */
     virtual void draw() = 0;
 
@@ -43,6 +48,30 @@ public:
      * @return próximo estado do jogo.
      */
     virtual AppState* nextState() = 0;
+
+    /**
+     * Estado a empilhar sobre este (ex.: menu de pausa), verificado a cada frame enquanto este estiver no topo.
+     * O novo estado passa a pertencer ao @a App. Quando ele terminar, se o seu nextState() retornar nullptr,
+     * ele é desempilhado e este estado volta ao topo; qualquer outro estado substitui a pilha inteira.
+     * @return estado a empilhar, ou nullptr
+     */
+    virtual AppState* pushState() { return nullptr; }
+
+    /**
+     * Chamada quando outro estado é empilhado sobre este. Não recebe eventos nem atualizações até resume().
+     */
+    virtual void suspend() {}
+
+    /**
+     * Chamada quando o estado de cima termina e este volta ao topo da pilha.
+     */
+    virtual void resume() {}
+
+    /**
+     * Indica se o estado é desenhado sobre o de baixo (ex.: uma janela sobre a partida), em vez de ocupar a tela toda.
+     * @return @a true para sobreposições
+     */
+    virtual bool overlay() const { return false; }
 };
 
 #endif // APPSTATE_H
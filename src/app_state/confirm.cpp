@@ -0,0 +1,73 @@
+#include "confirm.h"
+#include "../engine/engine.h"
+#include "../appconfig.h"
+
+Confirm::Confirm(const char* question, bool* answer)
+{
+    m_question = question;
+    m_answer = answer;
+    m_yes = false;
+    m_finished = false;
+}
+
+bool Confirm::finished() const
+{
+    return m_finished;
+}
+
+// Janela menor que o menu de pausa, com a pergunta e as opções lado a lado
+void Confirm::draw()
+{
+    Renderer* renderer = Engine::getEngine().getRenderer();
+
+    SDL_Rect box = {(AppConfig::map_rect.w + AppConfig::status_rect.w - 200) / 2, AppConfig::map_rect.h / 2 - 30, 200, 60};
+    renderer->drawRect(&box, {0, 0, 0, 255}, true);
+    renderer->drawRect(&box, {255, 255, 255, 255});
+
+    SDL_Point pos = {-1, box.y + 8};
+    renderer->drawText(&pos, m_question, {255, 255, 255, 255}, 2);
+    pos = {box.x + 50, box.y + 34};
+    renderer->drawText(&pos, "Yes", m_yes ? SDL_Color{255, 255, 0, 255} : SDL_Color{255, 255, 255, 255}, 2);
+    pos = {box.x + 120, box.y + 34};
+    renderer->drawText(&pos, "No", m_yes ? SDL_Color{255, 255, 255, 255} : SDL_Color{255, 255, 0, 255}, 2);
+}
+
+void Confirm::update(Uint32 dt)
+{
+    (void)dt;
+}
+
+// Processa teclado e botões do controle
+void Confirm::eventProcess(SDL_Event *ev)
+{
+    if(ev->type == SDL_KEYDOWN)
+    {
+        SDL_Keycode key = ev->key.keysym.sym;
+        if(key == SDLK_LEFT || key == SDLK_RIGHT || key == SDLK_UP || key == SDLK_DOWN) m_yes = !m_yes;
+        else if(key == SDLK_RETURN || key == SDLK_SPACE) answer(m_yes);
+        else if(key == SDLK_ESCAPE) answer(false);
+    }
+    else if(ev->type == SDL_CONTROLLERBUTTONDOWN)
+    {
+        Uint8 button = ev->cbutton.button;
+        if(button == SDL_CONTROLLER_BUTTON_DPAD_LEFT || button == SDL_CONTROLLER_BUTTON_DPAD_RIGHT) m_yes = !m_yes;
+        else if(button == SDL_CONTROLLER_BUTTON_A || button == SDL_CONTROLLER_BUTTON_START) answer(m_yes);
+        else if(button == SDL_CONTROLLER_BUTTON_B || button == SDL_CONTROLLER_BUTTON_BACK) answer(false);
+    }
+}
+
+AppState* Confirm::nextState()
+{
+    return nullptr;
+}
+
+bool Confirm::overlay() const
+{
+    return true;
+}
+
+void Confirm::answer(bool yes)
+{
+    *m_answer = yes;
+    m_finished = true;
+}
@@ -0,0 +1,65 @@
+#ifndef CONFIRM_H
+#define CONFIRM_H
+
+#include "appstate.h"
+
+/**
+ * @brief
+ * Janela de confirmação (Yes/No) exibida sobre outro estado. A resposta é gravada em uma variável do estado
+ * de baixo antes de a janela ser desempilhada, para que ele a leia em resume().
+ */
+class Confirm : public AppState
+{
+public:
+    /**
+     * @param question - pergunta exibida (texto constante)
+     * @param answer - recebe @a true se a resposta for "Yes"; deve continuar válido enquanto a janela existir
+     */
+    Confirm(const char* question, bool* answer);
+
+    /**
+     * @return @a true após a resposta
+     */
+    bool finished() const override;
+
+    /**
+     * Desenha a pergunta e as opções no centro da tela.
+     */
+    void draw() override;
+
+    /**
+     * A janela não tem animação.
+     * @param dt - tempo desde a última chamada da função
+     */
+    void update(Uint32 dt) override;
+
+    /**
+     * Setas mudam a opção; Enter, Espaço, A ou Start respondem; Esc, B ou Back respondem "No".
+     * @param ev - ponteiro para a união SDL_Event contendo o tipo e parâmetros dos eventos
+     */
+    void eventProcess(SDL_Event* ev) override;
+
+    /**
+     * @return nullptr: a janela é desempilhada
+     */
+    AppState* nextState() override;
+
+    /**
+     * @return @a true: o estado de baixo continua visível
+     */
+    bool overlay() const override;
+
+private:
+    /**
+     * Grava a resposta e termina a janela.
+     * @param yes - resposta
+     */
+    void answer(bool yes);
+
+    const char* m_question; ///< Pergunta exibida.
+    bool* m_answer;         ///< Recebe a resposta.
+    bool m_yes;             ///< Opção selecionada.
+    bool m_finished;        ///< Resposta dada.
+};
+
+#endif // CONFIRM_H
@@ -1,9 +1,14 @@
 #include "game.h"
 #include "../engine/engine.h"
+#include "../engine/random.h"
+#include "../engine/memorystats.h"
+#include "../engine/jobsystem.h"
 #include "../appconfig.h"
-#include "../soundmanager.h"
+#include "../eventbus.h"
+#include "../inputmanager.h"
 #include "menu.h"
 #include "scores.h"
+#include "pausemenu.h"
 
 #include <SDL2/SDL.h>
 #include <stdlib.h>
@@ -12,67 +17,94 @@
 #include <algorithm>
 #include <iostream>
 #include <cmath>
+#include <climits>
+
+// Índices por tarefa nas fases paralelas: abaixo disso o laço roda na thread do jogo
+static const unsigned TARGET_GRAIN = 256;
+static const unsigned ENEMY_GRAIN = 64;
+
+// Números de rodada fora de 1..35 dão a volta
+static int wrapLevel(int level)
+{
+    if(level > 35) return 1;
+    if(level < 0) return 35;
+    return level;
+}
 
 // Construtor padrão do jogo
 Game::Game()
 {
+    m_timers = new TimerWheel;
+    TimerWheel::setActive(m_timers);
     m_level_columns_count = 0;
     m_level_rows_count = 0;
+    m_level_dirty = true;
+    m_level_streamed = false;
+    m_spawn_cells_valid = false;
+    m_chunk_capacity = 0;
+    m_chunk_tick = 0;
+    m_saved_reserve = 0;
     m_current_level = 0;
     m_eagle = nullptr;
     m_player_count = 1;
-    m_enemy_redy_time = 0;
     m_pause = false;
-    m_level_end_time = 0;
     m_protect_eagle = false;
-    m_protect_eagle_time = 0;
     m_enemy_respown_position = 0;
+    m_pause_menu = false;
+    m_rewind = new RewindBuffer(AppConfig::rewind_buffer_size, AppConfig::rewind_max_frames, AppConfig::rewind_keyframe_interval);
+    m_rewinding = false;
+    m_scripted_input = nullptr;
+    m_phase_times = nullptr;
     nextLevel();
 }
 
 // Construtor do jogo com quantidade de jogadores
-Game::Game(int players_count)
+Game::Game(int players_count, int start_level)
 {
+    m_timers = new TimerWheel;
+    TimerWheel::setActive(m_timers);
     m_level_columns_count = 0;
     m_level_rows_count = 0;
-    m_current_level = 0;
+    m_level_dirty = true;
+    m_level_streamed = false;
+    m_spawn_cells_valid = false;
+    m_chunk_capacity = 0;
+    m_chunk_tick = 0;
+    m_saved_reserve = 0;
+    m_current_level = start_level - 1;
     m_eagle = nullptr;
     m_player_count = players_count;
     m_pause = false;
-    m_level_end_time = 0;
     m_protect_eagle = false;
-    m_protect_eagle_time = 0;
     m_enemy_respown_position = 0;
+    m_pause_menu = false;
+    m_rewind = new RewindBuffer(AppConfig::rewind_buffer_size, AppConfig::rewind_max_frames, AppConfig::rewind_keyframe_interval);
+    m_rewinding = false;
+    m_scripted_input = nullptr;
+    m_phase_times = nullptr;
     nextLevel();
 }
 
 // Construtor do jogo com jogadores existentes e nível anterior
-Game::Game(std::vector<Player *> players, int previous_level)
+Game::Game(EntityPool<Player>&& players, int previous_level)
 {
-    m_level_columns_count = 0;
-    m_level_rows_count = 0;
+    m_timers = new TimerWheel;
     m_current_level = previous_level;
     m_eagle = nullptr;
-    m_players = players;
-    m_player_count = m_players.size();
-    for(auto player : m_players)
-    {
-        player->clearFlag(TSF_MENU);
-        player->lives_count++;
-        player->respawn();
-    }
-    m_pause = false;
-    m_level_end_time = 0;
-    m_protect_eagle = false;
-    m_protect_eagle_time = 0;
-    m_enemy_respown_position = 0;
-    nextLevel();
+    m_rewind = new RewindBuffer(AppConfig::rewind_buffer_size, AppConfig::rewind_max_frames, AppConfig::rewind_keyframe_interval);
+    m_scripted_input = nullptr;
+    m_phase_times = nullptr;
+    continueLevel(std::move(players));
 }
 
 // Destrutor do jogo
 Game::~Game()
 {
+    // A partida pode ser destruída suspensa: os objetos cancelam seus temporizadores na roda ativa
+    TimerWheel::setActive(m_timers);
     clearLevel();
+    delete m_rewind;
+    delete m_timers;
 }
 
 // Desenha todos os elementos do jogo na tela
@@ -80,31 +112,42 @@ void Game::draw()
 {
     Engine& engine = Engine::getEngine();
     Renderer* renderer = engine.getRenderer();
-    renderer->clear();
 
     if(m_level_start_screen)
     {
-        std::string level_name = "STAGE " + Engine::intToString(m_current_level);
+        char level_name[20] = "STAGE ";
+        Engine::intToString(m_current_level, level_name + 6);
         renderer->drawText(nullptr, level_name, {255, 255, 255, 255}, 1);
     }
     else
     {
         renderer->drawRect(&AppConfig::map_rect, {0, 0, 0, 0}, true);
-        for(auto row : m_level)
-            for(auto item : row)
-                if(item != nullptr) item->draw();
+
+        m_camera.setWorld(AppConfig::level_rect, AppConfig::map_rect.w, AppConfig::map_rect.h);
+        m_camera.follow(cameraCenter());
+        renderer->setView(&m_camera.view());
+
+        // Terreno e arbustos: apenas as células à vista; os demais objetos fora da vista são descartados pelo renderizador
+        SDL_Point first, last;
+        m_camera.visibleTiles(AppConfig::tile_rect, m_level_columns_count, m_level_rows_count, first, last);
+        for(int i = first.y; i <= last.y; i++)
+            for(int j = first.x; j <= last.x; j++)
+                if(tileAt(i, j) != nullptr) tileAt(i, j)->draw();
 
         for(auto player : m_players) player->draw();
         for(auto enemy : m_enemies) enemy->draw();
-        for(auto bush : m_bushes) bush->draw();
+        for(int i = first.y; i <= last.y; i++)
+            for(int j = first.x; j <= last.x; j++)
+                if(bushAt(i, j) != nullptr) bushAt(i, j)->draw();
         for(auto bonus : m_bonuses) bonus->draw();
         m_eagle->draw();
+        renderer->setView(nullptr);
 
         if(m_game_over)
         {
             SDL_Point pos;
             pos.x = -1;
-            pos.y = m_game_over_position;
+            pos.y = m_game_over_position.toInt();
             renderer->drawText(&pos, AppConfig::game_over_text, {255, 10, 10, 255});
         }
 
@@ -120,26 +163,56 @@ void Game::draw()
         }
         // vidas dos jogadores
         int i = 0;
+        char number[12];
         for(auto player : m_players)
         {
             dst = {AppConfig::status_rect.x + 5, i * 18 + 180, 16, 16};
             p_dst = {dst.x + dst.w + 2, dst.y + 3};
             i++;
             renderer->drawObject(&player->src_rect, &dst);
-            renderer->drawText(&p_dst, Engine::intToString(player->lives_count), {0, 0, 0, 255}, 3);
+            renderer->drawText(&p_dst, Engine::intToString(player->lives_count, number), {0, 0, 0, 255}, 3);
         }
         // número do mapa/nível
         src = engine.getSpriteConfig()->getSpriteData(ST_STAGE_STATUS)->rect;
         dst = {AppConfig::status_rect.x + 8, static_cast<int>(185 + (m_players.size() + m_killed_players.size()) * 18), src.w, src.h};
         p_dst = {dst.x + 10, dst.y + 26};
         renderer->drawObject(&src, &dst);
-        renderer->drawText(&p_dst, Engine::intToString(m_current_level), {0, 0, 0, 255}, 2);
+        renderer->drawText(&p_dst, Engine::intToString(m_current_level, number), {0, 0, 0, 255}, 2);
+        // multiplicador do modo turbo
+        if(AppConfig::turbo != 1)
+        {
+            char turbo[12] = "x";
+            Engine::intToString(AppConfig::turbo, turbo + 1);
+            p_dst = {dst.x, dst.y + dst.h + 8};
+            renderer->drawText(&p_dst, AppConfig::turbo == 0 ? "MAX" : turbo, {0, 0, 0, 255}, 3);
+        }
 
         if(m_pause)
-            renderer->drawText(nullptr, std::string("PAUSE"), {200, 0, 0, 255}, 1);
+            renderer->drawText(nullptr, "PAUSE", {200, 0, 0, 255}, 1);
+        else if(m_rewinding)
+            renderer->drawText(nullptr, "REWIND", {200, 200, 200, 255}, 1);
     }
 
-    renderer->flush();
+    // Painel de memória (depuração): bytes vivos e pico de cada categoria, seguidos da contagem de eventos
+    if(AppConfig::show_memory_stats)
+    {
+        char line[48];
+        for(int tag = 0; tag < MT_COUNT; tag++)
+        {
+            SDL_Point pos = {4, 4 + tag * 12};
+            MemoryStats::formatLine(static_cast<MemoryTag>(tag), line, sizeof(line));
+            renderer->drawText(&pos, line, {255, 255, 0, 255}, 3);
+        }
+        for(int type = 0; type < GE_COUNT; type++)
+        {
+            SDL_Point pos = {4, 4 + (MT_COUNT + 1 + type) * 12};
+            EventStats::formatLine(static_cast<GameEventType>(type), line, sizeof(line));
+            renderer->drawText(&pos, line, {0, 255, 255, 255}, 3);
+        }
+        SDL_Point pos = {4, 4 + (MT_COUNT + 1 + GE_COUNT) * 12};
+        EventStats::formatDropped(line, sizeof(line));
+        renderer->drawText(&pos, line, {255, 80, 80, 255}, 3);
+    }
 }
 
 // Atualiza o estado do jogo
@@ -153,23 +226,58 @@ void Game::update(Uint32 dt)
             m_level_start_screen = false;
 
         m_level_start_time += dt;
+
+        // Rodadas lidas por partes: os trechos perto da câmera e dos tanques chegam durante a tela STAGE
+        if(m_level_streamed)
+        {
+            m_chunk_tick++;
+            m_camera.setWorld(AppConfig::level_rect, AppConfig::map_rect.w, AppConfig::map_rect.h);
+            m_camera.follow(cameraCenter());
+            streamChunks();
+        }
     }
     else
     {
         if(m_pause) return;
+        Uint64 phase_start = m_phase_times != nullptr ? SDL_GetPerformanceCounter() : 0;
+
+        // Marca os trechos usados neste tick e pede os próximos à câmera e aos tanques
+        m_chunk_tick++;
+        streamChunks();
+
+        // Retrocesso: enquanto a tecla estiver pressionada, restaura um estado guardado por tick
+        if(m_rewinding)
+        {
+            if(m_rewind->pop(m_rewind_state))
+            {
+                StateReader in(m_rewind_state.data(), m_rewind_state.size());
+                loadState(in);
+            }
+            return;
+        }
+
+        // Amostra a entrada de todos os jogadores uma única vez por tick
+        for(auto player : m_players)
+        {
+            if(m_scripted_input != nullptr)
+                player->setInputActions(m_scripted_input[player->type - ST_PLAYER_1]);
+            else
+                player->setInputActions(InputManager::getInstance().sampleActions(player->player_keys, player->controllerIndex()));
+        }
+        endPhase(UP_INPUT, phase_start);
 
-        std::vector<Player*>::iterator pl1, pl2;
-        std::vector<Enemy*>::iterator en1, en2;
+        EntityPool<Player>::const_iterator pl1, pl2;
 
         // Verifica colisão entre tanques dos jogadores
         for(pl1 = m_players.begin(); pl1 != m_players.end(); pl1++)
             for(pl2 = pl1 + 1; pl2 != m_players.end(); pl2++)
                 checkCollisionTwoTanks(*pl1, *pl2, dt);
 
+        // Passo de cada inimigo neste tick: completo perto dos jogadores, reduzido longe deles
+        updateLod(dt);
+
         // Verifica colisão entre tanques dos inimigos
-        for(en1 = m_enemies.begin(); en1 != m_enemies.end(); en1++)
-             for(en2 = en1 + 1; en2 != m_enemies.end(); en2++)
-                checkCollisionTwoTanks(*en1, *en2, dt);
+        checkCollisionEnemies();
 
         // Verifica colisão de balas dos inimigos com o cenário
         for(auto enemy : m_enemies)
@@ -185,10 +293,11 @@ void Game::update(Uint32 dt)
 
         // Colisões entre jogadores e inimigos
         for(auto player : m_players)
-            for(auto enemy : m_enemies)
+            for(unsigned i = 0; i < m_enemies.size(); i++)
             {
-                // Colisão entre tanque do jogador e do inimigo
-                checkCollisionTwoTanks(player, enemy, dt);
+                Enemy* enemy = m_enemies.at(i);
+                // Colisão entre tanque do jogador e do inimigo (os parados neste tick estão longe dos jogadores)
+                if(m_enemy_steps[i] > 0) checkCollisionTwoTanks(player, enemy, dt);
                 // Colisão entre balas do jogador e inimigo
                 checkCollisionPlayerBulletsWithEnemy(player, enemy);
 
@@ -209,16 +318,19 @@ void Game::update(Uint32 dt)
                 checkCollisionPlayerWithBonus(player, bonus);
 
         // Colisão entre tanques e o cenário
-        for(auto enemy : m_enemies) checkCollisionTankWithLevel(enemy, dt);
+        for(unsigned i = 0; i < m_enemies.size(); i++)
+            if(m_enemy_steps[i] > 0) checkCollisionTankWithLevel(m_enemies.at(i), m_enemy_steps[i]);
         for(auto player : m_players) checkCollisionTankWithLevel(player, dt);
+        endPhase(UP_COLLISIONS, phase_start);
 
-        // Definir alvo dos inimigos (jogadores ou águia)
-        int min_metric; // 2 * 26 * 16
-        int metric;
-        SDL_Point target;
-        for(auto enemy : m_enemies)
+        // Definir alvo dos inimigos (jogadores ou águia); cada inimigo escreve apenas o próprio alvo
+        JobSystem::getInstance().parallelFor(m_enemies.size(), TARGET_GRAIN, [this](unsigned i)
         {
-            min_metric = 832;
+            if(m_enemy_steps[i] == 0) return; // parado neste tick: decide o alvo no próximo passo
+            Enemy* enemy = m_enemies.at(i);
+            SDL_Point target;
+            int metric;
+            int min_metric = AppConfig::level_rect.w + AppConfig::level_rect.h; // maior que qualquer distância na rodada
             if(enemy->type == ST_TANK_A || enemy->type == ST_TANK_D)
                 for(auto player : m_players)
                 {
@@ -237,41 +349,45 @@ void Game::update(Uint32 dt)
             }
 
             enemy->target_position = target;
-        }
+        });
+        endPhase(UP_TARGETS, phase_start);
+
+        // Dispara os temporizadores que expiram neste tick (IA dos inimigos, escudos, bônus, eventos da rodada)
+        m_timers->advance(dt);
+        endPhase(UP_TIMERS, phase_start);
 
         // Atualiza todos os objetos do jogo
-        for(auto enemy : m_enemies) enemy->update(dt);
+        // Apenas o que muda a cada tick: tanques (e seus projéteis) e a explosão da águia.
+        // Terreno, arbustos e bônus são estáticos e mudam só por eventos (tiros, temporizadores);
+        // a água é animada pelo relógio da roda de temporizadores
+        // Os inimigos andam em paralelo; os projéteis destruídos são liberados depois, em ordem, na thread do jogo
+        JobSystem::getInstance().parallelFor(m_enemies.size(), ENEMY_GRAIN, [this, dt](unsigned i)
+        {
+            Enemy* enemy = m_enemies.at(i);
+            if(m_enemy_steps[i] > 0) enemy->advance(m_enemy_steps[i], dt);
+            else if(!enemy->to_erase) enemy->moveBullets(dt); // parado neste tick: só os projéteis andam
+        });
+        for(auto enemy : m_enemies) enemy->eraseBullets();
         for(auto player : m_players) player->update(dt);
-        for(auto bonus : m_bonuses) bonus->update(dt);
-        m_eagle->update(dt);
-
-        for(auto row : m_level)
-            for(auto item : row)
-                if(item != nullptr) item->update(dt);
-
-        for(auto bush : m_bushes) bush->update(dt);
+        if(m_eagle->type == ST_DESTROY_EAGLE) m_eagle->update(dt);
+        animateWater();
 
         // Remove elementos que devem ser apagados
-        m_enemies.erase(std::remove_if(m_enemies.begin(), m_enemies.end(), [](Enemy*e){if(e->to_erase) {delete e; return true;} return false;}), m_enemies.end());
-        m_players.erase(std::remove_if(m_players.begin(), m_players.end(), [this](Player*p){if(p->to_erase) {m_killed_players.push_back(p); return true;} return false;}), m_players.end());
+        m_enemies.eraseIf([](Enemy*e){return e->to_erase;});
+        m_players.moveIf([](Player*p){return p->to_erase;}, m_killed_players);
         m_bonuses.erase(std::remove_if(m_bonuses.begin(), m_bonuses.end(), [](Bonus*b){if(b->to_erase) {delete b; return true;} return false;}), m_bonuses.end());
-        m_bushes.erase(std::remove_if(m_bushes.begin(), m_bushes.end(), [](Object*b){if(b->to_erase) {delete b; return true;} return false;}), m_bushes.end());
 
-        // Adiciona novo inimigo se necessário
-        m_enemy_redy_time += dt;
-        if(m_enemies.size() < static_cast<size_t>(AppConfig::enemy_max_count_on_map < m_enemy_to_kill ? AppConfig::enemy_max_count_on_map : m_enemy_to_kill) && m_enemy_redy_time > AppConfig::enemy_redy_time)
+        // Adiciona novo inimigo se o intervalo já passou e há vaga no mapa; sem lugar livre, tenta de novo no próximo tick
+        if(m_enemy_ready && m_enemies.size() < static_cast<size_t>(AppConfig::enemy_max_count_on_map < m_enemy_to_kill ? AppConfig::enemy_max_count_on_map : m_enemy_to_kill)
+                && generateEnemy())
         {
-            m_enemy_redy_time = 0;
-            generateEnemy();
+            m_enemy_ready = false;
+            startTimer(TI_ENEMY_SPAWN, AppConfig::enemy_redy_time);
         }
 
         // Verifica se o nível terminou (todos inimigos eliminados)
-        if(m_enemies.empty() && m_enemy_to_kill <= 0)
-        {
-            m_level_end_time += dt;
-            if(m_level_end_time > AppConfig::level_end_time)
-                m_finished = true;
-        }
+        if(m_enemies.empty() && m_enemy_to_kill <= 0 && !m_finished && !timerActive(TI_LEVEL_END))
+            startTimer(TI_LEVEL_END, AppConfig::level_end_time);
 
         // Verifica se todos os jogadores morreram
         if(m_players.empty() && !m_game_over)
@@ -288,74 +404,21 @@ void Game::update(Uint32 dt)
             else m_game_over_position -= AppConfig::game_over_entry_speed * dt;
         }
 
-        // Lógica de proteção temporária da águia
+        // Proteção temporária da águia: paredes de pedra, piscando com tijolos no último quarto do tempo
         if(m_protect_eagle)
         {
-            m_protect_eagle_time += dt;
-            if(m_protect_eagle_time > AppConfig::protect_eagle_time)
-            {
-                m_protect_eagle = false;
-                m_protect_eagle_time = 0;
-                // Restaura os tijolos ao redor da águia
-                for(int i = 0; i < 3; i++)
-                {
-                    if(m_level.at(m_level_rows_count - i - 1).at(11) != nullptr)
-                        delete m_level.at(m_level_rows_count - i - 1).at(11);
-                    m_level.at(m_level_rows_count - i - 1).at(11) = new Brick(11 * AppConfig::tile_rect.w, (m_level_rows_count - i - 1) * AppConfig::tile_rect.h);
-
-                    if(m_level.at(m_level_rows_count - i - 1).at(14) != nullptr)
-                        delete m_level.at(m_level_rows_count - i - 1).at(14);
-                    m_level.at(m_level_rows_count - i - 1).at(14) = new Brick(14 * AppConfig::tile_rect.w, (m_level_rows_count - i - 1)  * AppConfig::tile_rect.h);
-                }
-                for(int i = 12; i < 14; i++)
-                {
-                    if(m_level.at(m_level_rows_count - 3).at(i) != nullptr)
-                        delete m_level.at(m_level_rows_count - 3).at(i);
-                    m_level.at(m_level_rows_count - 3).at(i) = new Brick(i * AppConfig::tile_rect.w, (m_level_rows_count - 3) * AppConfig::tile_rect.h);
-                }
-            }
-
-            // Pisca a proteção da águia nos últimos instantes
-            if(m_protect_eagle && m_protect_eagle_time > AppConfig::protect_eagle_time / 4 * 3 && m_protect_eagle_time / AppConfig::bonus_blink_time % 2)
-            {
-                for(int i = 0; i < 3; i++)
-                {
-                    if(m_level.at(m_level_rows_count - i - 1).at(11) != nullptr)
-                        delete m_level.at(m_level_rows_count - i - 1).at(11);
-                    m_level.at(m_level_rows_count - i - 1).at(11) = new Brick(11 * AppConfig::tile_rect.w, (m_level_rows_count - i - 1) * AppConfig::tile_rect.h);
+            Uint32 protect_time = AppConfig::protect_eagle_time - timerRemaining(TI_PROTECT_EAGLE);
+            setEagleWall(!(protect_time > AppConfig::protect_eagle_time / 4 * 3 && protect_time / AppConfig::bonus_blink_time % 2));
+        }
 
-                    if(m_level.at(m_level_rows_count - i - 1).at(14) != nullptr)
-                        delete m_level.at(m_level_rows_count - i - 1).at(14);
-                    m_level.at(m_level_rows_count - i - 1).at(14) = new Brick(14 * AppConfig::tile_rect.w, (m_level_rows_count - i - 1)  * AppConfig::tile_rect.h);
-                }
-                for(int i = 12; i < 14; i++)
-                {
-                    if(m_level.at(m_level_rows_count - 3).at(i) != nullptr)
-                        delete m_level.at(m_level_rows_count - 3).at(i);
-                    m_level.at(m_level_rows_count - 3).at(i) = new Brick(i * AppConfig::tile_rect.w, (m_level_rows_count - 3) * AppConfig::tile_rect.h);
-                }
-            }
-            // Proteção ativa: coloca paredes de pedra ao redor da águia
-            else if(m_protect_eagle)
-            {
-                for(int i = 0; i < 3; i++)
-                {
-                    if(m_level.at(m_level_rows_count - i - 1).at(11) != nullptr)
-                        delete m_level.at(m_level_rows_count - i - 1).at(11);
-                    m_level.at(m_level_rows_count - i - 1).at(11) = new Object(11 * AppConfig::tile_rect.w, (m_level_rows_count - i - 1) * AppConfig::tile_rect.h, ST_STONE_WALL);
+        endPhase(UP_OBJECTS, phase_start);
 
-                    if(m_level.at(m_level_rows_count - i - 1).at(14) != nullptr)
-                        delete m_level.at(m_level_rows_count - i - 1).at(14);
-                    m_level.at(m_level_rows_count - i - 1).at(14) = new Object(14 * AppConfig::tile_rect.w, (m_level_rows_count - i - 1)  * AppConfig::tile_rect.h, ST_STONE_WALL);
-                }
-                for(int i = 12; i < 14; i++)
-                {
-                    if(m_level.at(m_level_rows_count - 3).at(i) != nullptr)
-                        delete m_level.at(m_level_rows_count - 3).at(i);
-                    m_level.at(m_level_rows_count - 3).at(i) = new Object(i * AppConfig::tile_rect.w, (m_level_rows_count - 3) * AppConfig::tile_rect.h, ST_STONE_WALL);
-                }
-            }
-        }
+        // Guarda o estado do tick para o retrocesso
+        saveModifiedChunks();
+        StateWriter out(m_rewind_state);
+        saveState(out);
+        m_rewind->push(m_rewind_state);
+        endPhase(UP_REWIND, phase_start);
     }
 }
 
@@ -378,14 +441,24 @@ void Game::eventProcess(SDL_Event *ev)
         case SDLK_t:
             AppConfig::show_enemy_target = !AppConfig::show_enemy_target;
             break;
+        case SDLK_m:
+            AppConfig::show_memory_stats = !AppConfig::show_memory_stats;
+            break;
         case SDLK_RETURN:
             m_pause = !m_pause;
             break;
         case SDLK_ESCAPE:
-            m_finished = true;
+            m_pause_menu = true;
+            break;
+        case SDLK_BACKSPACE:
+            m_rewinding = true;
             break;
         }
     }
+    else if(ev->type == SDL_KEYUP && ev->key.keysym.sym == SDLK_BACKSPACE)
+    {
+        m_rewinding = false;
+    }
 }
 
 /*
@@ -397,76 +470,423 @@ void Game::eventProcess(SDL_Event *ev)
 - = gelo
 */
 
-// Carrega o nível a partir de um arquivo
+// Carrega o nível a partir de um arquivo; o tamanho da rodada é o do arquivo (linhas mais curtas são completadas com células vazias)
 void Game::loadLevel(std::string path)
 {
-    std::fstream level(path, std::ios::in);
-    std::string line;
-    int j = -1;
-
-    if(level.is_open())
+    LevelFile::ChunkCounts chunk_counts;
+    bool prepared = m_level_loader.take(path, m_level_file, m_level_cells, m_spawn_cells, chunk_counts);
+    if(!prepared) m_level_file.open(path);
+    m_level_rows_count = m_level_file.rows();
+    m_level_columns_count = m_level_file.columns();
+    AppConfig::setLevelSize(m_level_columns_count, m_level_rows_count);
+
+    m_level.reset(m_level_columns_count, m_level_rows_count);
+    unsigned chunk_count = m_level.chunkColumns() * m_level.chunkRows();
+    // Na horda os tanques ocupam a rodada inteira: todos os trechos ficam carregados, mas o estado guarda apenas
+    // os modificados, como nas rodadas lidas por partes (tiros mudam o mapa a cada tick)
+    bool partial = chunk_count > AppConfig::level_chunk_cache && AppConfig::horde_size == 0;
+    m_level_streamed = partial || AppConfig::horde_size > 0;
+    m_chunk_capacity = partial ? AppConfig::level_chunk_cache : chunk_count;
+    m_water_frame = -1;
+    m_level_dirty = true;
+    m_spawn_cells_valid = false;
+
+    m_saved_reserve = 0;
+    if(m_level_streamed) reserveChunkMemory(partial, prepared ? chunk_counts : m_level_file.countChunks());
+
+    // Rodadas pequenas são carregadas por inteiro; nas grandes os trechos são lidos conforme a necessidade
+    if(partial)
+        m_streamer.start(&m_level_file);
+    else
     {
-        while(!level.eof())
-        {
-            std::getline(level, line);
-            std::vector<Object*> row;
-            j++;
-            for(unsigned i = 0; i < line.size(); i++)
+        // Células preparadas em segundo plano, na mesma ordem de trechos
+        const char* cells = prepared && m_level_cells.size() == chunk_count * LevelChunks::CHUNK_CELLS ? m_level_cells.data() : nullptr;
+        for(int y = 0; y < m_level.chunkRows(); y++)
+            for(int x = 0; x < m_level.chunkColumns(); x++)
             {
-                Object* obj;
-                switch(line.at(i))
-                {
-                case '#' : obj = new Brick(i * AppConfig::tile_rect.w, j * AppConfig::tile_rect.h); break;
-                case '@' : obj = new Object(i * AppConfig::tile_rect.w, j * AppConfig::tile_rect.h, ST_STONE_WALL); break;
-                case '%' : m_bushes.push_back(new Object(i * AppConfig::tile_rect.w, j * AppConfig::tile_rect.h, ST_BUSH)); obj =  nullptr; break;
-                case '~' : obj = new Object(i * AppConfig::tile_rect.w, j * AppConfig::tile_rect.h, ST_WATER); break;
-                case '-' : obj = new Object(i * AppConfig::tile_rect.w, j * AppConfig::tile_rect.h, ST_ICE); break;
-                default: obj = nullptr;
-                }
-                row.push_back(obj);
+                loadChunk(LevelChunks::key(x, y), cells);
+                if(cells != nullptr) cells += LevelChunks::CHUNK_CELLS;
             }
-            m_level.push_back(row);
+        if(!m_level_streamed) m_level_file.close();
+    }
+
+    // Cria a águia (eagle) no mapa; o espaço ao seu redor fica vazio (ver loadChunk)
+    m_eagle = new Eagle(AppConfig::eagle_point.x, AppConfig::eagle_point.y);
+
+    // Blocos livres prontos antes do primeiro frame (montados pelo LevelLoader a partir do arquivo, se a rodada foi
+    // preparada); as linhas ficam reservadas para refazê-los após loadState()
+    m_spawn_row_above.assign(m_level_columns_count, false);
+    m_spawn_row_current.assign(m_level_columns_count, false);
+    if(prepared) m_spawn_cells_valid = true;
+    else buildSpawnCells();
+}
+
+LevelChunks::Chunk* Game::chunkAt(int row, int column)
+{
+    Uint32 key = LevelChunks::keyOf(row, column);
+    LevelChunks::Chunk* chunk = m_level.find(key);
+    if(chunk == nullptr) return loadChunk(key, nullptr);
+    if(chunk->used != m_chunk_tick) m_level.touch(chunk, m_chunk_tick);
+    return chunk;
+}
+
+Object*& Game::tileAt(int row, int column)
+{
+    return chunkAt(row, column)->tiles[LevelChunks::cell(row, column)];
+}
+
+Object*& Game::bushAt(int row, int column)
+{
+    return chunkAt(row, column)->bushes[LevelChunks::cell(row, column)];
+}
+
+// Trechos usados neste tick nunca são descartados: se todos estiverem em uso, o limite é excedido temporariamente
+LevelChunks::Chunk* Game::loadChunk(Uint32 key, const char* cells)
+{
+    while(m_level.size() >= m_chunk_capacity)
+    {
+        LevelChunks::Chunk* oldest = m_level.oldest();
+        if(oldest == nullptr || oldest->used == m_chunk_tick) break;
+        dropChunk(oldest, true);
+    }
+    LevelChunks::Chunk* chunk = m_level.insert(key, m_chunk_tick);
+
+    // Trechos modificados voltam como foram descartados
+    Uint32 saved_size;
+    const Uint8* saved = savedChunk(key, saved_size);
+    if(saved != nullptr)
+    {
+        StateReader in(saved, saved_size);
+        loadChunkState(chunk, in);
+        return chunk;
+    }
+
+    char file_cells[LevelChunks::CHUNK_CELLS];
+    if(cells == nullptr)
+    {
+        m_level_file.readChunk(key, file_cells);
+        cells = file_cells;
+    }
+
+    int row_start = LevelChunks::chunkRow(key) * LevelChunks::CHUNK_SIZE;
+    int column_start = LevelChunks::chunkColumn(key) * LevelChunks::CHUNK_SIZE;
+    int eagle_column = AppConfig::eagle_point.x / AppConfig::tile_rect.w;
+    for(int cell = 0; cell < LevelChunks::CHUNK_CELLS; cell++)
+    {
+        int row = row_start + LevelChunks::cellRow(cell);
+        int column = column_start + LevelChunks::cellColumn(cell);
+        if(row >= m_level_rows_count || column >= m_level_columns_count) continue;
+        // Espaço da águia
+        if(row >= m_level_rows_count - 2 && column >= eagle_column && column < eagle_column + 2) continue;
+
+        int x = column * AppConfig::tile_rect.w;
+        int y = row * AppConfig::tile_rect.h;
+        Object* obj;
+        switch(cells[cell])
+        {
+        case '#' : obj = m_level_arena.create<Brick>(x, y); break;
+        case '@' : obj = m_level_arena.create<Object>(x, y, ST_STONE_WALL); break;
+        case '%' : chunk->bushes[cell] = m_level_arena.create<Object>(x, y, ST_BUSH); obj = nullptr; break;
+        case '~' : obj = m_level_arena.create<Object>(x, y, ST_WATER); break;
+        case '-' : obj = m_level_arena.create<Object>(x, y, ST_ICE); break;
+        default: obj = nullptr;
+        }
+        // A água de trechos carregados durante a partida entra no frame atual
+        if(obj != nullptr && obj->type == ST_WATER)
+        {
+            if(m_water_frame >= 0) obj->setFrame(m_water_frame);
+            chunk->water[chunk->water_count++] = cell;
+        }
+        chunk->tiles[cell] = obj;
+    }
+    return chunk;
+}
+
+void Game::dropChunk(LevelChunks::Chunk* chunk, bool keep)
+{
+    auto dirty = std::find(m_dirty_chunks.begin(), m_dirty_chunks.end(), chunk->key);
+    if(dirty != m_dirty_chunks.end())
+    {
+        if(keep)
+        {
+            StateWriter out(m_chunk_state);
+            saveChunkState(chunk, out);
+            storeChunk(chunk->key, m_chunk_state);
         }
+        m_dirty_chunks.erase(dirty);
+    }
+    for(int cell = 0; cell < LevelChunks::CHUNK_CELLS; cell++)
+    {
+        m_level_arena.destroy(chunk->tiles[cell]);
+        m_level_arena.destroy(chunk->bushes[cell]);
+    }
+    chunk->water_count = 0;
+    m_level.remove(chunk);
+}
+
+// Em rodadas carregadas por inteiro o estado tem o mapa completo; basta invalidar a seção guardada.
+// Chamado depois da mudança, para que os blocos livres vejam a célula nova
+void Game::markModified(int row, int column)
+{
+    m_level_dirty = true;
+    if(m_level_streamed)
+    {
+        Uint32 key = LevelChunks::keyOf(row, column);
+        auto modified = std::lower_bound(m_modified_chunks.begin(), m_modified_chunks.end(), key);
+        if(modified == m_modified_chunks.end() || *modified != key) m_modified_chunks.insert(modified, key);
+        if(std::find(m_dirty_chunks.begin(), m_dirty_chunks.end(), key) == m_dirty_chunks.end()) m_dirty_chunks.push_back(key);
+    }
+    updateSpawnCells(row, column);
+}
+
+// Poucos trechos mudam por tick: os demais mantêm a serialização anterior
+void Game::saveModifiedChunks()
+{
+    for(Uint32 key : m_dirty_chunks)
+    {
+        const LevelChunks::Chunk* chunk = m_level.find(key);
+        if(chunk == nullptr) continue;
+        StateWriter out(m_chunk_state);
+        saveChunkState(chunk, out);
+        storeChunk(key, m_chunk_state);
+    }
+    m_dirty_chunks.clear();
+}
+
+bool Game::chunkModified(Uint32 key) const
+{
+    return std::binary_search(m_modified_chunks.begin(), m_modified_chunks.end(), key);
+}
+
+void Game::storeChunk(Uint32 key, const std::vector<Uint8>& bytes)
+{
+    SavedChunk& saved = m_saved_chunks[LevelChunks::chunkRow(key) * m_level.chunkColumns() + LevelChunks::chunkColumn(key)];
+    if(bytes.size() > saved.capacity)
+    {
+        saved.offset = m_saved_bytes.size();
+        saved.capacity = bytes.size();
+        m_saved_bytes.resize(m_saved_bytes.size() + bytes.size());
     }
+    saved.size = bytes.size();
+    std::copy(bytes.begin(), bytes.end(), m_saved_bytes.begin() + saved.offset);
+}
 
-    m_level_rows_count = m_level.size();
-    if(m_level_rows_count)
-        m_level_columns_count = m_level.at(0).size();
-    else m_level_columns_count = 0;
+// Rodadas carregadas do arquivo por inteiro não guardam trechos
+const Uint8* Game::savedChunk(Uint32 key, Uint32& size) const
+{
+    size = 0;
+    if(m_saved_chunks.empty()) return nullptr;
+    const SavedChunk& saved = m_saved_chunks[LevelChunks::chunkRow(key) * m_level.chunkColumns() + LevelChunks::chunkColumn(key)];
+    size = saved.size;
+    return saved.capacity > 0 ? m_saved_bytes.data() + saved.offset : nullptr;
+}
 
-    // Cria a águia (eagle) no mapa
-    m_eagle = new Eagle(12 * AppConfig::tile_rect.w, (m_level_rows_count - 2) * AppConfig::tile_rect.h);
+// Durante a rodada os trechos só perdem objetos, exceto o da águia, cujas paredes trocam de tipo: a serialização de
+// cada trecho pelo arquivo limita as seguintes, e a do trecho mais cheio é a folga para a águia
+void Game::reserveChunkMemory(bool partial, const LevelFile::ChunkCounts& counts)
+{
+    std::vector<Uint8> probe;
+    std::size_t brick_state, object_state;
+    {
+        StateWriter out(probe);
+        Brick().saveState(out);
+        brick_state = probe.size();
+    }
+    {
+        StateWriter out(probe);
+        Object(0, 0, ST_STONE_WALL).saveState(out);
+        object_state = probe.size();
+    }
+    const std::size_t cell_state = sizeof(SpriteType) + sizeof(bool);
+    const std::size_t brick_bytes = LevelArena::footprint(sizeof(Brick));
+    const std::size_t object_bytes = LevelArena::footprint(sizeof(Object));
+
+    unsigned chunk_count = m_level.chunkColumns() * m_level.chunkRows();
+    std::size_t saved_total = chunk_count * LevelChunks::CHUNK_CELLS * cell_state
+                              + counts.bricks * brick_state + counts.objects * object_state;
+    std::size_t saved_max = LevelChunks::CHUNK_CELLS * cell_state
+                            + counts.max_bricks * brick_state + counts.max_objects * object_state;
+
+    m_level.reserve(m_chunk_capacity);
+    m_modified_chunks.reserve(chunk_count);
+    m_saved_chunks.assign(chunk_count, SavedChunk{0, 0, 0});
+    m_saved_bytes.reserve(saved_total + saved_max);
+    m_chunk_state.reserve(LevelChunks::CHUNK_CELLS * (cell_state + brick_state + object_state));
+    m_dirty_chunks.reserve(chunk_count);
+    // Na seção do mapa cada trecho guardado leva ainda sua chave e seu tamanho
+    m_saved_reserve = saved_total + saved_max + chunk_count * 2 * sizeof(Uint32);
+    // Os trechos descartados devolvem os objetos à arena; no pior caso todos os carregados são como os mais cheios
+    if(partial)
+        m_level_arena.reserve(m_chunk_capacity * (counts.max_bricks * brick_bytes + counts.max_objects * object_bytes),
+                              std::max(brick_bytes, object_bytes));
+}
 
-    // Limpa o espaço ao redor da águia
-    for(int i = 12; i < 14 && i < m_level_columns_count; i++)
+// A água é gravada apenas pelo tipo: seu frame depende só do relógio, e assim um trecho tem a mesma representação
+// estando carregado ou guardado em m_saved_bytes
+void Game::saveChunkState(const LevelChunks::Chunk* chunk, StateWriter& out) const
+{
+    for(int cell = 0; cell < LevelChunks::CHUNK_CELLS; cell++)
     {
-        for(int j = m_level_rows_count - 2; j < m_level_rows_count; j++)
+        const Object* tile = chunk->tiles[cell];
+        out.write(tile != nullptr ? tile->type : ST_NONE);
+        if(tile != nullptr && tile->type != ST_WATER) tile->saveState(out);
+        out.write(chunk->bushes[cell] != nullptr);
+        if(chunk->bushes[cell] != nullptr) chunk->bushes[cell]->saveState(out);
+    }
+}
+
+void Game::loadChunkState(LevelChunks::Chunk* chunk, StateReader& in)
+{
+    int row_start = LevelChunks::chunkRow(chunk->key) * LevelChunks::CHUNK_SIZE;
+    int column_start = LevelChunks::chunkColumn(chunk->key) * LevelChunks::CHUNK_SIZE;
+    for(int cell = 0; cell < LevelChunks::CHUNK_CELLS && in.ok(); cell++)
+    {
+        SpriteType tile_type;
+        bool has_bush;
+        in.read(tile_type);
+        if(tile_type == ST_WATER)
         {
-            if(m_level.at(j).at(i) != nullptr)
-            {
-                delete m_level.at(j).at(i);
-                m_level.at(j).at(i) = nullptr;
-            }
+            int x = (column_start + LevelChunks::cellColumn(cell)) * AppConfig::tile_rect.w;
+            int y = (row_start + LevelChunks::cellRow(cell)) * AppConfig::tile_rect.h;
+            Object* water = m_level_arena.create<Object>(x, y, ST_WATER);
+            if(m_water_frame >= 0) water->setFrame(m_water_frame);
+            chunk->tiles[cell] = water;
+            chunk->water[chunk->water_count++] = cell;
+        }
+        else if(tile_type != ST_NONE && in.ok())
+        {
+            Object* tile = tile_type == ST_BRICK_WALL ? m_level_arena.create<Brick>() : m_level_arena.create<Object>(0, 0, tile_type);
+            tile->loadState(in);
+            chunk->tiles[cell] = tile;
+        }
+        in.read(has_bush);
+        if(has_bush && in.ok())
+        {
+            chunk->bushes[cell] = m_level_arena.create<Object>(0, 0, ST_BUSH);
+            chunk->bushes[cell]->loadState(in);
         }
     }
 }
 
+// A água não é destruída durante a partida: a lista só muda quando o trecho é carregado ou o estado restaurado
+void Game::indexWater(LevelChunks::Chunk* chunk)
+{
+    chunk->water_count = 0;
+    for(int cell = 0; cell < LevelChunks::CHUNK_CELLS; cell++)
+        if(chunk->tiles[cell] != nullptr && chunk->tiles[cell]->type == ST_WATER) chunk->water[chunk->water_count++] = cell;
+}
+
+// Pede os trechos à vista (com uma margem de um trecho) e ao redor de cada tanque
+void Game::streamChunks()
+{
+    if(!m_level_streamed) return;
+
+    Uint32 key;
+    char cells[LevelChunks::CHUNK_CELLS];
+    while(m_streamer.poll(key, cells))
+        if(m_level.find(key) == nullptr) loadChunk(key, cells);
+
+    auto request = [this](const SDL_Rect& rect, int margin)
+    {
+        int chunk_w = LevelChunks::CHUNK_SIZE * AppConfig::tile_rect.w;
+        int chunk_h = LevelChunks::CHUNK_SIZE * AppConfig::tile_rect.h;
+        int x_start = std::max(0, (rect.x - margin) / chunk_w);
+        int y_start = std::max(0, (rect.y - margin) / chunk_h);
+        int x_end = std::min(m_level.chunkColumns() - 1, (rect.x + rect.w + margin) / chunk_w);
+        int y_end = std::min(m_level.chunkRows() - 1, (rect.y + rect.h + margin) / chunk_h);
+        for(int y = y_start; y <= y_end; y++)
+            for(int x = x_start; x <= x_end; x++)
+            {
+                Uint32 key = LevelChunks::key(x, y);
+                Uint32 saved_size;
+                if(m_level.find(key) == nullptr && savedChunk(key, saved_size) == nullptr) m_streamer.request(key);
+            }
+    };
+    request(m_camera.view(), LevelChunks::CHUNK_SIZE * AppConfig::tile_rect.w);
+    for(auto player : m_players) request(player->collision_rect, LevelChunks::CHUNK_SIZE / 2 * AppConfig::tile_rect.w);
+    for(auto enemy : m_enemies) request(enemy->collision_rect, LevelChunks::CHUNK_SIZE / 2 * AppConfig::tile_rect.w);
+}
+
 // Retorna se o jogo terminou
 bool Game::finished() const
 {
     return m_finished;
 }
 
+// Menu de pausa ou placar da rodada vencida, sobre a partida suspensa
+AppState* Game::pushState()
+{
+    if(m_pause_menu)
+    {
+        m_pause_menu = false;
+        return new PauseMenu;
+    }
+    if(m_finished && !m_game_over && m_enemy_to_kill <= 0)
+    {
+        EventBus::getInstance().emit(GE_LEVEL_END);
+
+        // Enquanto o placar é exibido, a próxima rodada é preparada em segundo plano
+        m_level_loader.prepare(levelPath(wrapLevel(m_current_level + 1)), AppConfig::horde_size > 0 ? UINT_MAX : AppConfig::level_chunk_cache);
+
+        // A rodada acabou: os temporizadores são descartados antes de os jogadores irem para o placar, que não agenda nada
+        m_timers->clear();
+        TimerWheel::setActive(nullptr);
+        m_players.moveIf([](Player*){return true;}, m_killed_players);
+        return new Scores(std::move(m_killed_players), m_current_level, false, this);
+    }
+    return nullptr;
+}
+
+// Sem roda ativa, nada agenda temporizadores na partida suspensa
+void Game::suspend()
+{
+    m_rewinding = false; // a tecla pode ser solta com outro estado no topo
+    TimerWheel::setActive(nullptr);
+}
+
+void Game::resume()
+{
+    TimerWheel::setActive(m_timers);
+}
+
+// Continua a partida na próxima rodada com os jogadores vindos do placar
+void Game::continueLevel(EntityPool<Player>&& players)
+{
+    // Descarta o que sobrou da rodada anterior e seus temporizadores
+    clearLevel();
+    m_timers->clear();
+    TimerWheel::setActive(m_timers); // antes do respawn, que agenda o escudo dos jogadores
+    m_level_columns_count = 0;
+    m_level_rows_count = 0;
+    m_chunk_capacity = 0;
+    m_chunk_tick = 0;
+    m_saved_reserve = 0;
+    m_pause = false;
+    m_pause_menu = false;
+    m_protect_eagle = false;
+    m_enemy_respown_position = 0;
+    m_rewinding = false;
+
+    m_players = std::move(players);
+    m_player_count = m_players.size();
+    for(auto player : m_players)
+    {
+        player->clearFlag(TSF_MENU);
+        player->lives_count++;
+        player->respawn();
+    }
+    nextLevel();
+}
+
 // Retorna o próximo estado do jogo (menu ou placar)
 AppState* Game::nextState()
 {
     if(m_game_over || m_enemy_to_kill <= 0)
     {
-        // sound
-        SoundManager::getInstance().playSound("game_over");
+        EventBus::getInstance().emit(GE_LEVEL_END);
 
-        m_players.erase(std::remove_if(m_players.begin(), m_players.end(), [this](Player*p){m_killed_players.push_back(p); return true;}), m_players.end());
-        Scores* scores = new Scores(m_killed_players, m_current_level, m_game_over);
+        m_players.moveIf([](Player*){return true;}, m_killed_players);
+        Scores* scores = new Scores(std::move(m_killed_players), m_current_level, m_game_over);
         return scores;
     }
     Menu* m = new Menu;
@@ -476,27 +896,380 @@ AppState* Game::nextState()
 // Limpa todos os elementos do nível atual
 void Game::clearLevel()
 {
-    for(auto enemy : m_enemies) delete enemy;
     m_enemies.clear();
-
-    for(auto player : m_players) delete player;
     m_players.clear();
+    m_killed_players.clear();
 
     for(auto bonus : m_bonuses) delete bonus;
     m_bonuses.clear();
 
-    for(auto row : m_level)
+    // Tijolos, pedras, água, gelo e arbustos são descartados de uma vez com a arena da rodada
+    m_streamer.stop();
+    m_level_file.close();
+    m_level.reset(0, 0);
+    m_modified_chunks.clear();
+    m_saved_chunks.clear();
+    m_saved_bytes.clear();
+    m_dirty_chunks.clear();
+    m_level_streamed = false;
+    m_level_arena.reset();
+    m_level_dirty = true;
+    m_spawn_cells_valid = false;
+
+    if(m_eagle != nullptr) delete m_eagle;
+    m_eagle = nullptr;
+}
+
+// Identificação e versão do formato do estado salvo
+static const Uint32 GAME_STATE_MAGIC = 0x53534B54; // "TKSS"
+static const Uint32 GAME_STATE_VERSION = 5;
+
+// Salva o estado completo da simulação
+void Game::saveState(StateWriter &out, std::size_t* sections) const
+{
+    out.write(GAME_STATE_MAGIC);
+    out.write(GAME_STATE_VERSION);
+    out.write(Random::getInstance().state());
+
+    out.write(m_current_level);
+    out.write(m_player_count);
+    out.write(m_enemy_to_kill);
+    out.write(m_level_start_screen);
+    out.write(m_protect_eagle);
+    out.write(m_level_start_time);
+    out.write(m_enemy_ready);
+    out.write(m_game_over);
+    out.write(m_game_over_position);
+    out.write(m_finished);
+    out.write(m_enemy_respown_position);
+    m_timers->saveClock(out);
+    saveTimers(out);
+    if(sections != nullptr) sections[SS_GLOBALS] = out.size();
+
+    // Mapa inteiro: o tipo de cada célula seguido do estado do objeto (ST_NONE para células vazias) e os arbustos;
+    // mapa lido por partes: apenas os trechos modificados, pois os demais são iguais ao arquivo da rodada
+    if(m_level_dirty)
     {
-        for(auto item : row) if(item != nullptr) delete item;
-        row.clear();
+        StateWriter level(m_level_state);
+        level.write(m_level_streamed);
+        level.write(m_level_rows_count);
+        level.write(m_level_columns_count);
+        if(m_level_streamed)
+        {
+            level.write(static_cast<Uint32>(m_modified_chunks.size()));
+            for(Uint32 key : m_modified_chunks)
+            {
+                level.write(key);
+                if(std::find(m_dirty_chunks.begin(), m_dirty_chunks.end(), key) != m_dirty_chunks.end())
+                {
+                    StateWriter chunk_out(m_chunk_state);
+                    saveChunkState(m_level.find(key), chunk_out);
+                    level.write(static_cast<Uint32>(m_chunk_state.size()));
+                    level.writeBytes(m_chunk_state.data(), m_chunk_state.size());
+                    continue;
+                }
+                Uint32 size;
+                const Uint8* bytes = savedChunk(key, size);
+                level.write(size);
+                level.writeBytes(bytes, size);
+            }
+        }
+        else
+        {
+            Uint32 bush_count = 0;
+            for(int i = 0; i < m_level_rows_count; i++)
+                for(int j = 0; j < m_level_columns_count; j++)
+                {
+                    const LevelChunks::Chunk* chunk = m_level.find(LevelChunks::keyOf(i, j));
+                    const Object* item = chunk->tiles[LevelChunks::cell(i, j)];
+                    level.write(item != nullptr ? item->type : ST_NONE);
+                    if(item != nullptr) item->saveState(level);
+                    if(chunk->bushes[LevelChunks::cell(i, j)] != nullptr) bush_count++;
+                }
+
+            level.write(bush_count);
+            for(int i = 0; i < m_level_rows_count; i++)
+                for(int j = 0; j < m_level_columns_count; j++)
+                {
+                    const Object* bush = m_level.find(LevelChunks::keyOf(i, j))->bushes[LevelChunks::cell(i, j)];
+                    if(bush != nullptr) bush->saveState(level);
+                }
+        }
+        m_level_dirty = false;
     }
-    m_level.clear();
+    out.writeBytes(m_level_state.data(), m_level_state.size());
+    if(sections != nullptr) sections[SS_LEVEL] = out.size();
 
-    for(auto bush : m_bushes)  delete bush;
-    m_bushes.clear();
+    out.write(m_eagle != nullptr);
+    if(m_eagle != nullptr) m_eagle->saveState(out);
+    if(sections != nullptr) sections[SS_EAGLE] = out.size();
 
-    if(m_eagle != nullptr) delete m_eagle;
-    m_eagle = nullptr;
+    // Jogadores são identificados pelo índice (ST_PLAYER_1 + i), vivos primeiro
+    out.write(static_cast<Uint32>(m_players.size() + m_killed_players.size()));
+    for(auto player : m_players)
+    {
+        out.write(player->type);
+        out.write(true);
+        player->saveState(out);
+    }
+    for(auto player : m_killed_players)
+    {
+        out.write(player->type);
+        out.write(false);
+        player->saveState(out);
+    }
+    if(sections != nullptr) sections[SS_PLAYERS] = out.size();
+
+    out.write(static_cast<Uint32>(m_enemies.size()));
+    for(auto enemy : m_enemies)
+    {
+        out.write(enemy->type);
+        enemy->saveState(out);
+    }
+    if(sections != nullptr) sections[SS_ENEMIES] = out.size();
+
+    out.write(static_cast<Uint32>(m_bonuses.size()));
+    for(auto bonus : m_bonuses)
+    {
+        out.write(bonus->type);
+        bonus->saveState(out);
+    }
+    if(sections != nullptr) sections[SS_BONUSES] = out.size();
+}
+
+// Restaura o estado completo da simulação
+bool Game::loadState(StateReader &in)
+{
+    Uint32 magic, version;
+    Uint64 random_state;
+    in.read(magic);
+    in.read(version);
+    if(!in.ok() || magic != GAME_STATE_MAGIC || version != GAME_STATE_VERSION) return false;
+    in.read(random_state);
+    Random::getInstance().setState(random_state);
+
+    in.read(m_current_level);
+    in.read(m_player_count);
+    in.read(m_enemy_to_kill);
+    in.read(m_level_start_screen);
+    in.read(m_protect_eagle);
+    in.read(m_level_start_time);
+    in.read(m_enemy_ready);
+    in.read(m_game_over);
+    in.read(m_game_over_position);
+    in.read(m_finished);
+    in.read(m_enemy_respown_position);
+    // Relógio primeiro: os temporizadores de cada objeto são reagendados em relação a ele
+    m_timers->loadClock(in);
+    loadTimers(in);
+
+    if(!loadLevelState(in))
+    {
+        m_timers->finishLoad();
+        return false;
+    }
+
+    bool has_eagle;
+    in.read(has_eagle);
+    if(has_eagle && m_eagle == nullptr) m_eagle = new Eagle();
+    else if(!has_eagle && m_eagle != nullptr) { delete m_eagle; m_eagle = nullptr; }
+    if(m_eagle != nullptr) m_eagle->loadState(in);
+
+    // Jogadores: reaproveita os objetos existentes (procurados pelo índice) e refaz as listas de vivos e mortos
+    Player* existing[4] = {nullptr, nullptr, nullptr, nullptr};
+    while(!m_players.empty())
+    {
+        Player* player = m_players.pop();
+        existing[player->type - ST_PLAYER_1] = player;
+    }
+    while(!m_killed_players.empty())
+    {
+        Player* player = m_killed_players.pop();
+        existing[player->type - ST_PLAYER_1] = player;
+    }
+
+    Uint32 count;
+    in.read(count);
+    for(Uint32 i = 0; i < count && in.ok(); i++)
+    {
+        SpriteType player_type;
+        bool alive;
+        in.read(player_type);
+        in.read(alive);
+        int idx = player_type - ST_PLAYER_1;
+        if(idx < 0 || idx > 3)
+        {
+            m_timers->finishLoad();
+            return false;
+        }
+
+        Player* player = existing[idx];
+        // Players 3 e 4 usam os controles físicos 1 e 2 (ver nextLevel)
+        if(player == nullptr) player = new Player(AppConfig::player_keys.at(idx), idx, idx < 2 ? idx : idx - 1);
+        existing[idx] = nullptr;
+        player->loadState(in);
+        if(alive) m_players.insert(player);
+        else m_killed_players.insert(player);
+    }
+    // Jogadores ausentes do estado salvo continuam pertencendo ao jogo
+    for(auto player : existing)
+        if(player != nullptr) m_killed_players.insert(player);
+
+    in.read(count);
+    while(m_enemies.size() > count) delete m_enemies.pop();
+    for(Uint32 i = 0; i < count && in.ok(); i++)
+    {
+        SpriteType enemy_type;
+        in.read(enemy_type);
+        if(i >= m_enemies.size()) m_enemies.insert(new Enemy(0, 0, enemy_type));
+        m_enemies.at(i)->loadState(in);
+    }
+
+    in.read(count);
+    while(m_bonuses.size() > count)
+    {
+        delete m_bonuses.back();
+        m_bonuses.pop_back();
+    }
+    for(Uint32 i = 0; i < count && in.ok(); i++)
+    {
+        SpriteType bonus_type;
+        in.read(bonus_type);
+        if(i >= m_bonuses.size()) m_bonuses.push_back(new Bonus(0, 0, bonus_type));
+        m_bonuses.at(i)->loadState(in);
+    }
+
+    m_timers->finishLoad();
+    return in.ok();
+}
+
+// Mapa inteiro: redimensiona se necessário e recria apenas as células cujo tipo mudou;
+// mapa lido por partes: os trechos modificados são guardados e recriados quando voltarem a ser usados
+bool Game::loadLevelState(StateReader &in)
+{
+    bool streamed;
+    int rows, columns;
+    in.read(streamed);
+    in.read(rows);
+    in.read(columns);
+    if(!in.ok() || rows < 0 || columns < 0) return false;
+    m_level_dirty = true;
+    m_spawn_cells_valid = false;
+    m_water_frame = -1;
+
+    if(streamed)
+    {
+        // O estado guarda apenas as diferenças em relação ao arquivo, então só vale para a mesma rodada
+        if(!m_level_streamed || rows != m_level_rows_count || columns != m_level_columns_count) return false;
+        for(Uint32 key : m_modified_chunks)
+        {
+            LevelChunks::Chunk* chunk = m_level.find(key);
+            if(chunk != nullptr) dropChunk(chunk, false);
+        }
+        m_modified_chunks.clear();
+        m_saved_chunks.assign(m_saved_chunks.size(), SavedChunk{0, 0, 0});
+        m_saved_bytes.clear();
+        m_dirty_chunks.clear();
+
+        Uint32 count;
+        in.read(count);
+        for(Uint32 i = 0; i < count && in.ok(); i++)
+        {
+            Uint32 key, size;
+            in.read(key);
+            in.read(size);
+            if(!in.ok() || LevelChunks::chunkColumn(key) >= m_level.chunkColumns() || LevelChunks::chunkRow(key) >= m_level.chunkRows())
+                return false;
+            m_chunk_state.resize(size);
+            if(!in.readBytes(m_chunk_state.data(), size)) break;
+            storeChunk(key, m_chunk_state);
+            // saveState() grava os trechos em ordem crescente
+            auto modified = std::lower_bound(m_modified_chunks.begin(), m_modified_chunks.end(), key);
+            if(modified == m_modified_chunks.end() || *modified != key) m_modified_chunks.insert(modified, key);
+        }
+        return in.ok();
+    }
+
+    if(m_level_streamed || rows != m_level_rows_count || columns != m_level_columns_count)
+    {
+        m_streamer.stop();
+        m_level_file.close();
+        m_level_arena.reset();
+        m_level.reset(columns, rows);
+        m_modified_chunks.clear();
+        m_saved_chunks.clear();
+        m_saved_bytes.clear();
+        m_dirty_chunks.clear();
+        m_level_streamed = false;
+        m_chunk_capacity = m_level.chunkColumns() * m_level.chunkRows();
+        for(int y = 0; y < m_level.chunkRows(); y++)
+            for(int x = 0; x < m_level.chunkColumns(); x++)
+                m_level.insert(LevelChunks::key(x, y), m_chunk_tick);
+        m_level_rows_count = rows;
+        m_level_columns_count = columns;
+        AppConfig::setLevelSize(columns, rows);
+    }
+    for(int i = 0; i < m_level_rows_count; i++)
+        for(int j = 0; j < m_level_columns_count; j++)
+        {
+            Object*& item = tileAt(i, j);
+            SpriteType tile_type;
+            in.read(tile_type);
+            if(item != nullptr && item->type != tile_type)
+            {
+                m_level_arena.destroy(item);
+                item = nullptr;
+            }
+            if(tile_type == ST_NONE) continue;
+            if(item == nullptr)
+                item = tile_type == ST_BRICK_WALL ? m_level_arena.create<Brick>() : m_level_arena.create<Object>(0, 0, tile_type);
+            item->loadState(in);
+        }
+    for(LevelChunks::Chunk* chunk = m_level.oldest(); chunk != nullptr; chunk = m_level.newer(chunk)) indexWater(chunk);
+
+    // Arbustos são recriados e voltam à célula da sua posição
+    for(int i = 0; i < m_level_rows_count; i++)
+        for(int j = 0; j < m_level_columns_count; j++)
+        {
+            Object*& bush = bushAt(i, j);
+            m_level_arena.destroy(bush);
+            bush = nullptr;
+        }
+    Uint32 count;
+    in.read(count);
+    for(Uint32 i = 0; i < count && in.ok(); i++)
+    {
+        Object* bush = m_level_arena.create<Object>(0, 0, ST_BUSH);
+        bush->loadState(in);
+        int row = (bush->collision_rect.y + bush->collision_rect.h / 2) / AppConfig::tile_rect.h;
+        int column = (bush->collision_rect.x + bush->collision_rect.w / 2) / AppConfig::tile_rect.w;
+        if(row < 0 || row >= m_level_rows_count || column < 0 || column >= m_level_columns_count || bushAt(row, column) != nullptr)
+        {
+            m_level_arena.destroy(bush);
+            continue;
+        }
+        bushAt(row, column) = bush;
+    }
+    return in.ok();
+}
+
+void Game::setScriptedInput(const Uint8* actions)
+{
+    m_scripted_input = actions;
+}
+
+void Game::measurePhases(Uint64* times)
+{
+    m_phase_times = times;
+}
+
+void Game::endPhase(UpdatePhase phase, Uint64& start)
+{
+    EventBus::getInstance().flush();
+    if(m_phase_times == nullptr) return;
+    Uint64 now = SDL_GetPerformanceCounter();
+    m_phase_times[phase] += now - start;
+    start = now;
 }
 
 // Verifica colisão do tanque com o cenário e limites do mapa
@@ -550,7 +1323,7 @@ void Game::checkCollisionTankWithLevel(Tank* tank, Uint32 dt)
         for(int j = column_start; j <= column_end ;j++)
         {
             if(tank->stop) break;
-            o = m_level.at(i).at(j);
+            o = tileAt(i, j);
             if(o == nullptr) continue;
             if(tank->testFlag(TSF_BOAT) && o->type == ST_WATER) continue;
 
@@ -577,16 +1350,16 @@ void Game::checkCollisionTankWithLevel(Tank* tank, Uint32 dt)
     outside_map_rect.x = -AppConfig::tile_rect.w;
     outside_map_rect.y = -AppConfig::tile_rect.h;
     outside_map_rect.w = AppConfig::tile_rect.w;
-    outside_map_rect.h = AppConfig::map_rect.h + 2 * AppConfig::tile_rect.h;
+    outside_map_rect.h = AppConfig::level_rect.h + 2 * AppConfig::tile_rect.h;
     intersect_rect = intersectRect(&outside_map_rect, &pr);
     if(intersect_rect.w > 0 && intersect_rect.h > 0)
         tank->collide(intersect_rect);
 
     // retângulo à direita do mapa
-    outside_map_rect.x = AppConfig::map_rect.w;
+    outside_map_rect.x = AppConfig::level_rect.w;
     outside_map_rect.y = -AppConfig::tile_rect.h;
     outside_map_rect.w = AppConfig::tile_rect.w;
-    outside_map_rect.h = AppConfig::map_rect.h + 2 * AppConfig::tile_rect.h;
+    outside_map_rect.h = AppConfig::level_rect.h + 2 * AppConfig::tile_rect.h;
     intersect_rect = intersectRect(&outside_map_rect, &pr);
     if(intersect_rect.w > 0 && intersect_rect.h > 0)
         tank->collide(intersect_rect);
@@ -594,7 +1367,7 @@ void Game::checkCollisionTankWithLevel(Tank* tank, Uint32 dt)
     // retângulo acima do mapa
     outside_map_rect.x = 0;
     outside_map_rect.y = -AppConfig::tile_rect.h;
-    outside_map_rect.w = AppConfig::map_rect.w;
+    outside_map_rect.w = AppConfig::level_rect.w;
     outside_map_rect.h = AppConfig::tile_rect.h;
     intersect_rect = intersectRect(&outside_map_rect, &pr);
     if(intersect_rect.w > 0 && intersect_rect.h > 0)
@@ -602,8 +1375,8 @@ void Game::checkCollisionTankWithLevel(Tank* tank, Uint32 dt)
 
     // retângulo abaixo do mapa
     outside_map_rect.x = 0;
-    outside_map_rect.y = AppConfig::map_rect.h;
-    outside_map_rect.w = AppConfig::map_rect.w;
+    outside_map_rect.y = AppConfig::level_rect.h;
+    outside_map_rect.w = AppConfig::level_rect.w;
     outside_map_rect.h = AppConfig::tile_rect.h;
     intersect_rect = intersectRect(&outside_map_rect, &pr);
     if(intersect_rect.w > 0 && intersect_rect.h > 0)
@@ -629,6 +1402,107 @@ void Game::checkCollisionTwoTanks(Tank* tank1, Tank* tank2, Uint32 dt)
     }
 }
 
+// Apenas pares de inimigos em células vizinhas da grade são comparados; cada inimigo testa os de índice maior em ordem
+// crescente, como na comparação de todos os pares, de modo que o resultado não muda
+void Game::checkCollisionEnemies()
+{
+    unsigned count = m_enemies.size();
+    m_tank_rects.clear();
+    for(unsigned i = 0; i < count; i++)
+    {
+        Enemy* enemy = m_enemies.at(i);
+        m_tank_rects.push_back(m_enemy_steps[i] > 0 ? enemy->nextCollisionRect(m_enemy_steps[i]) : enemy->collision_rect);
+    }
+    m_tank_grid.build(m_tank_rects.data(), count);
+    m_tank_marks.assign(count, count);
+
+    for(unsigned i = 0; i < count; i++)
+    {
+        m_tank_pairs.clear();
+        m_tank_grid.query(m_tank_rects[i], [this, i](unsigned j)
+        {
+            if(j <= i || m_tank_marks[j] == i) return;
+            m_tank_marks[j] = i;
+            m_tank_pairs.push_back(j);
+        });
+        std::sort(m_tank_pairs.begin(), m_tank_pairs.end());
+
+        for(unsigned j : m_tank_pairs)
+        {
+            SDL_Rect intersect_rect = intersectRect(&m_tank_rects[i], &m_tank_rects[j]);
+            if(intersect_rect.w > 0 && intersect_rect.h > 0)
+            {
+                if(m_enemy_steps[i] > 0) m_enemies.at(i)->collide(intersect_rect);
+                if(m_enemy_steps[j] > 0) m_enemies.at(j)->collide(intersect_rect);
+            }
+        }
+    }
+}
+
+// Limites de passo diferentes por inimigo espalham os passos dos distantes pelos ticks
+void Game::updateLod(Uint32 dt)
+{
+    m_enemy_steps.clear();
+    int distance = AppConfig::lod_distance * AppConfig::tile_rect.w;
+    Camera view;
+    if(AppConfig::lod_distance > 0)
+    {
+        view.setWorld(AppConfig::level_rect, AppConfig::map_rect.w + 2 * distance, AppConfig::map_rect.h + 2 * distance);
+        view.follow(cameraCenter());
+    }
+
+    // Distância de Chebyshev até o retângulo, maior que o limite
+    auto distant_from = [distance](const SDL_Rect& a, const SDL_Rect& b)
+    {
+        return a.x - (b.x + b.w) > distance || b.x - (a.x + a.w) > distance ||
+               a.y - (b.y + b.h) > distance || b.y - (a.y + a.h) > distance;
+    };
+
+    for(unsigned i = 0; i < m_enemies.size(); i++)
+    {
+        Enemy* enemy = m_enemies.at(i);
+        bool distant = AppConfig::lod_distance > 0 && !view.visible(enemy->dest_rect) && distant_from(enemy->dest_rect, m_eagle->dest_rect);
+        for(auto player = m_players.begin(); distant && player != m_players.end(); player++)
+            distant = distant_from(enemy->dest_rect, (*player)->dest_rect);
+
+        Uint32 step = dt;
+        if(distant)
+        {
+            enemy->lod_time += dt;
+            step = 0;
+            if(enemy->lod_time >= AppConfig::lod_step / 2 + (i % 8) * AppConfig::lod_step / 16)
+            {
+                step = enemy->lod_time;
+                enemy->lod_time = 0;
+            }
+        }
+        else if(enemy->lod_time > 0)
+        {
+            // De volta ao passo completo: simula o tempo acumulado junto com o tick
+            step += enemy->lod_time;
+            enemy->lod_time = 0;
+        }
+        m_enemy_steps.push_back(step);
+    }
+}
+
+SDL_Point Game::cameraCenter() const
+{
+    SDL_Point center = {m_eagle->dest_rect.x + m_eagle->dest_rect.w / 2, m_eagle->dest_rect.y + m_eagle->dest_rect.h / 2};
+    if(!m_players.empty())
+    {
+        center = {0, 0};
+        for(auto player : m_players)
+        {
+            center.x += player->dest_rect.x + player->dest_rect.w / 2;
+            center.y += player->dest_rect.y + player->dest_rect.h / 2;
+        }
+        center.x /= static_cast<int>(m_players.size());
+        center.y /= static_cast<int>(m_players.size());
+    }
+    return center;
+}
+
 // Verifica colisão da bala com o cenário e a águia
 void Game::checkCollisionBulletWithLevel(Bullet* bullet)
 {
@@ -676,7 +1550,8 @@ void Game::checkCollisionBulletWithLevel(Bullet* bullet)
     for(int i = row_start; i <= row_end; i++)
         for(int j = column_start; j <= column_end; j++)
         {
-            o = m_level.at(i).at(j);
+            Object*& tile = tileAt(i, j);
+            o = tile;
             if(o == nullptr) continue;
             if(o->type == ST_ICE || o->type == ST_WATER) continue;
 
@@ -687,8 +1562,10 @@ void Game::checkCollisionBulletWithLevel(Bullet* bullet)
             {
                 if(bullet->increased_damage)
                 {
-                    delete o;
-                    m_level.at(i).at(j) = nullptr;
+                    EventBus::getInstance().emit(GE_BRICK_DESTROYED, o->type, o->pos_x.toInt(), o->pos_y.toInt());
+                    m_level_arena.destroy(o);
+                    tile = nullptr;
+                    markModified(i, j);
                 }
                 else if(o->type == ST_BRICK_WALL)
                 {
@@ -696,16 +1573,18 @@ void Game::checkCollisionBulletWithLevel(Bullet* bullet)
                     brick->bulletHit(bullet->direction);
                     if(brick->to_erase)
                     {
-                        delete brick;
-                        m_level.at(i).at(j) = nullptr;
+                        EventBus::getInstance().emit(GE_BRICK_DESTROYED, brick->type, brick->pos_x.toInt(), brick->pos_y.toInt());
+                        m_level_arena.destroy(brick);
+                        tile = nullptr;
                     }
+                    markModified(i, j);
                 }
                 bullet->destroy();
             }
         }
 
     //========================colisão com limites do mapa========================
-    if(br->x < 0 || br->y < 0 || br->x + br->w > AppConfig::map_rect.w || br->y + br->h > AppConfig::map_rect.h)
+    if(br->x < 0 || br->y < 0 || br->x + br->w > AppConfig::level_rect.w || br->y + br->h > AppConfig::level_rect.h)
     {
         bullet->destroy();
     }
@@ -734,18 +1613,32 @@ void Game::checkCollisionBulletWithBush(Bullet *bullet)
     SDL_Rect intersect_rect;
     br = &bullet->collision_rect;
 
-    for(auto bush : m_bushes)
-    {
-        if(bush->to_erase) continue;
-        lr = &bush->collision_rect;
-        intersect_rect = intersectRect(lr, br);
+    // Apenas as células cobertas pelo projétil
+    int column_start = br->x / AppConfig::tile_rect.w;
+    int column_end = (br->x + br->w) / AppConfig::tile_rect.w;
+    int row_start = br->y / AppConfig::tile_rect.h;
+    int row_end = (br->y + br->h) / AppConfig::tile_rect.h;
+    if(column_start < 0) column_start = 0;
+    if(row_start < 0) row_start = 0;
+    if(column_end >= m_level_columns_count) column_end = m_level_columns_count - 1;
+    if(row_end >= m_level_rows_count) row_end = m_level_rows_count - 1;
 
-        if(intersect_rect.w > 0 && intersect_rect.h > 0)
+    for(int i = row_start; i <= row_end; i++)
+        for(int j = column_start; j <= column_end; j++)
         {
-            bullet->destroy();
-            bush->to_erase = true;
+            Object*& bush = bushAt(i, j);
+            if(bush == nullptr) continue;
+            lr = &bush->collision_rect;
+            intersect_rect = intersectRect(lr, br);
+
+            if(intersect_rect.w > 0 && intersect_rect.h > 0)
+            {
+                bullet->destroy();
+                m_level_arena.destroy(bush);
+                bush = nullptr;
+                markModified(i, j);
+            }
         }
-    }
 }
 
 // Verifica colisão das balas do jogador com o inimigo
@@ -817,9 +1710,7 @@ void Game::checkCollisionPlayerWithBonus(Player *player, Bonus *bonus)
     SDL_Rect intersect_rect = intersectRect(&player->collision_rect, &bonus->collision_rect);
     if(intersect_rect.w > 0 && intersect_rect.h > 0)
     {
-
-        // sound
-        SoundManager::getInstance().playSound("bonus");
+        EventBus::getInstance().emit(GE_BONUS_PICKED, bonus->type, bonus->pos_x.toInt(), bonus->pos_y.toInt());
 
         player->score += 300;
 
@@ -850,23 +1741,8 @@ void Game::checkCollisionPlayerWithBonus(Player *player, Bonus *bonus)
         {
             // Protege a águia com paredes de pedra
             m_protect_eagle = true;
-            m_protect_eagle_time = 0;
-            for(int i = 0; i < 3; i++)
-            {
-                if(m_level.at(m_level_rows_count - i - 1).at(11) != nullptr)
-                    delete m_level.at(m_level_rows_count - i - 1).at(11);
-                m_level.at(m_level_rows_count - i - 1).at(11) = new Object(11 * AppConfig::tile_rect.w, (m_level_rows_count - i - 1) * AppConfig::tile_rect.h, ST_STONE_WALL);
-
-                if(m_level.at(m_level_rows_count - i - 1).at(14) != nullptr)
-                    delete m_level.at(m_level_rows_count - i - 1).at(14);
-                m_level.at(m_level_rows_count - i - 1).at(14) = new Object(14 * AppConfig::tile_rect.w, (m_level_rows_count - i - 1)  * AppConfig::tile_rect.h, ST_STONE_WALL);
-            }
-            for(int i = 12; i < 14; i++)
-            {
-                if(m_level.at(m_level_rows_count - 3).at(i) != nullptr)
-                    delete m_level.at(m_level_rows_count - 3).at(i);
-                m_level.at(m_level_rows_count - 3).at(i) = new Object(i * AppConfig::tile_rect.w, (m_level_rows_count - 3) * AppConfig::tile_rect.h, ST_STONE_WALL);
-            }
+            startTimer(TI_PROTECT_EAGLE, AppConfig::protect_eagle_time);
+            setEagleWall(true);
         }
         else if(bonus->type == ST_BONUS_TANK)
         {
@@ -892,24 +1768,31 @@ void Game::checkCollisionPlayerWithBonus(Player *player, Bonus *bonus)
     }
 }
 
+// Arquivo de uma rodada
+std::string Game::levelPath(int level) const
+{
+    return AppConfig::level_file.empty() ? AppConfig::levels_path + Engine::intToString(level) : AppConfig::level_file;
+}
+
 // Avança para o próximo nível
 void Game::nextLevel()
 {
-    // sound
-    SoundManager::getInstance().playSound("level_starting");
+    EventBus::getInstance().emit(GE_LEVEL_START);
 
-    m_current_level++;
-    if(m_current_level > 35) m_current_level = 1;
-    if(m_current_level < 0) m_current_level = 35;
+    m_current_level = wrapLevel(m_current_level + 1);
 
     m_level_start_screen = true;
     m_level_start_time = 0;
+    m_enemy_ready = false;
+    startTimer(TI_ENEMY_SPAWN, AppConfig::enemy_redy_time);
+    stopTimer(TI_LEVEL_END);
     m_game_over = false;
+    m_game_over_position = 0;
     m_finished = false;
+    m_rewind->clear(); // não retrocede para a fase anterior
     m_enemy_to_kill = AppConfig::enemy_start_count;
 
-    std::string level_path = AppConfig::levels_path + Engine::intToString(m_current_level);
-    loadLevel(level_path);
+    loadLevel(levelPath(m_current_level));
 
     // Cria jogadores se necessário
     if(m_players.empty())
@@ -918,17 +1801,17 @@ void Game::nextLevel()
         {
             Player* p1 = new Player(AppConfig::player_keys.at(0), 0);
             Player* p2 = new Player(AppConfig::player_keys.at(1), 1);
-            m_players.push_back(p1);
-            m_players.push_back(p2);
+            m_players.insert(p1);
+            m_players.insert(p2);
         }
         else if (m_player_count == 3) 
         {
             Player* p1 = new Player(AppConfig::player_keys.at(0), 0);
             Player* p2 = new Player(AppConfig::player_keys.at(1), 1);
             Player* p3 = new Player(AppConfig::player_keys.at(2), 2, 1); // Player 3: índice jogador 2, controle físico 1
-            m_players.push_back(p1);
-            m_players.push_back(p2);
-            m_players.push_back(p3);
+            m_players.insert(p1);
+            m_players.insert(p2);
+            m_players.insert(p3);
         }
         else if (m_player_count == 4) 
         {
@@ -936,27 +1819,91 @@ void Game::nextLevel()
             Player* p2 = new Player(AppConfig::player_keys.at(1), 1);
             Player* p3 = new Player(AppConfig::player_keys.at(2), 2, 1); // Player 3: índice jogador 2, controle físico 1
             Player* p4 = new Player(AppConfig::player_keys.at(3), 3, 2); // Player 4: índice jogador 3, controle físico 2
-            m_players.push_back(p1);
-            m_players.push_back(p2);
-            m_players.push_back(p3);
-            m_players.push_back(p4);
+            m_players.insert(p1);
+            m_players.insert(p2);
+            m_players.insert(p3);
+            m_players.insert(p4);
         }
         else
         {
             Player* p1 = new Player(AppConfig::player_keys.at(0), 0);
-            m_players.push_back(p1);
+            m_players.insert(p1);
         }
     }
+
+    // Modo horda: todos os inimigos da rodada entram no mapa de uma vez
+    if(AppConfig::horde_size > 0) generateHorde(AppConfig::horde_size);
+    reserveFrameMemory();
+}
+
+// Limites de objetos simultâneos numa rodada; acima deles a partida continua, apenas voltando a alocar memória
+void Game::reserveFrameMemory()
+{
+    const unsigned max_players = 4;
+    const unsigned max_enemies = AppConfig::enemy_max_count_on_map;
+    const unsigned max_tanks = max_players + max_enemies;
+
+    m_players.reserve(max_players);
+    m_killed_players.reserve(max_players);
+    m_enemies.reserve(max_enemies);
+    // Grade com células de dois tanques de lado
+    m_tank_grid.reset(AppConfig::level_rect, 4 * AppConfig::tile_rect.w);
+    m_tank_grid.reserve(max_enemies);
+    m_tank_rects.reserve(max_enemies);
+    m_tank_marks.reserve(max_enemies);
+    m_tank_pairs.reserve(max_enemies);
+    m_enemy_steps.reserve(max_enemies);
+    // Cada tanque sobrepõe no máximo 3x3 blocos livres (ver occupySpawnCells)
+    m_spawn_taken.reserve(max_tanks * 9);
+    // No máximo um bônus por inimigo da rodada
+    m_bonuses.reserve(AppConfig::enemy_start_count);
+
+    RecyclingAllocator<Enemy>::reserve(max_enemies);
+    RecyclingAllocator<Bullet>::reserve(max_tanks * Tank::MAX_BULLETS);
+    RecyclingAllocator<Bonus>::reserve(AppConfig::enemy_start_count);
+    RecyclingAllocator<Object>::reserve(max_tanks * 2); // escudo e barco
+
+    m_timers->reserve((max_tanks + AppConfig::enemy_start_count + 1) * TimerListener::MAX_TIMERS);
+
+    // O estado cresce pouco durante a rodada (tanques, projéteis e bônus); o dobro do estado inicial é folga suficiente.
+    // Em rodadas lidas por trechos a seção do mapa cresce com os trechos guardados, até m_saved_reserve
+    {
+        StateWriter out(m_rewind_state);
+        saveState(out);
+    }
+    m_level_state.reserve(m_level_state.size() * 2 + m_saved_reserve);
+    std::size_t state_size = m_rewind_state.size() * 2 + m_saved_reserve;
+    m_rewind_state.reserve(state_size);
+    m_rewind->reserve(static_cast<unsigned>(state_size));
+}
+
+// Gera um novo inimigo no mapa; os pontos de partida ocupados são pulados no rodízio
+bool Game::generateEnemy()
+{
+    occupySpawnCells();
+    SDL_Point point;
+    bool found = false;
+    int count = AppConfig::enemy_starting_point.size();
+    for(int i = 0; i < count && !found; i++)
+    {
+        point = AppConfig::enemy_starting_point.at(m_enemy_respown_position);
+        m_enemy_respown_position++;
+        if(m_enemy_respown_position >= count) m_enemy_respown_position = 0;
+        found = spawnCellFree(point.x, point.y);
+    }
+    // Todos ocupados: qualquer bloco livre na faixa dos pontos de partida (duas fileiras de blocos)
+    if(!found) found = randomSpawnPoint(2, point);
+    releaseSpawnCells();
+
+    if(found) createEnemy(point.x, point.y);
+    return found;
 }
 
-// Gera um novo inimigo no mapa
-void Game::generateEnemy()
+void Game::createEnemy(int x, int y)
 {
-    float p = static_cast<float>(rand()) / RAND_MAX;
-    SpriteType type = static_cast<SpriteType>(p < (0.00735 * m_current_level + 0.09265) ? ST_TANK_D : rand() % (ST_TANK_C - ST_TANK_A + 1) + ST_TANK_A);
-    Enemy* e = new Enemy(AppConfig::enemy_starting_point.at(m_enemy_respown_position).x, AppConfig::enemy_starting_point.at(m_enemy_respown_position).y, type);
-    m_enemy_respown_position++;
-    if(m_enemy_respown_position >= static_cast<int>(AppConfig::enemy_starting_point.size())) m_enemy_respown_position = 0;
+    float p = Random::getInstance().nextFloat();
+    SpriteType type = static_cast<SpriteType>(p < (0.00735 * m_current_level + 0.09265) ? ST_TANK_D : Random::getInstance().nextInt(ST_TANK_C - ST_TANK_A + 1) + ST_TANK_A);
+    Enemy* e = new Enemy(x, y, type);
 
     double a, b, c;
     if(m_current_level <= 17)
@@ -972,30 +1919,204 @@ void Game::generateEnemy()
         c = -0.036111 * m_current_level + 1.363889;
     }
 
-    p = static_cast<float>(rand()) / RAND_MAX;
+    p = Random::getInstance().nextFloat();
     if(p < a) e->lives_count = 1;
     else if(p < b) e->lives_count = 2;
     else if(p < c) e->lives_count = 3;
     else e->lives_count = 4;
 
-    p = static_cast<float>(rand()) / RAND_MAX;
+    p = Random::getInstance().nextFloat();
     if(p < 0.12) e->setFlag(TSF_BONUS);
 
-    m_enemies.push_back(e);
+    m_enemies.insert(e);
 }
 
-// Gera um bônus aleatório no mapa, evitando sobreposição com a águia
-void Game::generateBonus()
+// Embaralhamento parcial (Fisher-Yates) dos blocos livres: o cenário depende só da rodada e da semente do gerador
+void Game::generateHorde(unsigned count)
 {
-    Bonus* b = new Bonus(0, 0, static_cast<SpriteType>(rand() % (ST_BONUS_BOAT - ST_BONUS_GRENADE + 1) + ST_BONUS_GRENADE));
-    SDL_Rect intersect_rect;
-    do
+    std::vector<SDL_Point> free_blocks;
+    for(int row = 0; row + 1 < m_level_rows_count - 8; row += 2)
+        for(int column = 0; column + 1 < m_level_columns_count; column += 2)
+            if(tileAt(row, column) == nullptr && tileAt(row, column + 1) == nullptr
+                    && tileAt(row + 1, column) == nullptr && tileAt(row + 1, column + 1) == nullptr)
+                free_blocks.push_back({column * AppConfig::tile_rect.w, row * AppConfig::tile_rect.h});
+
+    for(unsigned i = 0; i < count && i < free_blocks.size(); i++)
+    {
+        unsigned j = i + Random::getInstance().nextInt(static_cast<int>(free_blocks.size() - i));
+        std::swap(free_blocks[i], free_blocks[j]);
+        createEnemy(free_blocks[i].x, free_blocks[i].y);
+    }
+}
+
+// Refaz as células ao redor da águia com pedra ou tijolo; células já intactas com o material certo são mantidas
+void Game::setEagleWall(bool stone)
+{
+    auto set_tile = [this, stone](int row, int column)
     {
-        b->pos_x = rand() % (AppConfig::map_rect.x + AppConfig::map_rect.w - 1 *  AppConfig::tile_rect.w);
-        b->pos_y = rand() % (AppConfig::map_rect.y + AppConfig::map_rect.h - 1 * AppConfig::tile_rect.h);
-        b->update(0);
-        intersect_rect = intersectRect(&b->collision_rect, &m_eagle->collision_rect);
-    }while(intersect_rect.w > 0 && intersect_rect.h > 0);
+        Object*& tile = tileAt(row, column);
+        if(tile != nullptr && tile->type == (stone ? ST_STONE_WALL : ST_BRICK_WALL)
+                && tile->collision_rect.w == AppConfig::tile_rect.w && tile->collision_rect.h == AppConfig::tile_rect.h)
+            return;
+        bool water = tile != nullptr && tile->type == ST_WATER;
+        m_level_arena.destroy(tile);
+        if(stone) tile = m_level_arena.create<Object>(column * AppConfig::tile_rect.w, row * AppConfig::tile_rect.h, ST_STONE_WALL);
+        else tile = m_level_arena.create<Brick>(column * AppConfig::tile_rect.w, row * AppConfig::tile_rect.h);
+        if(water) indexWater(chunkAt(row, column));
+        markModified(row, column);
+    };
+
+    // A águia ocupa duas colunas; a parede a envolve pelos lados e por cima
+    int eagle_column = AppConfig::eagle_point.x / AppConfig::tile_rect.w;
+    for(int i = 0; i < 3; i++)
+    {
+        set_tile(m_level_rows_count - i - 1, eagle_column - 1);
+        set_tile(m_level_rows_count - i - 1, eagle_column + 2);
+    }
+    for(int i = eagle_column; i < eagle_column + 2; i++)
+        set_tile(m_level_rows_count - 3, i);
+}
 
+// Toda a água usa o mesmo frame, calculado pelo relógio da roda de temporizadores; as células só são tocadas quando o frame muda.
+// Trechos carregados depois recebem o frame atual (ver loadChunk)
+void Game::animateWater()
+{
+    const SpriteData* water = Engine::getEngine().getSpriteConfig()->getSpriteData(ST_WATER);
+    int frame = m_timers->now() / water->frame_duration % water->frames_count;
+    if(frame == m_water_frame) return;
+    m_water_frame = frame;
+
+    for(LevelChunks::Chunk* chunk = m_level.oldest(); chunk != nullptr; chunk = m_level.newer(chunk))
+    {
+        for(int i = 0; i < chunk->water_count; i++) chunk->tiles[chunk->water[i]]->setFrame(frame);
+        if(chunk->water_count > 0) m_level_dirty = true;
+    }
+}
+
+// Eventos da rodada agendados na roda de temporizadores
+void Game::onTimer(int timer_id)
+{
+    switch(timer_id)
+    {
+    case TI_ENEMY_SPAWN:
+        // O inimigo entra no próximo tick com vaga no mapa (ver update)
+        m_enemy_ready = true;
+        break;
+    case TI_LEVEL_END:
+        m_finished = true;
+        break;
+    case TI_PROTECT_EAGLE:
+        // Fim da proteção: restaura os tijolos ao redor da águia
+        m_protect_eagle = false;
+        setEagleWall(false);
+        break;
+    }
+}
+
+// Gera um bônus aleatório no mapa: um sorteio entre os blocos livres, sem repetições
+void Game::generateBonus()
+{
+    SpriteType type = static_cast<SpriteType>(Random::getInstance().nextInt(ST_BONUS_BOAT - ST_BONUS_GRENADE + 1) + ST_BONUS_GRENADE);
+    SDL_Point point;
+    occupySpawnCells();
+    bool found = randomSpawnPoint(m_level_rows_count, point);
+    releaseSpawnCells();
+    if(!found) return;
+
+    Bonus* b = new Bonus(point.x, point.y, type);
+    b->update(0);
     m_bonuses.push_back(b);
+    EventBus::getInstance().emit(GE_BONUS_SPAWNED, type, point.x, point.y);
+}
+
+// O espaço da águia fica vazio no mapa (ver loadChunk), mas nada deve surgir sobre ela
+bool Game::cellBlocked(int row, int column)
+{
+    int eagle_column = AppConfig::eagle_point.x / AppConfig::tile_rect.w;
+    if(row >= m_level_rows_count - 2 && column >= eagle_column && column < eagle_column + 2) return true;
+    if(m_level_streamed && !chunkModified(LevelChunks::keyOf(row, column)))
+        return LevelFile::solid(m_level_file.cell(row, column));
+    const Object* tile = tileAt(row, column);
+    return tile != nullptr && tile->type != ST_ICE;
+}
+
+// As linhas de trabalho só são realocadas se um estado restaurado mudou o tamanho do mapa
+void Game::buildSpawnCells()
+{
+    m_spawn_cells.buildBlocks(m_level_columns_count, m_level_rows_count, [this](int row, int column)
+    {
+        return cellBlocked(row, column);
+    }, m_spawn_row_above, m_spawn_row_current);
+    m_spawn_cells_valid = true;
+}
+
+void Game::updateSpawnCells(int row, int column)
+{
+    if(!m_spawn_cells_valid) return;
+    int columns = m_level_columns_count - 1;
+    for(int i = row - 1; i <= row; i++)
+        for(int j = column - 1; j <= column; j++)
+        {
+            if(i < 0 || j < 0 || i >= m_level_rows_count - 1 || j >= columns) continue;
+            m_spawn_cells.set(i * columns + j, !cellBlocked(i, j) && !cellBlocked(i, j + 1) && !cellBlocked(i + 1, j) && !cellBlocked(i + 1, j + 1));
+        }
+}
+
+// Cada tanque sobrepõe no máximo 3x3 blocos: o custo depende só da quantidade de tanques
+void Game::occupySpawnCells()
+{
+    if(!m_spawn_cells_valid) buildSpawnCells();
+    int columns = m_level_columns_count - 1;
+    int rows = m_level_rows_count - 1;
+    int size = 2 * AppConfig::tile_rect.w;
+    auto occupy = [this, columns, rows, size](const Tank* tank)
+    {
+        // O retângulo de colisão fica vazio enquanto o tanque surge: usa a posição e o tamanho do sprite
+        int x = tank->pos_x.toInt();
+        int y = tank->pos_y.toInt();
+        int column_start = x >= size ? (x - size) / AppConfig::tile_rect.w + 1 : 0;
+        int row_start = y >= size ? (y - size) / AppConfig::tile_rect.h + 1 : 0;
+        int column_end = (x + tank->src_rect.w - 1) / AppConfig::tile_rect.w;
+        int row_end = (y + tank->src_rect.h - 1) / AppConfig::tile_rect.h;
+        if(column_end >= columns) column_end = columns - 1;
+        if(row_end >= rows) row_end = rows - 1;
+        for(int i = row_start; i <= row_end; i++)
+            for(int j = column_start; j <= column_end; j++)
+            {
+                unsigned cell = i * columns + j;
+                if(!m_spawn_cells.test(cell)) continue;
+                m_spawn_cells.set(cell, false);
+                m_spawn_taken.push_back(cell);
+            }
+    };
+    for(auto enemy : m_enemies) occupy(enemy);
+    for(auto player : m_players) occupy(player);
+}
+
+void Game::releaseSpawnCells()
+{
+    for(unsigned cell : m_spawn_taken) m_spawn_cells.set(cell, true);
+    m_spawn_taken.clear();
+}
+
+bool Game::spawnCellFree(int x, int y) const
+{
+    int columns = m_level_columns_count - 1;
+    int row = y / AppConfig::tile_rect.h;
+    int column = x / AppConfig::tile_rect.w;
+    if(row < 0 || column < 0 || row >= m_level_rows_count - 1 || column >= columns) return false;
+    return m_spawn_cells.test(row * columns + column);
+}
+
+bool Game::randomSpawnPoint(int rows, SDL_Point& point)
+{
+    int columns = m_level_columns_count - 1;
+    if(rows > m_level_rows_count - 1) rows = m_level_rows_count - 1;
+    if(columns <= 0 || rows <= 0) return false;
+    unsigned count = m_spawn_cells.rank(rows * columns);
+    if(count == 0) return false;
+    unsigned cell = m_spawn_cells.select(Random::getInstance().nextInt(count));
+    point.x = cell % columns * AppConfig::tile_rect.w;
+    point.y = cell / columns * AppConfig::tile_rect.h;
+    return true;
 }
@@ -9,13 +9,25 @@
 #include "../objects/brick.h"
 #include "../objects/eagle.h"
 #include "../objects/bonus.h"
+#include "../engine/rewindbuffer.h"
+#include "../engine/timerwheel.h"
+#include "../engine/entitypool.h"
+#include "../engine/levelarena.h"
+#include "../engine/camera.h"
+#include "../engine/levelchunks.h"
+#include "../engine/levelfile.h"
+#include "../engine/chunkstreamer.h"
+#include "../engine/levelloader.h"
+#include "../engine/spatialgrid.h"
+#include "../engine/freecellindex.h"
 #include <vector>
 #include <string>
 
 /**
  * @brief Classe responsável pelo movimento de todos os tanques e pelas interações entre tanques e entre tanques e outros objetos no mapa.
+ * Cada partida tem sua roda de temporizadores (@a TimerWheel), onde os objetos e o próprio jogo agendam suas contagens de tempo.
  */
-class Game : public AppState
+class Game : public AppState, public TimerListener
 {
 public:
     /**
@@ -27,16 +39,17 @@ public:
      * Construtor que permite definir o número inicial de jogadores. O número de jogadores pode ser 1 ou 2; qualquer outro valor inicia o jogo para um jogador.
      * O construtor é chamado em @a Menu::nextState.
      * @param players_count - número de jogadores (1 ou 2)
+     * @param start_level - rodada inicial (usado pelos replays para começar em qualquer rodada)
      */
-    Game(int players_count);
+    Game(int players_count, int start_level = 1);
 
     /**
      * Construtor que recebe jogadores já existentes.
      * Chamado em @a Score::nextState
-     * @param players - container com os jogadores
+     * @param players - jogadores, que passam a pertencer ao jogo
      * @param previous_level - variável que armazena o número do nível anterior
      */
-    Game(std::vector<Player*> players, int previous_level);
+    Game(EntityPool<Player>&& players, int previous_level);
 
     ~Game();
 
@@ -54,7 +67,8 @@ public:
     void draw();
 
     /**
-     * Atualiza o estado de todos os objetos no tabuleiro (tanques, bônus, obstáculos). Também verifica colisões entre tanques, entre tanques e elementos do nível, e entre projéteis e tanques/elementos do mapa.
+     * Atualiza os objetos que mudam a cada tick (tanques e projéteis). Também verifica colisões entre tanques, entre tanques e elementos do nível, e entre projéteis e tanques/elementos do mapa.
+     * Terreno, arbustos e bônus não são atualizados por tick: mudam apenas por eventos (tiros e temporizadores), e a água é animada por um relógio compartilhado.
      * Remove objetos destruídos, adiciona novos tanques inimigos e verifica condições de término da rodada.
      * @param dt - tempo desde a última chamada da função em milissegundos
      */
@@ -63,27 +77,100 @@ public:
     /**
      * Processa eventos de teclado:
      * @li Enter - pausa o jogo
-     * @li Esc - retorna ao menu
+     * @li Esc - abre o menu de pausa sobre a partida
      * @li N - avança para a próxima rodada, se o jogo não estiver perdido
      * @li B - retorna para a rodada anterior, se o jogo não estiver perdido
      * @li T - mostra os caminhos dos tanques inimigos até seus objetivos
+     * @li Backspace (segurar) - retrocede a partida tick a tick
      * @param ev - ponteiro para a união SDL_Event contendo tipo e parâmetros de vários eventos, incluindo eventos de teclado
      */
     void eventProcess(SDL_Event* ev);
 
     /**
      * Transição para o próximo estado.
-     * @return ponteiro para objeto da classe @a Scores se o jogador passou a rodada ou perdeu. Se o jogador pressionar Esc, retorna ponteiro para objeto @a Menu.
+     * @return ponteiro para objeto da classe @a Scores se o jogador perdeu (a vitória é tratada em pushState); caso contrário, ponteiro para objeto @a Menu.
      */
     AppState* nextState();
 
+    /**
+     * Estados exibidos sobre a partida, que fica suspensa com a rodada carregada:
+     * o menu de pausa (Esc) e, ao vencer a rodada, o placar, que devolve os jogadores com continueLevel().
+     * @return estado a empilhar, ou nullptr
+     */
+    AppState* pushState();
+
+    /**
+     * Deixa de ser a roda de temporizadores ativa enquanto outro estado está sobre a partida.
+     */
+    void suspend();
+
+    /**
+     * Volta a ser a roda de temporizadores ativa.
+     */
+    void resume();
+
+    /**
+     * Continua a partida na próxima rodada (chamado pelo placar). A partida não é reconstruída:
+     * retrocesso, temporizadores e reservas de memória são reaproveitados.
+     * @param players - jogadores vindos do placar, que passam a pertencer ao jogo
+     */
+    void continueLevel(EntityPool<Player>&& players);
+
+    /**
+     * Salva todo o estado da simulação em um buffer plano, sem ponteiros: mapa (com o dano dos tijolos),
+     * arbustos, águia, jogadores, inimigos, projéteis, bônus, temporizadores do nível e o estado do gerador aleatório.
+     * Estado de interface (pausa) não é salvo.
+     * @param out - escritor do buffer de estado
+     * @param sections - se não for nulo, recebe (SS_COUNT posições) o fim de cada seção @a StateSection no buffer
+     */
+    void saveState(StateWriter& out, std::size_t* sections = nullptr) const;
+
+    /**
+     * Restaura um estado salvo por saveState().
+     * Objetos já existentes são reaproveitados; só há alocação quando a quantidade de objetos muda.
+     * @param in - leitor do buffer de estado
+     * @return @a false se o buffer não for um estado válido
+     */
+    bool loadState(StateReader& in);
+
+    /**
+     * Faz os jogadores usarem ações pré-definidas em vez de ler o @a InputManager (replays e execução sem janela).
+     * @param actions - máscara de @a InputAction de cada jogador para o próximo tick, na ordem de criação; nullptr volta a ler a entrada
+     */
+    void setScriptedInput(const Uint8* actions);
+
+    /**
+     * Mede o tempo de cada fase de update() (busca do pior frame, ver @a FrameSearch).
+     * @param times - UP_COUNT contadores (em unidades de SDL_GetPerformanceCounter) somados a cada update(), ou nullptr
+     *                para não medir
+     */
+    void measurePhases(Uint64* times);
+
+    /**
+     * Temporizadores do jogo: liberação do próximo inimigo (TI_ENEMY_SPAWN), fim da rodada (TI_LEVEL_END)
+     * e fim da proteção da águia (TI_PROTECT_EAGLE).
+     * @param timer_id - temporizador que expirou
+     */
+    void onTimer(int timer_id);
+
 private:
+    friend class Benchmark;
+    friend class Soak;
+
     /**
-     * Carrega o mapa do nível a partir de um arquivo.
+     * Carrega o mapa do nível a partir de um arquivo. Rodadas com até AppConfig::level_chunk_cache trechos são carregadas
+     * por inteiro; nas maiores o arquivo fica mapeado e os trechos são lidos conforme a câmera e os tanques se aproximam.
+     * Se a rodada foi preparada em segundo plano (@a m_level_loader), usa o arquivo já aberto e as células já lidas.
      * @param path - caminho para o arquivo do mapa
      */
     void loadLevel(std::string path);
 
+    /**
+     * @param level - número da rodada
+     * @return arquivo da rodada (ou o arquivo fixo de AppConfig::level_file)
+     */
+    std::string levelPath(int level) const;
+
     /**
      * Remove inimigos restantes, jogadores, objetos do mapa e bônus.
      */
@@ -100,14 +187,219 @@ private:
      * Gera diferentes níveis de armadura para os inimigos dependendo do nível; quanto maior o número da rodada, maior a chance do inimigo ter armadura nível 4.
      * O nível de armadura indica quantos tiros são necessários para destruir o inimigo (de 1 a 4, cada um com cor diferente).
      * O inimigo gerado pode, ao ser destruído, gerar um bônus no mapa.
+     * O inimigo surge no próximo ponto de partida livre (sem obstáculos nem tanques); se todos estiverem ocupados,
+     * em um bloco livre sorteado nas fileiras de cima (@a m_spawn_cells).
+     * @return @a false se não houver lugar livre (o inimigo espera o próximo tick)
+     */
+    bool generateEnemy();
+
+    /**
+     * Cria um inimigo em uma posição, com tipo, armadura e bônus sorteados como em generateEnemy().
+     * @param x - posição horizontal
+     * @param y - posição vertical
+     */
+    void createEnemy(int x, int y);
+
+    /**
+     * Cenário do modo horda (AppConfig::horde_size): distribui inimigos por blocos livres de 2x2 células da rodada,
+     * sorteados pelo gerador do jogo, longe das fileiras dos jogadores e da águia.
+     * @param count - quantidade de inimigos; limitada à quantidade de blocos livres
+     */
+    void generateHorde(unsigned count);
+
+    /**
+     * Reserva, no carregamento da rodada, a memória usada durante a partida (inimigos, projéteis, bônus, temporizadores,
+     * listas e áreas do retrocesso), de modo que os frames não alocam memória.
+     */
+    void reserveFrameMemory();
+
+    /**
+     * Refaz a parede ao redor da águia.
+     * @param stone - @a true para parede de pedra (proteção da pá), @a false para tijolos
+     */
+    void setEagleWall(bool stone);
+
+    /**
+     * Entrega ao consumidor os eventos da fase (@a EventBus::flush), para que a fila não encha na horda, e soma em
+     * @a m_phase_times o tempo desde @a start, reiniciando @a start (sem medição, apenas entrega os eventos).
+     * @param phase - fase que terminou
+     * @param start - início da fase; recebe o início da próxima
+     */
+    void endPhase(UpdatePhase phase, Uint64& start);
+
+    /**
+     * Trecho que contém a célula, carregado se necessário e marcado como usado neste tick.
+     * @param row - linha (dentro do mapa)
+     * @param column - coluna (dentro do mapa)
+     * @return trecho carregado
+     */
+    LevelChunks::Chunk* chunkAt(int row, int column);
+
+    /**
+     * @param row - linha (dentro do mapa)
+     * @param column - coluna (dentro do mapa)
+     * @return obstáculo da célula (nullptr se vazia), que pode ser substituído
+     */
+    Object*& tileAt(int row, int column);
+
+    /**
+     * @param row - linha (dentro do mapa)
+     * @param column - coluna (dentro do mapa)
+     * @return arbusto da célula (nullptr se não houver), que pode ser substituído
+     */
+    Object*& bushAt(int row, int column);
+
+    /**
+     * Carrega um trecho: do estado guardado, se ele foi modificado e descartado; senão, das células do arquivo.
+     * Antes, descarta os trechos menos usados se a quantidade carregada chegou ao limite.
+     * @param key - código do trecho (não carregado)
+     * @param cells - células lidas pelo @a ChunkStreamer, ou nullptr para ler do arquivo nesta thread
+     * @return trecho carregado
+     */
+    LevelChunks::Chunk* loadChunk(Uint32 key, const char* cells);
+
+    /**
+     * Descarta um trecho, destruindo seus objetos.
+     * @param chunk - trecho carregado
+     * @param keep - se o trecho foi modificado, guarda seu estado para recriá-lo depois
      */
-    void generateEnemy();
+    void dropChunk(LevelChunks::Chunk* chunk, bool keep);
 
     /**
-     * Gera um bônus aleatório no mapa e o posiciona em local que não colida com a águia.
+     * Registra a mudança de uma célula do mapa (tiro, arbusto destruído, parede da águia).
+     * @param row - linha
+     * @param column - coluna
+     */
+    void markModified(int row, int column);
+
+    /**
+     * Atualiza em @a m_saved_chunks a serialização dos trechos modificados desde a última chamada.
+     */
+    void saveModifiedChunks();
+
+    /**
+     * @param key - código do trecho
+     * @return @a true se o trecho foi modificado desde o carregamento da rodada (busca binária em @a m_modified_chunks)
+     */
+    bool chunkModified(Uint32 key) const;
+
+    /**
+     * Guarda a serialização de um trecho em @a m_saved_bytes, no lugar da anterior se ela couber.
+     * @param key - código do trecho
+     * @param bytes - serialização feita por saveChunkState()
+     */
+    void storeChunk(Uint32 key, const std::vector<Uint8>& bytes);
+
+    /**
+     * @param key - código do trecho
+     * @param size - recebe o tamanho da serialização
+     * @return serialização guardada do trecho, ou nullptr se ele nunca foi guardado
+     */
+    const Uint8* savedChunk(Uint32 key, Uint32& size) const;
+
+    /**
+     * Reserva, a partir dos objetos do arquivo, a memória dos trechos de uma rodada com estado parcial
+     * (@a m_level_streamed): posições dos trechos carregados, objetos do cenário na arena (se lida por partes) e as
+     * serializações dos trechos modificados, para que carregar, descartar e salvar trechos não aloque memória no frame.
+     * @param partial - @a true se a rodada é lida por partes
+     * @param counts - objetos do cenário por trecho (@a LevelFile::countChunks)
+     */
+    void reserveChunkMemory(bool partial, const LevelFile::ChunkCounts& counts);
+
+    /**
+     * Salva as células e arbustos de um trecho, em ordem de Morton.
+     * @param chunk - trecho carregado
+     * @param out - escritor do buffer de estado
+     */
+    void saveChunkState(const LevelChunks::Chunk* chunk, StateWriter& out) const;
+
+    /**
+     * Recria as células e arbustos de um trecho vazio a partir de saveChunkState().
+     * @param chunk - trecho carregado, sem objetos
+     * @param in - leitor do buffer de estado
+     */
+    void loadChunkState(LevelChunks::Chunk* chunk, StateReader& in);
+
+    /**
+     * Refaz a lista de células com água do trecho, usada por animateWater().
+     * @param chunk - trecho carregado
+     */
+    void indexWater(LevelChunks::Chunk* chunk);
+
+    /**
+     * Em rodadas lidas por partes: recolhe os trechos lidos pelo @a ChunkStreamer e pede os próximos à câmera
+     * e aos tanques, para que raramente seja preciso ler do arquivo durante o tick.
+     */
+    void streamChunks();
+
+    /**
+     * Restaura a seção do mapa gravada por saveState().
+     * @param in - leitor posicionado no início da seção
+     * @return @a false se o estado for inválido ou de um mapa lido por partes diferente do atual
+     */
+    bool loadLevelState(StateReader& in);
+
+    /**
+     * Anima a água dos trechos carregados: o frame é calculado pelo relógio da roda de temporizadores, igual para todas
+     * as células, e as células só são alteradas quando o frame muda (trechos carregados depois já recebem o frame atual).
+     * Percorre apenas as listas de água dos trechos (ver indexWater()).
+     */
+    void animateWater();
+
+    /**
+     * Gera um bônus aleatório no mapa, em um bloco livre sorteado de modo uniforme (@a m_spawn_cells);
+     * se o mapa não tiver bloco livre, nenhum bônus é criado.
      */
     void generateBonus();
 
+    /**
+     * Indica se uma célula impede que algo surja sobre ela: obstáculo que não seja gelo, ou espaço da águia.
+     * Trechos não modificados de rodadas lidas por partes são consultados no arquivo, sem carregá-los.
+     * @param row - linha (dentro do mapa)
+     * @param column - coluna (dentro do mapa)
+     * @return @a true se a célula estiver bloqueada
+     */
+    bool cellBlocked(int row, int column);
+
+    /**
+     * Refaz @a m_spawn_cells a partir do mapa inteiro. Usa apenas memória reservada em loadLevel(), então pode ser
+     * chamado durante um frame (primeiro sorteio depois de um estado restaurado).
+     */
+    void buildSpawnCells();
+
+    /**
+     * Atualiza os blocos de @a m_spawn_cells que contêm uma célula modificada.
+     * @param row - linha
+     * @param column - coluna
+     */
+    void updateSpawnCells(int row, int column);
+
+    /**
+     * Marca temporariamente como ocupados os blocos sobrepostos por tanques (refaz @a m_spawn_cells antes, se preciso);
+     * deve ser seguido de releaseSpawnCells().
+     */
+    void occupySpawnCells();
+
+    /**
+     * Desfaz occupySpawnCells().
+     */
+    void releaseSpawnCells();
+
+    /**
+     * @param x - posição horizontal
+     * @param y - posição vertical
+     * @return @a true se o bloco que começa na célula do ponto estiver livre
+     */
+    bool spawnCellFree(int x, int y) const;
+
+    /**
+     * Sorteia de modo uniforme um bloco livre nas primeiras fileiras do mapa.
+     * @param rows - quantidade de fileiras de blocos consideradas
+     * @param point - recebe a posição do bloco
+     * @return @a false se não houver bloco livre
+     */
+    bool randomSpawnPoint(int rows, SDL_Point& point);
+
     /**
      * Verifica se o tanque pode se mover livremente para frente; caso contrário, o tanque é parado. Não permite sair do tabuleiro.
      * Se o tanque entrar no gelo, escorrega. Se possuir o bônus "Barco", pode atravessar água. Tanques não podem passar pela águia.
@@ -124,6 +416,25 @@ private:
      */
     void checkCollisionTwoTanks(Tank* tank1, Tank* tank2, Uint32 dt);
 
+    /**
+     * Verifica colisões entre os tanques inimigos, usando @a m_tank_grid para comparar apenas tanques próximos.
+     * Cada inimigo usa o seu passo em @a m_enemy_steps; os parados neste tick só bloqueiam os demais.
+     */
+    void checkCollisionEnemies();
+
+    /**
+     * Nível de detalhe da simulação: inimigos fora da vista e a mais de AppConfig::lod_distance tiles de todos os jogadores
+     * e da águia acumulam o tempo em Enemy::lod_time e são simulados em passos de até AppConfig::lod_step;
+     * ao se aproximarem voltam ao passo do jogo, simulando primeiro o tempo acumulado. Preenche @a m_enemy_steps.
+     * @param dt - tempo desde a última atualização
+     */
+    void updateLod(Uint32 dt);
+
+    /**
+     * @return ponto seguido pela câmera: o centro dos jogadores, ou a águia sem jogadores vivos
+     */
+    SDL_Point cameraCenter() const;
+
     /**
      * Verifica se o projétil colide com algum elemento do mapa (água e gelo são ignorados). Se sim, projétil e objeto são destruídos.
      * Se atingir a águia, ocorre derrota.
@@ -188,29 +499,177 @@ private:
     int m_level_rows_count;
 
     /**
-     * Obstáculos no mapa (matriz de ponteiros para objetos).
+     * Obstáculos e arbustos do mapa, em trechos; apenas os trechos carregados ocupam memória.
+     */
+    LevelChunks m_level;
+
+    /**
+     * Arquivo da rodada, mantido aberto (mapeado) enquanto a rodada for lida por partes.
+     */
+    LevelFile m_level_file;
+
+    /**
+     * Lê os trechos da rodada em uma thread de trabalho (apenas em rodadas lidas por partes).
+     */
+    ChunkStreamer m_streamer;
+
+    /**
+     * Prepara a próxima rodada em segundo plano durante o placar (ver loadLevel).
+     */
+    LevelLoader m_level_loader;
+
+    /**
+     * Células da rodada recebidas do @a m_level_loader (a memória é reaproveitada entre rodadas).
+     */
+    std::vector<char> m_level_cells;
+
+    /**
+     * O estado guarda apenas os trechos modificados (o arquivo da rodada continua aberto): rodadas maiores que
+     * AppConfig::level_chunk_cache trechos, lidas por partes, e o modo horda.
+     */
+    bool m_level_streamed;
+
+    /**
+     * Limite de trechos carregados ao mesmo tempo (todos os trechos em rodadas carregadas por inteiro).
+     */
+    unsigned m_chunk_capacity;
+
+    /**
+     * Marca de uso dos trechos, incrementada a cada tick; trechos usados no tick atual não são descartados.
+     */
+    Uint32 m_chunk_tick;
+
+    /**
+     * Trechos modificados desde o carregamento (apenas com @a m_level_streamed), em ordem crescente de código; são os
+     * únicos salvos no estado. Reservado para todos os trechos da rodada.
+     */
+    std::vector<Uint32> m_modified_chunks;
+
+    /**
+     * @brief Serialização guardada de um trecho em @a m_saved_bytes.
+     */
+    struct SavedChunk
+    {
+        Uint32 offset;      ///< Início em @a m_saved_bytes.
+        Uint32 size;        ///< Tamanho da serialização.
+        Uint32 capacity;    ///< Espaço disponível no lugar (0: trecho nunca guardado).
+    };
+
+    /**
+     * Serialização guardada de cada trecho (linha de trechos * colunas de trechos + coluna), usada no estado salvo e para
+     * recriar os trechos modificados depois de descartados.
+     */
+    std::vector<SavedChunk> m_saved_chunks;
+
+    /**
+     * Serializações dos trechos guardados, em sequência. Um trecho que cresce além do seu lugar vai para o fim; os
+     * trechos só perdem objetos durante a rodada (exceto as paredes da águia), então isso é raro.
+     */
+    std::vector<Uint8> m_saved_bytes;
+
+    /**
+     * Tamanho máximo previsto da seção do mapa no estado salvo (todas as serializações guardadas), calculado por
+     * reserveChunkMemory() e usado em reserveFrameMemory().
+     */
+    std::size_t m_saved_reserve;
+
+    /**
+     * Trechos carregados modificados desde a última serialização em @a m_saved_chunks.
+     */
+    std::vector<Uint32> m_dirty_chunks;
+
+    /**
+     * Contadores de tempo das fases de update(), ou nullptr (ver measurePhases).
+     */
+    Uint64* m_phase_times;
+
+    /**
+     * Blocos de 2x2 células (o tamanho de um tanque) sem obstáculos, indexados pela célula do canto superior esquerdo
+     * (linha * (colunas - 1) + coluna). Atualizado a cada célula modificada; os tanques são descontados só no momento
+     * de sortear (ver occupySpawnCells).
+     */
+    FreeCellIndex m_spawn_cells;
+
+    /**
+     * @a false se @a m_spawn_cells precisa ser refeito (nova rodada ou estado restaurado).
      */
-    std::vector< std::vector <Object*> > m_level;
+    bool m_spawn_cells_valid;
 
     /**
-     * Arbustos no mapa.
+     * Blocos desmarcados por occupySpawnCells(); reservado em reserveFrameMemory() para 3x3 blocos por tanque.
      */
-    std::vector<Object*> m_bushes;
+    std::vector<unsigned> m_spawn_taken;
+
+    /**
+     * Células bloqueadas da linha anterior e da atual em buildSpawnCells(), com uma posição por coluna do mapa.
+     */
+    std::vector<bool> m_spawn_row_above, m_spawn_row_current;
+
+    /**
+     * Grade dos próximos retângulos de colisão dos inimigos, refeita a cada tick por checkCollisionEnemies().
+     */
+    SpatialGrid m_tank_grid;
+
+    /**
+     * Próximo retângulo de colisão de cada inimigo, na ordem de @a m_enemies.
+     */
+    std::vector<SDL_Rect> m_tank_rects;
+
+    /**
+     * Último inimigo que encontrou cada inimigo na grade (evita testar o mesmo par duas vezes).
+     */
+    std::vector<unsigned> m_tank_marks;
+
+    /**
+     * Inimigos próximos do inimigo testado.
+     */
+    std::vector<unsigned> m_tank_pairs;
+
+    /**
+     * Tempo simulado de cada inimigo neste tick, na ordem de @a m_enemies (zero: parado); preenchido por updateLod().
+     */
+    std::vector<Uint32> m_enemy_steps;
+
+    /**
+     * Parte da rodada mostrada na área do mapa; segue os jogadores em rodadas maiores que a tela.
+     */
+    Camera m_camera;
+
+    /**
+     * Seção do mapa serializada por saveState() (todas as células, ou apenas os trechos modificados em rodadas lidas por
+     * partes); refeita apenas quando o mapa muda (@a m_level_dirty), de modo que o estado de cada tick não percorre as células.
+     */
+    mutable std::vector<Uint8> m_level_state;
+
+    /**
+     * Buffer auxiliar para serializar um trecho carregado antes de gravar seu tamanho.
+     */
+    mutable std::vector<Uint8> m_chunk_state;
+
+    /**
+     * O mapa mudou desde a última serialização (tiro em obstáculo ou arbusto, parede da águia, frame da água, nova rodada).
+     */
+    mutable bool m_level_dirty;
+
+    /**
+     * Memória dos obstáculos e arbustos da rodada, descartada de uma vez em clearLevel().
+     */
+    LevelArena m_level_arena;
 
     /**
      * Vetor de inimigos ativos.
      */
-    std::vector<Enemy*> m_enemies;
+    EntityPool<Enemy> m_enemies;
 
     /**
      * Vetor de jogadores ativos.
      */
-    std::vector<Player*> m_players;
+    EntityPool<Player> m_players;
 
     /**
      * Vetor de jogadores mortos.
      */
-    std::vector<Player*> m_killed_players;
+    EntityPool<Player> m_killed_players;
 
     /**
      * Vetor de bônus presentes no mapa.
@@ -253,19 +712,9 @@ private:
     Uint32 m_level_start_time;
 
     /**
-     * Tempo desde a última criação de inimigo.
-     */
-    Uint32 m_enemy_redy_time;
-
-    /**
-     * Tempo desde que o nível foi vencido.
-     */
-    Uint32 m_level_end_time;
-
-    /**
-     * Tempo que a águia está protegida pela parede de pedra.
+     * Indica que o intervalo entre inimigos já passou e o próximo entra assim que houver vaga no mapa.
      */
-    Uint32 m_protect_eagle_time;
+    bool m_enemy_ready;
 
     /**
      * Indica se o jogo está em estado de derrota.
@@ -275,7 +724,7 @@ private:
     /**
      * Posição do texto "GAME OVER" se @a m_game_over for true.
      */
-    double m_game_over_position;
+    Fixed m_game_over_position;
 
     /**
      * Indica se o estado atual do jogo deve ser finalizado e transitar para a tela de resultados ou menu.
@@ -291,6 +740,34 @@ private:
      * Índice da posição do novo inimigo criado. Alterado a cada criação de inimigo.
      */
     int m_enemy_respown_position;
+    /**
+     * Pedido de abrir o menu de pausa (Esc), atendido por pushState().
+     */
+    bool m_pause_menu;
+    /**
+     * Roda de temporizadores da partida, avançada uma vez por tick.
+     */
+    TimerWheel* m_timers;
+    /**
+     * Frame atual da animação da água, ou -1 para reaplicar no próximo tick.
+     */
+    int m_water_frame;
+    /**
+     * Estados dos últimos ticks, usados para retroceder a partida.
+     */
+    RewindBuffer* m_rewind;
+    /**
+     * Área temporária para salvar e restaurar estados do retrocesso.
+     */
+    std::vector<Uint8> m_rewind_state;
+    /**
+     * Indica se a tecla de retrocesso está pressionada.
+     */
+    bool m_rewinding;
+    /**
+     * Ações dos jogadores definidas por setScriptedInput(), ou nullptr para ler a entrada.
+     */
+    const Uint8* m_scripted_input;
 };
 
 #endif // GAME_H
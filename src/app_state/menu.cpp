@@ -47,7 +47,6 @@ Menu::~Menu()
 void Menu::draw()
 {
     Renderer* renderer = Engine::getEngine().getRenderer();
-    renderer->clear();
 
     // Desenha as áreas do mapa e status
     renderer->drawRect(&AppConfig::map_rect, {0, 0, 0, 255}, true);
@@ -70,8 +69,6 @@ void Menu::draw()
 
     // Desenha o tanque que indica a opção selecionada
     m_tank_pointer->draw();
-
-    renderer->flush();
 }
 
 // Atualiza o estado do menu (apenas atualiza o tanque ponteiro)
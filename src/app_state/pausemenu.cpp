@@ -0,0 +1,95 @@
+#include "pausemenu.h"
+#include "confirm.h"
+#include "menu.h"
+#include "../engine/engine.h"
+#include "../appconfig.h"
+
+// Opções do menu de pausa
+static const char* const PAUSE_MENU_TEXTS[] = {"Continue", "Main Menu"};
+static const int PAUSE_MENU_COUNT = 2;
+
+PauseMenu::PauseMenu()
+{
+    m_index = 0;
+    m_confirm = false;
+    m_quit = false;
+    m_finished = false;
+}
+
+bool PauseMenu::finished() const
+{
+    return m_finished;
+}
+
+// Janela preta com borda no centro da tela; a opção selecionada fica em amarelo
+void PauseMenu::draw()
+{
+    Renderer* renderer = Engine::getEngine().getRenderer();
+
+    SDL_Rect box = {(AppConfig::map_rect.w + AppConfig::status_rect.w - 160) / 2, AppConfig::map_rect.h / 2 - 50, 160, 100};
+    renderer->drawRect(&box, {0, 0, 0, 255}, true);
+    renderer->drawRect(&box, {255, 255, 255, 255});
+
+    SDL_Point pos = {-1, box.y + 10};
+    renderer->drawText(&pos, "PAUSE", {200, 0, 0, 255}, 2);
+    for(int i = 0; i < PAUSE_MENU_COUNT; i++)
+    {
+        pos = {-1, box.y + 44 + i * 24};
+        SDL_Color color = i == m_index ? SDL_Color{255, 255, 0, 255} : SDL_Color{255, 255, 255, 255};
+        renderer->drawText(&pos, PAUSE_MENU_TEXTS[i], color, 2);
+    }
+}
+
+void PauseMenu::update(Uint32 dt)
+{
+    (void)dt;
+}
+
+// Processa teclado e botões do controle
+void PauseMenu::eventProcess(SDL_Event *ev)
+{
+    bool select = false, back = false;
+    if(ev->type == SDL_KEYDOWN)
+    {
+        SDL_Keycode key = ev->key.keysym.sym;
+        if(key == SDLK_UP) m_index = (m_index + PAUSE_MENU_COUNT - 1) % PAUSE_MENU_COUNT;
+        else if(key == SDLK_DOWN) m_index = (m_index + 1) % PAUSE_MENU_COUNT;
+        else if(key == SDLK_RETURN || key == SDLK_SPACE) select = true;
+        else if(key == SDLK_ESCAPE) back = true;
+    }
+    else if(ev->type == SDL_CONTROLLERBUTTONDOWN)
+    {
+        Uint8 button = ev->cbutton.button;
+        if(button == SDL_CONTROLLER_BUTTON_DPAD_UP) m_index = (m_index + PAUSE_MENU_COUNT - 1) % PAUSE_MENU_COUNT;
+        else if(button == SDL_CONTROLLER_BUTTON_DPAD_DOWN) m_index = (m_index + 1) % PAUSE_MENU_COUNT;
+        else if(button == SDL_CONTROLLER_BUTTON_A || button == SDL_CONTROLLER_BUTTON_START) select = true;
+        else if(button == SDL_CONTROLLER_BUTTON_B || button == SDL_CONTROLLER_BUTTON_BACK) back = true;
+    }
+
+    if(back || (select && m_index == 0)) m_finished = true;
+    else if(select) m_confirm = true;
+}
+
+// Volta à partida, ou troca a pilha inteira pelo menu principal
+AppState* PauseMenu::nextState()
+{
+    if(m_quit) return new Menu;
+    return nullptr;
+}
+
+AppState* PauseMenu::pushState()
+{
+    if(!m_confirm) return nullptr;
+    m_confirm = false;
+    return new Confirm("QUIT GAME?", &m_quit);
+}
+
+void PauseMenu::resume()
+{
+    if(m_quit) m_finished = true;
+}
+
+bool PauseMenu::overlay() const
+{
+    return true;
+}
@@ -0,0 +1,66 @@
+#ifndef PAUSEMENU_H
+#define PAUSEMENU_H
+
+#include "appstate.h"
+
+/**
+ * @brief
+ * Menu de pausa exibido sobre a partida (tecla Esc), que fica suspensa por baixo com a rodada carregada.
+ * "Continue" volta à partida sem custo; "Main Menu" pede confirmação (@a Confirm, empilhada sobre este menu)
+ * antes de descartar a partida e voltar ao menu principal.
+ */
+class PauseMenu : public AppState
+{
+public:
+    PauseMenu();
+
+    /**
+     * @return @a true após escolher uma opção (ou Esc, que equivale a "Continue")
+     */
+    bool finished() const override;
+
+    /**
+     * Desenha a janela do menu no centro da tela, sobre a partida.
+     */
+    void draw() override;
+
+    /**
+     * O menu não tem animação.
+     * @param dt - tempo desde a última chamada da função
+     */
+    void update(Uint32 dt) override;
+
+    /**
+     * Seta para cima/baixo muda a opção; Enter, Espaço, A ou Start confirmam; Esc, B ou Back voltam à partida.
+     * @param ev - ponteiro para a união SDL_Event contendo o tipo e parâmetros dos eventos
+     */
+    void eventProcess(SDL_Event* ev) override;
+
+    /**
+     * @return nullptr para voltar à partida, ou um novo @a Menu se o abandono foi confirmado
+     */
+    AppState* nextState() override;
+
+    /**
+     * @return janela de confirmação do abandono da partida, quando pedida
+     */
+    AppState* pushState() override;
+
+    /**
+     * Volta da confirmação: termina o menu se o abandono foi confirmado.
+     */
+    void resume() override;
+
+    /**
+     * @return @a true: a partida continua visível por baixo
+     */
+    bool overlay() const override;
+
+private:
+    int m_index;            ///< Opção selecionada (0: Continue, 1: Main Menu).
+    bool m_confirm;         ///< Pedido de confirmação pendente (atendido por pushState()).
+    bool m_quit;            ///< Resposta da confirmação: abandonar a partida.
+    bool m_finished;        ///< Opção escolhida.
+};
+
+#endif // PAUSEMENU_H
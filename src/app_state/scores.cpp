@@ -10,17 +10,19 @@ Scores::Scores()
     m_show_time = 0;           // Tempo de exibição da tela de pontuação
     m_level = 0;               // Nível atual
     m_game_over = true;        // Indica se o jogo terminou
+    m_game = nullptr;          // Partida sob o placar
     m_score_counter_run = true;// Controla a animação do contador de pontos
     m_score_counter = 0;       // Valor atual do contador de pontos (animação)
     m_max_score = 0;           // Maior pontuação entre os jogadores
 }
 
 // Construtor com jogadores, nível e status de game over
-Scores::Scores(std::vector<Player *> players, int level, bool game_over)
+Scores::Scores(EntityPool<Player>&& players, int level, bool game_over, Game* game)
 {
-    m_players = players;
+    m_players = std::move(players);
     m_level = level;
     m_game_over = game_over;
+    m_game = game;
     m_show_time = 0;
     m_score_counter_run = true;
     m_score_counter = 0;
@@ -44,7 +46,6 @@ Scores::Scores(std::vector<Player *> players, int level, bool game_over)
 void Scores::draw()
 {
     Renderer* renderer = Engine::getEngine().getRenderer();
-    renderer->clear();
 
     // Desenha fundo das áreas do mapa e status
     renderer->drawRect(&AppConfig::map_rect, {0, 0, 0, 255}, true);
@@ -80,8 +81,6 @@ void Scores::draw()
         renderer->drawText(&p_dst, (m_score_counter < player->score ? Engine::intToString(m_score_counter) : Engine::intToString(player->score)), {255, 255, 255, 255}, 2);
         i++;
     }
-
-    renderer->flush();
 }
 
 // Atualiza a animação do contador de pontos e o estado dos jogadores
@@ -144,7 +143,12 @@ AppState *Scores::nextState()
         Menu* m = new Menu;
         return m;
     }
-    // Caso contrário, inicia o próximo nível com os mesmos jogadores
-    Game* g = new Game(m_players, m_level);
+    // Caso contrário, a partida sob o placar continua no próximo nível com os mesmos jogadores
+    if(m_game != nullptr)
+    {
+        m_game->continueLevel(std::move(m_players));
+        return nullptr;
+    }
+    Game* g = new Game(std::move(m_players), m_level);
     return g;
 }
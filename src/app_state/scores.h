@@ -2,10 +2,13 @@
 #define SCORES_H
 #include "appstate.h"
 #include "../objects/player.h"
+#include "../engine/entitypool.h"
 
 #include <vector>
 #include <string>
 
+class Game;
+
 /**
  * @brief
  * Classe responsável por exibir os resultados (pontuações) dos jogadores da rodada anterior.
@@ -16,11 +19,12 @@ public:
     Scores();
     /**
      * Construtor chamado pelo Game ao final da partida.
-     * @param players - vetor contendo todos os jogadores que participaram da partida
+     * @param players - todos os jogadores que participaram da partida; passam a pertencer ao placar
      * @param level - número do último nível jogado
      * @param game_over - indica se o último nível foi perdido (true) ou vencido (false)
+     * @param game - partida suspensa sob o placar, que continua na próxima rodada; nullptr cria uma nova partida
      */
-    Scores(std::vector<Player*> players, int level, bool game_over);
+    Scores(EntityPool<Player>&& players, int level, bool game_over, Game* game = nullptr);
 
     /**
      * Retorna @a true após um tempo determinado de exibição da tela de pontuação.
@@ -47,16 +51,17 @@ public:
 
     /**
      * Retorna um ponteiro para o próximo estado da aplicação.
-     * Se o jogador perdeu, o próximo estado é @a Menu; se venceu, o próximo estado é @a Game.
-     * @return ponteiro para o próximo estado
+     * Se o jogador perdeu, o próximo estado é @a Menu; se venceu, os jogadores voltam para a partida sob o placar
+     * (que é desempilhado) ou, sem ela, o próximo estado é um novo @a Game.
+     * @return ponteiro para o próximo estado, ou nullptr para voltar à partida
      */
     AppState* nextState();
 
 private:
     /**
-     * Vetor com todos os jogadores (mortos e vivos) da rodada.
+     * Todos os jogadores (mortos e vivos) da rodada. São passados ao próximo @a Game ou apagados com o placar em caso de derrota.
      */
-    std::vector<Player*> m_players;
+    EntityPool<Player> m_players;
 
     /**
      * Número do último nível jogado.
@@ -68,6 +73,11 @@ private:
      */
     bool m_game_over;
 
+    /**
+     * Partida suspensa sob o placar, ou nullptr.
+     */
+    Game* m_game;
+
     /**
      * Valor atual do contador de pontos (usado para animação da contagem).
      */
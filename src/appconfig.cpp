@@ -1,5 +1,8 @@
 #include "appconfig.h"
 
+#include <algorithm>
+#include <cstdlib>
+
 // Caminho do arquivo de textura principal do jogo
 string AppConfig::texture_path = "texture.png";
 // Caminho da pasta onde estão os arquivos de fases/níveis
@@ -17,6 +20,9 @@ SDL_Rect AppConfig::status_rect = {26*16, 0, 3*16, AppConfig::map_rect.h};
 SDL_Rect AppConfig::windows_rect = {0, 0, AppConfig::map_rect.w + AppConfig::status_rect.w, AppConfig::map_rect.h};
 // Retângulo padrão de um tile (16x16 pixels)
 SDL_Rect AppConfig::tile_rect = {0, 0, 16, 16};
+// Área da rodada e posição da águia (ajustadas por setLevelSize ao carregar a rodada)
+SDL_Rect AppConfig::level_rect = AppConfig::map_rect;
+SDL_Point AppConfig::eagle_point = {12*16, 24*16};
 
 // Teclas de disparo adaptadas para Macbooks (não possuem tecla Ctrl direita)
 // Macbook: usa Alt direito/esquerdo; outros: usa Ctrl direito/esquerdo
@@ -100,11 +106,138 @@ unsigned AppConfig::bonus_blink_time = 350;
 unsigned AppConfig::player_reload_time = 120;
 // Quantidade máxima de inimigos simultâneos no mapa
 int AppConfig::enemy_max_count_on_map = 4;
-// Velocidade de entrada do texto "Game Over"
-double AppConfig::game_over_entry_speed = 0.13;
-// Velocidade padrão dos tanques
-double AppConfig::tank_default_speed = 0.08;
-// Velocidade padrão dos projéteis
-double AppConfig::bullet_default_speed = 0.23;
+// Velocidade de entrada do texto "Game Over" (0.13 pixel/ms)
+Fixed AppConfig::game_over_entry_speed = Fixed::fromRatio(13, 100);
+// Velocidade padrão dos tanques (0.08 pixel/ms)
+Fixed AppConfig::tank_default_speed = Fixed::fromRatio(8, 100);
+// Velocidade padrão dos projéteis (0.23 pixel/ms)
+Fixed AppConfig::bullet_default_speed = Fixed::fromRatio(23, 100);
 // Exibe ou não o alvo do inimigo (debug)
 bool AppConfig::show_enemy_target = false;
+// Painel e relatório de memória (--memory-report)
+bool AppConfig::show_memory_stats = false;
+string AppConfig::memory_report_path = "";
+// Buffer de retrocesso: 4 MB, até 30 s de partida, quadro-chave a cada meio segundo
+unsigned AppConfig::rewind_buffer_size = 4 * 1024 * 1024;
+unsigned AppConfig::rewind_max_frames = 1800;
+unsigned AppConfig::rewind_keyframe_interval = 30;
+// Mede a latência entrada-apresentação (--input-latency)
+bool AppConfig::measure_input_latency = false;
+// Replays de regressão: ~15 s de partida por rodada
+string AppConfig::replays_path = "replays/";
+unsigned AppConfig::replay_ticks = 900;
+bool AppConfig::replay_verify = false;
+bool AppConfig::replay_generate = false;
+// Medições de desempenho
+bool AppConfig::benchmark = false;
+unsigned AppConfig::benchmark_iterations = 20;
+// Busca do pior frame: cada avaliação joga um replay inteiro duas vezes
+bool AppConfig::worst_case = false;
+unsigned AppConfig::worst_case_rounds = 100;
+// Teste de longa duração: uma hora de menus, partidas e placares com entrada aleatória
+bool AppConfig::soak = false;
+unsigned AppConfig::soak_minutes = 60;
+Uint64 AppConfig::soak_seed = 0;
+// Rodada fixa (--level)
+string AppConfig::level_file = "";
+// Trechos carregados ao mesmo tempo: 128 trechos = 32768 tiles (mais que 180x180)
+unsigned AppConfig::level_chunk_cache = 128;
+// Modo horda (--horde)
+unsigned AppConfig::horde_size = 0;
+// Simulação reduzida dos inimigos distantes: 24 tiles (quase a largura da tela); 50 ms = 5,2 px do tanque mais rápido
+unsigned AppConfig::lod_distance = 24;
+unsigned AppConfig::lod_step = 50;
+// Modo turbo (--turbo): velocidade normal
+unsigned AppConfig::turbo = 1;
+// Fases paralelas do tick (--threads): apenas a thread do jogo
+unsigned AppConfig::threads = 1;
+
+// Os pontos seguem a águia e as bordas da rodada; em 26x26 tiles coincidem com os valores iniciais acima
+void AppConfig::setLevelSize(int columns, int rows)
+{
+    level_rect = {0, 0, columns * tile_rect.w, rows * tile_rect.h};
+    eagle_point = {eagleColumn(columns) * tile_rect.w, (rows - 2) * tile_rect.h};
+
+    int left = eagle_point.x - 4 * tile_rect.w;
+    int right = eagle_point.x + 4 * tile_rect.w;
+    player_starting_point.at(0) = {left, level_rect.h - 2 * tile_rect.h};
+    player_starting_point.at(1) = {right, level_rect.h - 2 * tile_rect.h};
+    player_starting_point.at(2) = {left, level_rect.h - 6 * tile_rect.h};
+    player_starting_point.at(3) = {right, level_rect.h - 6 * tile_rect.h};
+
+    enemy_starting_point.at(0) = {1, 1};
+    enemy_starting_point.at(1) = {eagle_point.x, 1};
+    enemy_starting_point.at(2) = {level_rect.w - 2 * tile_rect.w, 1};
+}
+
+int AppConfig::eagleColumn(int columns)
+{
+    return columns / 2 - 1;
+}
+
+// Lê as opções de linha de comando
+void AppConfig::parseArguments(int argc, char* args[])
+{
+    for(int i = 1; i < argc; i++)
+    {
+        string arg = args[i];
+        if(arg == "--input-latency")
+            measure_input_latency = true;
+        else if(arg == "--replay-verify" || arg == "--replay-generate")
+        {
+            replay_verify = arg == "--replay-verify";
+            replay_generate = !replay_verify;
+            // Pasta opcional logo após a opção
+            if(i + 1 < argc && args[i + 1][0] != '-')
+            {
+                replays_path = args[++i];
+                bool file = replays_path.size() > 4 && replays_path.compare(replays_path.size() - 4, 4, ".rpl") == 0;
+                if(!file && replays_path.back() != '/') replays_path += '/';
+            }
+        }
+        else if(arg == "--level" && i + 1 < argc)
+            level_file = args[++i];
+        else if(arg == "--chunk-cache" && i + 1 < argc)
+            level_chunk_cache = std::max(1, atoi(args[++i]));
+        else if(arg == "--horde" && i + 1 < argc)
+        {
+            horde_size = static_cast<unsigned>(std::max(0, atoi(args[++i])));
+            if(horde_size > 0)
+            {
+                enemy_start_count = horde_size;
+                enemy_max_count_on_map = horde_size;
+            }
+        }
+        else if(arg == "--lod-distance" && i + 1 < argc)
+            lod_distance = static_cast<unsigned>(std::max(0, atoi(args[++i])));
+        else if(arg == "--turbo" && i + 1 < argc)
+            turbo = static_cast<unsigned>(std::max(0, atoi(args[++i]))); // "max" vira 0: sem limite
+        else if(arg == "--threads" && i + 1 < argc)
+            threads = static_cast<unsigned>(std::max(0, atoi(args[++i]))); // 0: uma por núcleo
+        else if(arg == "--memory-report" && i + 1 < argc)
+            memory_report_path = args[++i];
+        else if(arg == "--benchmark")
+        {
+            benchmark = true;
+            // Quantidade opcional de repetições logo após a opção
+            if(i + 1 < argc && args[i + 1][0] != '-')
+                benchmark_iterations = static_cast<unsigned>(atoi(args[++i]));
+        }
+        else if(arg == "--worst-case")
+        {
+            worst_case = true;
+            // Quantidade opcional de avaliações logo após a opção
+            if(i + 1 < argc && args[i + 1][0] != '-')
+                worst_case_rounds = static_cast<unsigned>(std::max(1, atoi(args[++i])));
+        }
+        else if(arg == "--soak")
+        {
+            soak = true;
+            // Duração opcional em minutos logo após a opção, seguida da semente opcional
+            if(i + 1 < argc && args[i + 1][0] != '-')
+                soak_minutes = static_cast<unsigned>(std::max(1, atoi(args[++i])));
+            if(i + 1 < argc && args[i + 1][0] != '-')
+                soak_seed = strtoull(args[++i], nullptr, 10);
+        }
+    }
+}
@@ -2,6 +2,7 @@
 #define APPCONFIG_H
 
 #include "objects/player.h"
+#include "engine/fixed.h"
 #include <iostream>
 #include <SDL2/SDL_rect.h>
 #include <vector>
@@ -44,6 +45,17 @@ public:
      */
     static SDL_Rect map_rect;
 
+    /**
+     * Área da rodada carregada (mundo), em pixels. Igual a map_rect nas rodadas de 26x26 tiles; em rodadas maiores
+     * o mapa mostra apenas a parte vista pela câmera (@a Camera). Ajustada por setLevelSize().
+     */
+    static SDL_Rect level_rect;
+
+    /**
+     * Posição (em pixels) da águia na rodada carregada: centralizada na penúltima linha. Ajustada por setLevelSize().
+     */
+    static SDL_Point eagle_point;
+
     /**
      * Retângulo que define a área de status (HUD) ao lado do mapa.
      * Normalmente exibe informações como vidas, pontuação, etc.
@@ -63,14 +75,14 @@ public:
     static SDL_Rect tile_rect;
 
     /**
-     * Vetor com as duas posições iniciais dos jogadores (Player 1, Player 2 e Player 3).
-     * Cada posição é um SDL_Point (x, y).
+     * Vetor com as posições iniciais dos jogadores (Player 1, Player 2, Player 3 e Player 4), ao lado da águia.
+     * Cada posição é um SDL_Point (x, y). Ajustado por setLevelSize().
      */
     static vector<SDL_Point> player_starting_point;
 
     /**
-     * Vetor com as três posições iniciais dos tanques inimigos.
-     * Cada posição é um SDL_Point (x, y).
+     * Vetor com as três posições iniciais dos tanques inimigos (cantos e centro da primeira linha).
+     * Cada posição é um SDL_Point (x, y). Ajustado por setLevelSize().
      */
     static vector<SDL_Point> enemy_starting_point;
 
@@ -156,22 +168,177 @@ public:
      * Velocidade de entrada do texto "GAME OVER" na tela.
      * Usado para animar a mensagem de fim de jogo.
      */
-    static double game_over_entry_speed;
+    static Fixed game_over_entry_speed;
 
     /**
      * Velocidade padrão de movimento dos tanques.
      */
-    static double tank_default_speed;
+    static Fixed tank_default_speed;
 
     /**
      * Velocidade padrão dos projéteis disparados.
      */
-    static double bullet_default_speed;
+    static Fixed bullet_default_speed;
 
     /**
      * Indica se a visualização dos alvos dos inimigos está ativada (debug/cheat).
      */
     static bool show_enemy_target;
+
+    /**
+     * Indica se o painel de memória por categoria está visível na partida (depuração, tecla M).
+     */
+    static bool show_memory_stats;
+
+    /**
+     * Arquivo JSON do relatório de memória, gravado ao sair e ao receber SIGUSR1 (--memory-report arquivo).
+     * Vazio: sem relatório.
+     */
+    static string memory_report_path;
+
+    /**
+     * Tamanho (em bytes) do buffer de retrocesso da partida.
+     */
+    static unsigned rewind_buffer_size;
+
+    /**
+     * Quantidade máxima de ticks guardados para retrocesso (~30 s a 60 ticks por segundo).
+     */
+    static unsigned rewind_max_frames;
+
+    /**
+     * Quantidade de ticks entre dois quadros-chave do buffer de retrocesso.
+     */
+    static unsigned rewind_keyframe_interval;
+
+    /**
+     * Indica se a latência entre a entrada e a apresentação do frame deve ser medida
+     * (opção de linha de comando --input-latency). O relatório é exibido ao sair.
+     */
+    static bool measure_input_latency;
+
+    /**
+     * Caminho da pasta com os replays de regressão (um arquivo por rodada), ou de um único arquivo .rpl a verificar.
+     */
+    static string replays_path;
+
+    /**
+     * Quantidade de ticks gravados em cada replay de regressão.
+     */
+    static unsigned replay_ticks;
+
+    /**
+     * Executa os replays de regressão sem janela e compara com os hashes de referência (--replay-verify [pasta|arquivo.rpl]).
+     */
+    static bool replay_verify;
+
+    /**
+     * Grava novamente os replays de regressão e seus hashes de referência (--replay-generate [pasta]).
+     */
+    static bool replay_generate;
+
+    /**
+     * Executa as medições de desempenho sem janela (--benchmark [repeticoes]).
+     */
+    static bool benchmark;
+
+    /**
+     * Quantidade de repetições de cada medição de desempenho.
+     */
+    static unsigned benchmark_iterations;
+
+    /**
+     * Procura sem janela as entradas e sementes com o frame mais lento e grava os piores casos como replays
+     * (--worst-case [avaliacoes]).
+     */
+    static bool worst_case;
+
+    /**
+     * Quantidade de candidatos avaliados pela busca do pior frame.
+     */
+    static unsigned worst_case_rounds;
+
+    /**
+     * Executa sem janela o teste de longa duração: menus, partidas e placares com entrada aleatória, acompanhando
+     * memória e tempos (--soak [minutos [semente]]).
+     */
+    static bool soak;
+
+    /**
+     * Duração do teste de longa duração em minutos (tempo real).
+     */
+    static unsigned soak_minutes;
+
+    /**
+     * Semente da entrada e da simulação do teste de longa duração (0: sorteada pelo relógio). É impressa no início
+     * do teste, para repetir uma falha.
+     */
+    static Uint64 soak_seed;
+
+    /**
+     * Arquivo de rodada usado em todas as rodadas da partida, no lugar das rodadas numeradas (--level arquivo).
+     * Vazio: rodadas numeradas de levels_path.
+     */
+    static string level_file;
+
+    /**
+     * Quantidade máxima de trechos de 16x16 tiles carregados ao mesmo tempo (--chunk-cache quantidade).
+     * Rodadas com mais trechos que isso são lidas por partes do arquivo, perto da câmera e dos tanques.
+     */
+    static unsigned level_chunk_cache;
+
+    /**
+     * Modo horda (--horde quantidade): quantidade de inimigos colocados no mapa de uma vez no início de cada rodada
+     * (também usada como enemy_start_count e enemy_max_count_on_map). Zero: partida normal.
+     */
+    static unsigned horde_size;
+
+    /**
+     * Distância (em tiles) a partir da qual um inimigo fora da vista, longe de todos os jogadores e da águia,
+     * passa a ser simulado em passos de lod_step (--lod-distance tiles). Zero: todos os inimigos a cada tick.
+     */
+    static unsigned lod_distance;
+
+    /**
+     * Passo (em ms) da simulação reduzida dos inimigos distantes. Menor que o tempo em que o tanque mais rápido
+     * anda meio tile, para que a colisão com o cenário continue valendo.
+     */
+    static unsigned lod_step;
+
+    /**
+     * Modo turbo (--turbo N, tecla Tab): atualizações da simulação por frame apresentado (2, 4, 16...).
+     * 1: velocidade normal; 0 (--turbo max): quantas atualizações couberem em um frame.
+     */
+    static unsigned turbo;
+
+    /**
+     * Threads das fases paralelas de Game::update (--threads N), contando a thread do jogo (@a JobSystem).
+     * 1: tudo na thread do jogo; 0: uma por núcleo. O resultado da simulação não depende deste valor.
+     */
+    static unsigned threads;
+
+    /**
+     * Ajusta level_rect, eagle_point e os pontos iniciais dos tanques ao tamanho da rodada carregada.
+     * Em 26x26 tiles os valores são os originais do jogo.
+     * @param columns - quantidade de colunas de tiles
+     * @param rows - quantidade de linhas de tiles
+     */
+    static void setLevelSize(int columns, int rows);
+
+    /**
+     * Coluna de tiles onde começa a águia (ela ocupa duas colunas), como em setLevelSize(); não muda a configuração,
+     * então pode ser usada por outra thread para uma rodada ainda não carregada.
+     * @param columns - quantidade de colunas de tiles da rodada
+     * @return coluna da águia
+     */
+    static int eagleColumn(int columns);
+
+    /**
+     * Lê as opções de linha de comando e ajusta a configuração.
+     * @param argc - quantidade de argumentos
+     * @param args - argumentos recebidos por main()
+     */
+    static void parseArguments(int argc, char* args[]);
 };
 
 #endif // APPCONFIG_H
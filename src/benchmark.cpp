@@ -0,0 +1,355 @@
+#include "benchmark.h"
+#include "appconfig.h"
+#include "app_state/game.h"
+#include "eventbus.h"
+#include "replay.h"
+#include "engine/engine.h"
+#include "engine/random.h"
+#include "engine/alloccounter.h"
+#include "engine/jobsystem.h"
+#include "engine/statebuffer.h"
+
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+bool Benchmark::run(unsigned iterations)
+{
+    Engine::getEngine().initModules();
+    if(iterations < 1) iterations = 1;
+
+    bool ok = levelLoad(iterations);
+    ok = frames(AppConfig::replay_ticks) && ok;
+    ok = largeMap(AppConfig::replay_ticks) && ok;
+    ok = horde(AppConfig::replay_ticks / 3) && ok;
+    ok = threads(AppConfig::replay_ticks / 3) && ok;
+
+    Engine::getEngine().destroyModules();
+    return ok;
+}
+
+// Cada rodada é carregada e descartada várias vezes no mesmo Game, como ao pular rodadas com N/B.
+// A carga preparada é a troca de rodada depois do placar: o LevelLoader já terminou, e o que sobra na thread do jogo
+// é criar os objetos do terreno
+bool Benchmark::levelLoad(unsigned iterations)
+{
+    Game* game = new Game(1);
+    double load_total = 0, clear_total = 0, prepared_total = 0;
+    double load_max = 0, clear_max = 0, prepared_max = 0;
+    double large_total = 0, large_max = 0;
+    bool ok = true;
+
+    for(unsigned it = 0; it < iterations; it++)
+    {
+        for(int level = 1; level <= 35; level++)
+        {
+            std::string path = AppConfig::levels_path + Engine::intToString(level);
+            Uint64 start = SDL_GetPerformanceCounter();
+            game->clearLevel();
+            double clear_time = elapsedUs(start);
+
+            start = SDL_GetPerformanceCounter();
+            game->loadLevel(path);
+            double load_time = elapsedUs(start);
+            if(game->m_level_rows_count == 0) ok = false;
+
+            game->clearLevel();
+            game->m_level_loader.prepare(path, AppConfig::level_chunk_cache);
+            game->m_level_loader.wait();
+            start = SDL_GetPerformanceCounter();
+            game->loadLevel(path);
+            double prepared_time = elapsedUs(start);
+
+            load_total += load_time;
+            clear_total += clear_time;
+            prepared_total += prepared_time;
+            if(load_time > load_max) load_max = load_time;
+            if(clear_time > clear_max) clear_max = clear_time;
+            if(prepared_time > prepared_max) prepared_max = prepared_time;
+        }
+
+        // Rodada grande, lida por partes: sem trechos a criar, o que sobra é o índice de blocos livres
+        std::string path = AppConfig::levels_path + "large";
+        game->clearLevel();
+        game->m_level_loader.prepare(path, AppConfig::level_chunk_cache);
+        game->m_level_loader.wait();
+        Uint64 start = SDL_GetPerformanceCounter();
+        game->loadLevel(path);
+        double large_time = elapsedUs(start);
+        if(game->m_level_rows_count == 0) ok = false;
+        large_total += large_time;
+        if(large_time > large_max) large_max = large_time;
+    }
+    game->clearLevel();
+    delete game;
+
+    unsigned count = iterations * 35;
+    std::cout << std::fixed << std::setprecision(1)
+              << "Carregar rodada: media " << load_total / count << " us, max " << load_max << " us\n"
+              << "Carregar rodada preparada: media " << prepared_total / count << " us, max " << prepared_max << " us\n"
+              << "Carregar rodada grande preparada: media " << large_total / iterations << " us, max " << large_max << " us\n"
+              << "Descartar rodada: media " << clear_total / count << " us, max " << clear_max << " us\n";
+    if(!ok) std::cout << "Falha ao carregar rodadas de " << AppConfig::levels_path << "\n";
+    return ok;
+}
+
+// O Game (e a carga da rodada) é criado fora da contagem; só update() e draw() são contados
+bool Benchmark::frames(Uint32 ticks)
+{
+    double total = 0, max = 0;
+    Uint64 allocations = 0, bytes = 0;
+    int first_level = 0;
+    std::size_t first_size = 0;
+
+    for(int level = 1; level <= 35; level++)
+    {
+        Replay replay;
+        replay.generate(level, 2, ticks, level);
+        Random::getInstance().seed(level);
+        Game* game = new Game(2, level);
+
+        AllocCounter::start();
+        for(Uint32 t = 0; t < replay.ticks(); t++)
+        {
+            Uint64 start = SDL_GetPerformanceCounter();
+            game->setScriptedInput(replay.actions(t));
+            game->update(replay.dt());
+            EventBus::getInstance().clear();
+            game->draw();
+            double frame_time = elapsedUs(start);
+            total += frame_time;
+            if(frame_time > max) max = frame_time;
+        }
+        AllocCounter::stop();
+
+        if(AllocCounter::count() > 0 && first_level == 0)
+        {
+            first_level = level;
+            first_size = AllocCounter::firstSize();
+        }
+        allocations += AllocCounter::count();
+        bytes += AllocCounter::bytes();
+        delete game;
+    }
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "Frame: media " << total / (ticks * 35) << " us, max " << max << " us\n";
+    if(!AllocCounter::enabled())
+    {
+        std::cout << "Alocacoes por frame: nao medidas (use make alloc-test)\n";
+        return true;
+    }
+    std::cout << "Alocacoes nos frames: " << allocations << " (" << bytes << " bytes)\n";
+    if(allocations > 0)
+        std::cout << "Primeira alocacao: rodada " << first_level << ", " << first_size << " bytes\n";
+    return allocations == 0;
+}
+
+// Mesma entrada dos replays, numa rodada de 208x208 tiles: o custo do frame deve ficar perto do das rodadas normais.
+// Os trechos carregados durante a partida também não podem alocar memória
+bool Benchmark::largeMap(Uint32 ticks)
+{
+    std::string level_file = AppConfig::level_file;
+    AppConfig::level_file = AppConfig::levels_path + "large";
+
+    Replay replay;
+    replay.generate(1, 2, ticks, 1);
+    Random::getInstance().seed(1);
+    Game* game = new Game(2, 1);
+    bool ok = game->m_level_rows_count > 0;
+
+    double update_total = 0, draw_total = 0, max = 0;
+    AllocCounter::start();
+    for(Uint32 t = 0; t < replay.ticks() && ok; t++)
+    {
+        Uint64 start = SDL_GetPerformanceCounter();
+        game->setScriptedInput(replay.actions(t));
+        game->update(replay.dt());
+        EventBus::getInstance().clear();
+        double update_time = elapsedUs(start);
+        start = SDL_GetPerformanceCounter();
+        game->draw();
+        double draw_time = elapsedUs(start);
+        update_total += update_time;
+        draw_total += draw_time;
+        if(update_time + draw_time > max) max = update_time + draw_time;
+    }
+    AllocCounter::stop();
+
+    if(ok)
+        std::cout << std::fixed << std::setprecision(1)
+                  << "Rodada grande (" << game->m_level_columns_count << "x" << game->m_level_rows_count << "): update media "
+                  << update_total / replay.ticks() << " us, draw media " << draw_total / replay.ticks() << " us, frame max " << max << " us, "
+                  << game->m_level.size() << " trechos carregados\n";
+    else
+        std::cout << "Falha ao carregar " << AppConfig::level_file << "\n";
+    delete game;
+
+    if(ok && AllocCounter::enabled())
+    {
+        std::cout << "Alocacoes nos frames da rodada grande: " << AllocCounter::count() << " (" << AllocCounter::bytes() << " bytes)\n";
+        ok = AllocCounter::count() == 0;
+    }
+
+    AppConfig::level_file = level_file;
+    return ok;
+}
+
+// Cada tamanho começa do zero, com a mesma semente; a maior horda é medida também sem o nível de detalhe da simulação.
+// Os limites de inimigos e a horda originais são restaurados no fim. As alocações são contadas em todos os frames,
+// inclusive os da tela de início
+bool Benchmark::horde(Uint32 ticks)
+{
+    std::string level_file = AppConfig::level_file;
+    unsigned horde_size = AppConfig::horde_size;
+    unsigned start_count = AppConfig::enemy_start_count;
+    int max_count = AppConfig::enemy_max_count_on_map;
+    unsigned lod_distance = AppConfig::lod_distance;
+    AppConfig::level_file = AppConfig::levels_path + "large";
+
+    Replay replay;
+    replay.generate(1, 2, ticks, 1);
+    struct Case
+    {
+        unsigned size;
+        bool lod;
+    };
+    const Case cases[] = {{0, true}, {250, true}, {500, true}, {1000, true}, {2000, true}, {4000, true}, {4000, false}};
+    bool ok = true;
+    Uint64 allocations = 0, bytes = 0;
+
+    for(const Case& c : cases)
+    {
+        unsigned size = c.size;
+        AppConfig::lod_distance = c.lod ? lod_distance : 0;
+        AppConfig::horde_size = size;
+        AppConfig::enemy_start_count = size > 0 ? size : start_count;
+        AppConfig::enemy_max_count_on_map = size > 0 ? static_cast<int>(size) : max_count;
+        Random::getInstance().seed(1);
+        Game* game = new Game(2, 1);
+        ok = game->m_level_rows_count > 0;
+        std::size_t enemies = game->m_enemies.size();
+
+        // A tela de início da rodada não simula nada e fica fora das médias
+        double update_total = 0, draw_total = 0, max = 0;
+        unsigned measured = 0;
+        AllocCounter::start();
+        for(Uint32 t = 0; t < replay.ticks() && ok; t++)
+        {
+            game->setScriptedInput(replay.actions(t));
+            if(game->m_level_start_screen)
+            {
+                game->update(replay.dt());
+                EventBus::getInstance().clear();
+                continue;
+            }
+            Uint64 start = SDL_GetPerformanceCounter();
+            game->update(replay.dt());
+            EventBus::getInstance().clear();
+            double update_time = elapsedUs(start);
+            start = SDL_GetPerformanceCounter();
+            game->draw();
+            double draw_time = elapsedUs(start);
+            update_total += update_time;
+            draw_total += draw_time;
+            if(update_time + draw_time > max) max = update_time + draw_time;
+            measured++;
+        }
+        AllocCounter::stop();
+        allocations += AllocCounter::count();
+        bytes += AllocCounter::bytes();
+        delete game;
+        if(!ok) break;
+        if(measured == 0) measured = 1;
+
+        std::cout << std::fixed << std::setprecision(1)
+                  << "Horda de " << enemies << " inimigos" << (c.lod ? "" : " sem LOD") << ": update media " << update_total / measured
+                  << " us, draw media " << draw_total / measured << " us, frame max " << max << " us\n";
+    }
+    if(!ok) std::cout << "Falha ao carregar " << AppConfig::level_file << "\n";
+    if(ok && AllocCounter::enabled())
+    {
+        std::cout << "Alocacoes nos frames da horda: " << allocations << " (" << bytes << " bytes)\n";
+        ok = allocations == 0;
+    }
+
+    AppConfig::horde_size = horde_size;
+    AppConfig::lod_distance = lod_distance;
+    AppConfig::enemy_start_count = start_count;
+    AppConfig::enemy_max_count_on_map = max_count;
+    AppConfig::level_file = level_file;
+    return ok;
+}
+
+// Mesma entrada e mesma semente em todas as execuções: o estado final deve ser idêntico byte a byte.
+// Duas threads rodam mesmo em um só núcleo, para que a comparação nunca seja pulada
+bool Benchmark::threads(Uint32 ticks)
+{
+    std::string level_file = AppConfig::level_file;
+    unsigned horde_size = AppConfig::horde_size;
+    unsigned start_count = AppConfig::enemy_start_count;
+    int max_count = AppConfig::enemy_max_count_on_map;
+    AppConfig::level_file = AppConfig::levels_path + "large";
+    AppConfig::horde_size = 4000;
+    AppConfig::enemy_start_count = AppConfig::horde_size;
+    AppConfig::enemy_max_count_on_map = AppConfig::horde_size;
+
+    Replay replay;
+    replay.generate(1, 2, ticks, 1);
+    unsigned cores = static_cast<unsigned>(std::max(1, SDL_GetCPUCount()));
+    std::vector<Uint8> reference, state;
+    double single = 0;
+    bool ok = true;
+
+    for(unsigned count = 1; count <= JobSystem::MAX_THREADS && (count <= 2 || count <= cores) && ok; count *= 2)
+    {
+        JobSystem::getInstance().start(count);
+        Random::getInstance().seed(1);
+        Game* game = new Game(2, 1);
+        ok = game->m_level_rows_count > 0;
+
+        double update_total = 0;
+        unsigned measured = 0;
+        for(Uint32 t = 0; t < replay.ticks() && ok; t++)
+        {
+            game->setScriptedInput(replay.actions(t));
+            bool start_screen = game->m_level_start_screen;
+            Uint64 start = SDL_GetPerformanceCounter();
+            game->update(replay.dt());
+            double update_time = elapsedUs(start);
+            EventBus::getInstance().clear();
+            if(start_screen) continue;
+            update_total += update_time;
+            measured++;
+        }
+
+        StateWriter out(count == 1 ? reference : state);
+        game->saveState(out);
+        delete game;
+        if(!ok) break;
+        if(measured == 0) measured = 1;
+
+        double average = update_total / measured;
+        if(count == 1) single = average;
+        bool same = count == 1 || state == reference;
+        std::cout << std::fixed << std::setprecision(1) << "Horda de " << AppConfig::horde_size << " com "
+                  << JobSystem::getInstance().threads() << (count == 1 ? " thread" : " threads") << ": update media "
+                  << average << " us (" << std::setprecision(2) << single / average << "x)"
+                  << (same ? "" : ", estado final diferente do de 1 thread") << "\n";
+        ok = same;
+    }
+    if(!ok) std::cout << "Falha na escala das threads em " << AppConfig::level_file << "\n";
+
+    JobSystem::getInstance().start(AppConfig::threads);
+    AppConfig::horde_size = horde_size;
+    AppConfig::enemy_start_count = start_count;
+    AppConfig::enemy_max_count_on_map = max_count;
+    AppConfig::level_file = level_file;
+    return ok;
+}
+
+double Benchmark::elapsedUs(Uint64 start)
+{
+    return static_cast<double>(SDL_GetPerformanceCounter() - start) * 1000000.0 / SDL_GetPerformanceFrequency();
+}
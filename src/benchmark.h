@@ -0,0 +1,69 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <SDL2/SDL.h>
+
+/**
+ * @brief
+ * Medições de desempenho executadas sem janela (opção --benchmark), com os mesmos recursos do jogo.
+ * Os resultados são exibidos no console.
+ */
+class Benchmark
+{
+public:
+    /**
+     * Executa todas as medições.
+     * @param iterations - quantidade de vezes que cada rodada é carregada na medição de carregamento
+     * @return @a false se alguma medição não puder ser executada ou, na compilação de teste, se algum frame alocar memória
+     */
+    static bool run(unsigned iterations);
+
+private:
+    /**
+     * Mede o tempo de carregar (Game::loadLevel) e de descartar (Game::clearLevel) cada uma das 35 rodadas, e o de
+     * carregar as 35 e a rodada grande já preparadas em segundo plano (@a LevelLoader), como na troca após o placar.
+     * @param iterations - quantidade de vezes que cada rodada é carregada
+     * @return @a false se alguma rodada não tiver sido carregada
+     */
+    static bool levelLoad(unsigned iterations);
+
+    /**
+     * Mede o tempo de Game::update e Game::draw jogando cada rodada com a entrada gerada pelos replays.
+     * Na compilação de teste (@a AllocCounter ativo) conta as alocações feitas nos frames, fora do carregamento da rodada.
+     * @param ticks - quantidade de frames por rodada
+     * @return @a false se algum frame alocar memória
+     */
+    static bool frames(Uint32 ticks);
+
+    /**
+     * Mede o tempo de Game::update e Game::draw na rodada grande de exemplo (levels_path + "large"), onde apenas a parte
+     * vista pela câmera é desenhada. Na compilação de teste conta as alocações dos frames, como frames().
+     * @param ticks - quantidade de frames
+     * @return @a false se a rodada não tiver sido carregada ou se algum frame alocar memória
+     */
+    static bool largeMap(Uint32 ticks);
+
+    /**
+     * Curva de custo do modo horda: mede Game::update e Game::draw na rodada grande com hordas de tamanhos crescentes
+     * (AppConfig::horde_size), com a mesma entrada em todas; a maior é medida também sem simulação reduzida dos distantes.
+     * Na compilação de teste conta as alocações dos frames de todos os tamanhos, como frames().
+     * @param ticks - quantidade de frames por tamanho de horda
+     * @return @a false se a rodada não tiver sido carregada ou se algum frame alocar memória
+     */
+    static bool horde(Uint32 ticks);
+
+    /**
+     * Escala das fases paralelas de Game::update: joga a maior horda da rodada grande com 1, 2, 4, 8 e 16 threads
+     * (acima de duas, até a quantidade de núcleos) e compara o estado final de cada execução com o da execução com uma thread.
+     * @param ticks - quantidade de frames por quantidade de threads
+     * @return @a false se a rodada não tiver sido carregada ou se algum estado final for diferente
+     */
+    static bool threads(Uint32 ticks);
+
+    /**
+     * @return tempo em microssegundos desde @a start
+     */
+    static double elapsedUs(Uint64 start);
+};
+
+#endif // BENCHMARK_H
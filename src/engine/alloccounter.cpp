@@ -0,0 +1,84 @@
+#include "alloccounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<bool> s_counting(false);
+static std::atomic<Uint64> s_count(0);
+static std::atomic<Uint64> s_bytes(0);
+static std::atomic<std::size_t> s_first_size(0);
+
+bool AllocCounter::enabled()
+{
+#ifdef TANKS_COUNT_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+void AllocCounter::start()
+{
+    s_count = 0;
+    s_bytes = 0;
+    s_first_size = 0;
+    s_counting = true;
+}
+
+void AllocCounter::stop()
+{
+    s_counting = false;
+}
+
+Uint64 AllocCounter::count()
+{
+    return s_count;
+}
+
+Uint64 AllocCounter::bytes()
+{
+    return s_bytes;
+}
+
+std::size_t AllocCounter::firstSize()
+{
+    return s_first_size;
+}
+
+void AllocCounter::record(std::size_t size)
+{
+    if(!s_counting.load(std::memory_order_relaxed)) return;
+    if(s_count.fetch_add(1) == 0) s_first_size = size;
+    s_bytes += size;
+}
+
+#ifdef TANKS_COUNT_ALLOCATIONS
+// Substitui os operadores globais; as formas sem tamanho, com nothrow e de arrays delegam para estas
+static void* countedAlloc(std::size_t size)
+{
+    AllocCounter::record(size);
+    void* memory = std::malloc(size > 0 ? size : 1);
+    if(memory == nullptr) throw std::bad_alloc();
+    return memory;
+}
+
+void* operator new(std::size_t size) { return countedAlloc(size); }
+void* operator new[](std::size_t size) { return countedAlloc(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    AllocCounter::record(size);
+    return std::malloc(size > 0 ? size : 1);
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    AllocCounter::record(size);
+    return std::malloc(size > 0 ? size : 1);
+}
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { std::free(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { std::free(memory); }
+#endif
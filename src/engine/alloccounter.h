@@ -0,0 +1,54 @@
+#ifndef ALLOCCOUNTER_H
+#define ALLOCCOUNTER_H
+
+#include <SDL2/SDL.h>
+#include <cstddef>
+
+/**
+ * @brief
+ * Contador de alocações dinâmicas, usado para verificar que um frame da partida não aloca memória.
+ * Na compilação de teste (make alloc-test, que define TANKS_COUNT_ALLOCATIONS) os operadores globais new/delete
+ * são substituídos e contam as alocações feitas enquanto a contagem estiver ligada; nas demais compilações
+ * o contador fica desativado e enabled() retorna @a false.
+ */
+class AllocCounter
+{
+public:
+    /**
+     * @return @a true se os operadores de alocação foram substituídos (compilação de teste)
+     */
+    static bool enabled();
+
+    /**
+     * Zera os contadores e liga a contagem.
+     */
+    static void start();
+
+    /**
+     * Desliga a contagem (os contadores mantêm os valores).
+     */
+    static void stop();
+
+    /**
+     * @return quantidade de alocações contadas
+     */
+    static Uint64 count();
+
+    /**
+     * @return total de bytes das alocações contadas
+     */
+    static Uint64 bytes();
+
+    /**
+     * @return tamanho da primeira alocação contada (0 se nenhuma)
+     */
+    static std::size_t firstSize();
+
+    /**
+     * Registra uma alocação (chamada pelos operadores substituídos).
+     * @param size - tamanho em bytes
+     */
+    static void record(std::size_t size);
+};
+
+#endif // ALLOCCOUNTER_H
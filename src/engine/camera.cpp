@@ -0,0 +1,49 @@
+#include "camera.h"
+
+Camera::Camera()
+{
+    m_world = {0, 0, 0, 0};
+    m_view = {0, 0, 0, 0};
+}
+
+void Camera::setWorld(const SDL_Rect& world, int view_w, int view_h)
+{
+    m_world = world;
+    m_view = {world.x, world.y, view_w, view_h};
+}
+
+void Camera::follow(SDL_Point center)
+{
+    int x = center.x - m_view.w / 2;
+    int y = center.y - m_view.h / 2;
+    // Mundo menor que a vista: fica alinhado à origem, como no mapa original
+    if(x > m_world.x + m_world.w - m_view.w) x = m_world.x + m_world.w - m_view.w;
+    if(y > m_world.y + m_world.h - m_view.h) y = m_world.y + m_world.h - m_view.h;
+    if(x < m_world.x) x = m_world.x;
+    if(y < m_world.y) y = m_world.y;
+    m_view.x = x;
+    m_view.y = y;
+}
+
+const SDL_Rect& Camera::view() const
+{
+    return m_view;
+}
+
+bool Camera::visible(const SDL_Rect& rect) const
+{
+    return rect.x < m_view.x + m_view.w && rect.x + rect.w > m_view.x
+        && rect.y < m_view.y + m_view.h && rect.y + rect.h > m_view.y;
+}
+
+void Camera::visibleTiles(const SDL_Rect& tile, int columns, int rows, SDL_Point& first, SDL_Point& last) const
+{
+    first.x = (m_view.x - m_world.x) / tile.w;
+    first.y = (m_view.y - m_world.y) / tile.h;
+    last.x = (m_view.x - m_world.x + m_view.w - 1) / tile.w;
+    last.y = (m_view.y - m_world.y + m_view.h - 1) / tile.h;
+    if(first.x < 0) first.x = 0;
+    if(first.y < 0) first.y = 0;
+    if(last.x >= columns) last.x = columns - 1;
+    if(last.y >= rows) last.y = rows - 1;
+}
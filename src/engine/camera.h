@@ -0,0 +1,58 @@
+#ifndef CAMERA_H
+#define CAMERA_H
+
+#include <SDL2/SDL.h>
+
+/**
+ * @brief
+ * Parte da rodada (mundo) mostrada na área do mapa. Segue um ponto (o centro dos jogadores) sem sair dos limites
+ * do mundo; em rodadas do tamanho do mapa fica parada na origem. Não faz parte do estado da simulação: o desenho e o
+ * nível de detalhe da simulação (Game::updateLod) a recalculam a partir das posições dos jogadores.
+ * visible() e visibleTiles() permitem desenhar apenas o que está à vista.
+ */
+class Camera
+{
+public:
+    Camera();
+
+    /**
+     * Define o tamanho do mundo e da área vista.
+     * @param world - área da rodada em pixels
+     * @param view_w - largura da área vista
+     * @param view_h - altura da área vista
+     */
+    void setWorld(const SDL_Rect& world, int view_w, int view_h);
+
+    /**
+     * Centraliza a vista em @a center, limitada ao mundo.
+     * @param center - ponto do mundo
+     */
+    void follow(SDL_Point center);
+
+    /**
+     * @return área do mundo vista
+     */
+    const SDL_Rect& view() const;
+
+    /**
+     * @param rect - retângulo no mundo
+     * @return @a true se alguma parte de @a rect estiver à vista
+     */
+    bool visible(const SDL_Rect& rect) const;
+
+    /**
+     * Calcula o intervalo de tiles à vista.
+     * @param tile - tamanho de um tile
+     * @param columns - colunas do mundo
+     * @param rows - linhas do mundo
+     * @param first - primeira coluna (x) e linha (y) à vista
+     * @param last - última coluna (x) e linha (y) à vista; menor que @a first se nenhum tile estiver à vista
+     */
+    void visibleTiles(const SDL_Rect& tile, int columns, int rows, SDL_Point& first, SDL_Point& last) const;
+
+private:
+    SDL_Rect m_world;   ///< Área do mundo.
+    SDL_Rect m_view;    ///< Área vista.
+};
+
+#endif // CAMERA_H
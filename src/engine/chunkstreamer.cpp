@@ -0,0 +1,110 @@
+#include "chunkstreamer.h"
+
+#include <cstring>
+
+ChunkStreamer::ChunkStreamer() : m_stop(false)
+{
+    m_file = nullptr;
+    m_thread = nullptr;
+    m_wake = nullptr;
+    for(int i = 0; i < BUFFERS; i++) m_in_use[i] = false;
+}
+
+ChunkStreamer::~ChunkStreamer()
+{
+    stop();
+}
+
+bool ChunkStreamer::start(const LevelFile* file)
+{
+    stop();
+    m_file = file;
+    m_stop = false;
+    m_wake = SDL_CreateSemaphore(0);
+    if(m_wake == nullptr) return false;
+    m_thread = SDL_CreateThread(run, "chunks", this);
+    if(m_thread == nullptr)
+    {
+        SDL_DestroySemaphore(m_wake);
+        m_wake = nullptr;
+        return false;
+    }
+    return true;
+}
+
+void ChunkStreamer::stop()
+{
+    if(m_thread != nullptr)
+    {
+        m_stop = true;
+        SDL_SemPost(m_wake);
+        SDL_WaitThread(m_thread, nullptr);
+        m_thread = nullptr;
+    }
+    if(m_wake != nullptr)
+    {
+        SDL_DestroySemaphore(m_wake);
+        m_wake = nullptr;
+    }
+
+    // Pedidos não atendidos e trechos não recolhidos são descartados
+    Job job;
+    while(m_requests.pop(job)) {}
+    while(m_done.pop(job)) {}
+    for(int i = 0; i < BUFFERS; i++) m_in_use[i] = false;
+    m_file = nullptr;
+}
+
+bool ChunkStreamer::running() const
+{
+    return m_thread != nullptr;
+}
+
+bool ChunkStreamer::request(Uint32 key)
+{
+    if(m_thread == nullptr) return false;
+
+    int free_buffer = -1;
+    for(int i = 0; i < BUFFERS; i++)
+    {
+        if(m_in_use[i] && m_pending[i] == key) return true;
+        if(!m_in_use[i] && free_buffer < 0) free_buffer = i;
+    }
+    if(free_buffer < 0) return false;
+
+    // Cada buffer tem no máximo um pedido, então a fila (do tamanho da quantidade de buffers) nunca enche
+    m_in_use[free_buffer] = true;
+    m_pending[free_buffer] = key;
+    m_requests.push({key, free_buffer});
+    SDL_SemPost(m_wake);
+    return true;
+}
+
+bool ChunkStreamer::poll(Uint32& key, char* cells)
+{
+    Job job;
+    if(!m_done.pop(job)) return false;
+    key = job.key;
+    std::memcpy(cells, m_buffers[job.buffer], LevelChunks::CHUNK_CELLS);
+    m_in_use[job.buffer] = false;
+    return true;
+}
+
+// Um sinal por pedido; cada despertar atende todos os pedidos da fila
+int ChunkStreamer::run(void* data)
+{
+    ChunkStreamer* streamer = static_cast<ChunkStreamer*>(data);
+    while(true)
+    {
+        SDL_SemWait(streamer->m_wake);
+        if(streamer->m_stop) break;
+
+        Job job;
+        while(streamer->m_requests.pop(job))
+        {
+            streamer->m_file->readChunk(job.key, streamer->m_buffers[job.buffer]);
+            streamer->m_done.push(job);
+        }
+    }
+    return 0;
+}
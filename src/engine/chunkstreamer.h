@@ -0,0 +1,91 @@
+#ifndef CHUNKSTREAMER_H
+#define CHUNKSTREAMER_H
+
+#include "levelchunks.h"
+#include "levelfile.h"
+#include "spscqueue.h"
+
+#include <SDL2/SDL.h>
+#include <atomic>
+
+/**
+ * @brief
+ * Lê trechos de um @a LevelFile em uma thread de trabalho, para que a leitura do arquivo mapeado (e as faltas de página)
+ * não aconteça na thread do jogo. A thread do jogo pede trechos com request() e recolhe os prontos com poll();
+ * a comunicação usa duas filas sem travas (@a SpscQueue) e buffers fixos, sem alocar memória.
+ * Apenas a thread do jogo chama os métodos públicos.
+ */
+class ChunkStreamer
+{
+public:
+    ChunkStreamer();
+
+    /**
+     * Encerra a thread de trabalho.
+     */
+    ~ChunkStreamer();
+
+    ChunkStreamer(const ChunkStreamer&) = delete;
+    ChunkStreamer& operator=(const ChunkStreamer&) = delete;
+
+    /**
+     * Inicia a thread de trabalho.
+     * @param file - arquivo aberto; deve continuar aberto até stop()
+     * @return @a false se a thread não puder ser criada
+     */
+    bool start(const LevelFile* file);
+
+    /**
+     * Encerra a thread de trabalho e descarta os pedidos pendentes.
+     */
+    void stop();
+
+    /**
+     * @return @a true entre start() e stop()
+     */
+    bool running() const;
+
+    /**
+     * Pede a leitura de um trecho; pedidos repetidos de um trecho ainda não recolhido são ignorados.
+     * @param key - código do trecho
+     * @return @a false se não houver buffer livre (o pedido pode ser repetido depois)
+     */
+    bool request(Uint32 key);
+
+    /**
+     * Recolhe um trecho lido.
+     * @param key - recebe o código do trecho
+     * @param cells - recebe LevelChunks::CHUNK_CELLS caracteres em ordem de Morton
+     * @return @a false se nenhum trecho estiver pronto
+     */
+    bool poll(Uint32& key, char* cells);
+
+private:
+    static const int BUFFERS = 32;
+
+    /**
+     * @brief Pedido de leitura: trecho e buffer que recebe as células.
+     */
+    struct Job
+    {
+        Uint32 key;
+        int buffer;
+    };
+
+    /**
+     * Laço da thread de trabalho.
+     */
+    static int run(void* data);
+
+    const LevelFile* m_file;                                ///< Arquivo da rodada.
+    SDL_Thread* m_thread;                                   ///< Thread de trabalho, ou nullptr.
+    SDL_sem* m_wake;                                        ///< Sinalizado a cada pedido (e no encerramento).
+    std::atomic<bool> m_stop;                               ///< Pede o fim da thread de trabalho.
+    SpscQueue<Job, BUFFERS> m_requests;                     ///< Pedidos (thread do jogo -> trabalho).
+    SpscQueue<Job, BUFFERS> m_done;                         ///< Trechos lidos (trabalho -> thread do jogo).
+    char m_buffers[BUFFERS][LevelChunks::CHUNK_CELLS];      ///< Células lidas de cada pedido.
+    Uint32 m_pending[BUFFERS];                              ///< Trecho pedido em cada buffer em uso.
+    bool m_in_use[BUFFERS];                                 ///< Buffer com pedido ainda não recolhido.
+};
+
+#endif // CHUNKSTREAMER_H
@@ -18,19 +18,28 @@ Engine &Engine::getEngine()
 // Suporta números negativos
 std::string Engine::intToString(int num)
 {
-    if(num == 0) return "0"; // Caso especial para zero
+    char buffer[12];
+    return intToString(num, buffer);
+}
 
-    std::string buf;
-    bool negative = false;
-    if(num < 0)
+// Converte um número inteiro para texto no buffer fornecido, sem alocar memória
+const char* Engine::intToString(int num, char* buffer)
+{
+    // Constrói o texto do número, dígito a dígito (da direita para a esquerda)
+    char digits[12];
+    int count = 0;
+    unsigned value = num < 0 ? 0u - static_cast<unsigned>(num) : static_cast<unsigned>(num);
+    do
     {
-        negative = true; // Marca se o número é negativo
-        num = -num;
-    }
-    // Constrói a string do número, dígito a dígito (da direita para a esquerda)
-    for(; num; num /= 10) buf = "0123456789abcdef"[num % 10] + buf;
-    if(negative) buf = "-" + buf; // Adiciona o sinal negativo, se necessário
-    return buf;
+        digits[count++] = "0123456789"[value % 10];
+        value /= 10;
+    } while(value > 0);
+
+    int pos = 0;
+    if(num < 0) buffer[pos++] = '-'; // Adiciona o sinal negativo, se necessário
+    while(count > 0) buffer[pos++] = digits[--count];
+    buffer[pos] = '\0';
+    return buffer;
 }
 
 // Inicializa os módulos principais da engine (renderizador e configuração de sprites)
@@ -30,6 +30,14 @@ public:
      */
     static std::string intToString(int num);
 
+    /**
+     * Converte um valor inteiro para texto sem alocar memória.
+     * @param num Valor inteiro a ser convertido.
+     * @param buffer Destino com pelo menos 12 caracteres.
+     * @return @a buffer, terminado em '\0'.
+     */
+    static const char* intToString(int num, char* buffer);
+
     /**
      * Inicializa os módulos principais da engine (renderizador e configuração de sprites).
      * Deve ser chamada antes de usar o renderizador ou sprites.
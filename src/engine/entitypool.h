@@ -0,0 +1,128 @@
+#ifndef ENTITYPOOL_H
+#define ENTITYPOOL_H
+
+#include <utility>
+#include <vector>
+
+/**
+ * @brief
+ * Conjunto de objetos com dono único.
+ * Os objetos ficam em um vetor contínuo na ordem de inserção (iteração como um std::vector<T*>), que é compactado
+ * em uma passada quando objetos saem. O pool apaga os objetos que ainda contém ao ser destruído; pode ser movido,
+ * mas não copiado, o que permite passar os objetos de um estado do jogo para outro sem ponteiros compartilhados.
+ */
+template <typename T>
+class EntityPool
+{
+public:
+    typedef typename std::vector<T*>::const_iterator const_iterator;
+
+    EntityPool() {}
+    ~EntityPool() { clear(); }
+
+    EntityPool(const EntityPool&) = delete;
+    EntityPool& operator=(const EntityPool&) = delete;
+
+    EntityPool(EntityPool&& other) noexcept : m_objects(std::move(other.m_objects)) {}
+
+    EntityPool& operator=(EntityPool&& other) noexcept
+    {
+        if(this != &other)
+        {
+            clear();
+            m_objects = std::move(other.m_objects);
+            other.m_objects.clear();
+        }
+        return *this;
+    }
+
+    /**
+     * Adiciona um objeto ao fim do pool, que passa a ser seu dono.
+     * @param object - objeto alocado com new
+     */
+    void insert(T* object)
+    {
+        m_objects.push_back(object);
+    }
+
+    /**
+     * Retira o último objeto do pool sem apagá-lo.
+     * @return objeto retirado, ou nullptr se o pool estiver vazio
+     */
+    T* pop()
+    {
+        if(m_objects.empty()) return nullptr;
+        T* object = m_objects.back();
+        m_objects.pop_back();
+        return object;
+    }
+
+    /**
+     * Apaga os objetos para os quais @a predicate retorna @a true, mantendo a ordem dos demais.
+     * @param predicate - função bool(T*)
+     */
+    template <typename Predicate>
+    void eraseIf(Predicate predicate)
+    {
+        transferIf(predicate, nullptr);
+    }
+
+    /**
+     * Move para o fim de @a target os objetos para os quais @a predicate retorna @a true, mantendo a ordem.
+     * @param predicate - função bool(T*)
+     * @param target - pool de destino
+     */
+    template <typename Predicate>
+    void moveIf(Predicate predicate, EntityPool& target)
+    {
+        transferIf(predicate, &target);
+    }
+
+    /**
+     * Reserva espaço para @a count objetos, para que insert() não aloque memória até esse limite.
+     * @param count - quantidade de objetos
+     */
+    void reserve(std::size_t count)
+    {
+        m_objects.reserve(count);
+    }
+
+    /**
+     * Apaga todos os objetos.
+     */
+    void clear()
+    {
+        while(!m_objects.empty()) delete pop();
+    }
+
+    std::size_t size() const { return m_objects.size(); }
+    bool empty() const { return m_objects.empty(); }
+    T* at(std::size_t position) const { return m_objects.at(position); }
+    T* back() const { return m_objects.back(); }
+    const_iterator begin() const { return m_objects.begin(); }
+    const_iterator end() const { return m_objects.end(); }
+
+private:
+    // Compacta o vetor em uma passada: objetos selecionados vão para target (ou são apagados se target for nulo)
+    template <typename Predicate>
+    void transferIf(Predicate& predicate, EntityPool* target)
+    {
+        std::size_t kept = 0;
+        for(std::size_t i = 0; i < m_objects.size(); i++)
+        {
+            T* object = m_objects[i];
+            if(predicate(object))
+            {
+                if(target != nullptr) target->insert(object);
+                else delete object;
+                continue;
+            }
+            m_objects[kept++] = object;
+        }
+        m_objects.resize(kept);
+    }
+
+    std::vector<T*> m_objects;      ///< Objetos na ordem de iteração.
+};
+
+#endif // ENTITYPOOL_H
@@ -0,0 +1,105 @@
+#ifndef FIXED_H
+#define FIXED_H
+
+#include <SDL2/SDL.h>
+
+/**
+ * @brief
+ * Número em ponto fixo 16.16 (inteiro de 32 bits com 16 bits de fração), usado nas posições e velocidades da simulação.
+ * As operações são feitas apenas com inteiros, portanto o resultado não depende do compilador, das opções de otimização
+ * nem da FPU; a conversão para pixels (toInt) é um deslocamento de bits, sem conversão double/int.
+ * Inteiros são convertidos implicitamente (em pixels); frações constantes são criadas com fromRatio().
+ */
+class Fixed
+{
+public:
+    /**
+     * Quantidade de bits da parte fracionária.
+     */
+    static const int FRACTION_BITS = 16;
+
+    /**
+     * Representação interna do valor 1.
+     */
+    static const Sint32 ONE = 1 << FRACTION_BITS;
+
+    /**
+     * Cria o valor zero.
+     */
+    constexpr Fixed() : m_raw(0) {}
+
+    /**
+     * Cria o valor a partir de um número inteiro de pixels.
+     * @param value - valor inteiro
+     */
+    constexpr Fixed(int value) : m_raw(value * ONE) {}
+    constexpr Fixed(unsigned value) : m_raw(static_cast<Sint32>(value) * ONE) {}
+
+    /**
+     * Conversão de números reais proibida: truncaria o valor em silêncio. Use fromRatio().
+     */
+    Fixed(double) = delete;
+
+    /**
+     * Cria o valor a partir da representação interna.
+     * @param raw - valor multiplicado por 2^16
+     * @return valor em ponto fixo
+     */
+    static constexpr Fixed fromRaw(Sint32 raw) { return Fixed(raw, 0); }
+
+    /**
+     * Cria o valor @a numerator / @a denominator, arredondado para a fração representável mais próxima.
+     * Exemplo: fromRatio(8, 100) equivale a 0.08.
+     * @param numerator - numerador
+     * @param denominator - denominador (positivo)
+     * @return valor em ponto fixo
+     */
+    static constexpr Fixed fromRatio(int numerator, int denominator)
+    {
+        return fromRaw(static_cast<Sint32>((static_cast<Sint64>(numerator) * ONE + denominator / 2) / denominator));
+    }
+
+    /**
+     * Retorna a representação interna.
+     * @return valor multiplicado por 2^16
+     */
+    constexpr Sint32 raw() const { return m_raw; }
+
+    /**
+     * Converte para pixels, arredondando para baixo.
+     * @return parte inteira do valor
+     */
+    constexpr int toInt() const { return m_raw >> FRACTION_BITS; }
+
+    Fixed& operator+=(Fixed other) { m_raw += other.m_raw; return *this; }
+    Fixed& operator-=(Fixed other) { m_raw -= other.m_raw; return *this; }
+
+    friend constexpr Fixed operator+(Fixed a, Fixed b) { return fromRaw(a.m_raw + b.m_raw); }
+    friend constexpr Fixed operator-(Fixed a, Fixed b) { return fromRaw(a.m_raw - b.m_raw); }
+    friend constexpr Fixed operator-(Fixed a) { return fromRaw(-a.m_raw); }
+
+    /**
+     * Multiplica por um inteiro (ex.: velocidade * dt).
+     */
+    friend constexpr Fixed operator*(Fixed a, int b) { return fromRaw(static_cast<Sint32>(static_cast<Sint64>(a.m_raw) * b)); }
+    friend constexpr Fixed operator*(Fixed a, Uint32 b) { return fromRaw(static_cast<Sint32>(static_cast<Sint64>(a.m_raw) * b)); }
+
+    /**
+     * Divide por um inteiro, arredondando em direção a zero.
+     */
+    friend constexpr Fixed operator/(Fixed a, int b) { return fromRaw(a.m_raw / b); }
+
+    friend constexpr bool operator==(Fixed a, Fixed b) { return a.m_raw == b.m_raw; }
+    friend constexpr bool operator!=(Fixed a, Fixed b) { return a.m_raw != b.m_raw; }
+    friend constexpr bool operator<(Fixed a, Fixed b) { return a.m_raw < b.m_raw; }
+    friend constexpr bool operator<=(Fixed a, Fixed b) { return a.m_raw <= b.m_raw; }
+    friend constexpr bool operator>(Fixed a, Fixed b) { return a.m_raw > b.m_raw; }
+    friend constexpr bool operator>=(Fixed a, Fixed b) { return a.m_raw >= b.m_raw; }
+
+private:
+    constexpr Fixed(Sint32 raw, int) : m_raw(raw) {}
+
+    Sint32 m_raw;   ///< Valor multiplicado por 2^16.
+};
+
+#endif // FIXED_H
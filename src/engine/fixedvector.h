@@ -0,0 +1,70 @@
+#ifndef FIXEDVECTOR_H
+#define FIXEDVECTOR_H
+
+#include <cstddef>
+
+/**
+ * @brief
+ * Vetor com capacidade fixa, guardado dentro do próprio objeto: nunca aloca memória.
+ * Oferece a parte da interface de std::vector usada pelos objetos do jogo (iteração, push_back, erase com remove_if).
+ * @tparam T - tipo dos elementos (trivialmente copiável, ex.: ponteiros)
+ * @tparam Capacity - quantidade máxima de elementos
+ */
+template <typename T, std::size_t Capacity>
+class FixedVector
+{
+public:
+    typedef T* iterator;
+    typedef const T* const_iterator;
+
+    FixedVector() : m_size(0) {}
+
+    /**
+     * Acrescenta um elemento no fim.
+     * @param item - elemento
+     * @return @a false se o vetor estiver cheio (o elemento é descartado)
+     */
+    bool push_back(const T& item)
+    {
+        if(m_size == Capacity) return false;
+        m_items[m_size++] = item;
+        return true;
+    }
+
+    void pop_back() { if(m_size > 0) m_size--; }
+
+    /**
+     * Remove os elementos do intervalo [first, last), mantendo a ordem dos demais.
+     * @return posição seguinte ao último elemento removido
+     */
+    iterator erase(iterator first, iterator last)
+    {
+        iterator out = first;
+        for(iterator it = last; it != end(); ++it, ++out) *out = *it;
+        m_size -= last - first;
+        return first;
+    }
+
+    void clear() { m_size = 0; }
+
+    std::size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    bool full() const { return m_size == Capacity; }
+    static constexpr std::size_t capacity() { return Capacity; }
+
+    T& back() { return m_items[m_size - 1]; }
+    const T& back() const { return m_items[m_size - 1]; }
+    T& operator[](std::size_t i) { return m_items[i]; }
+    const T& operator[](std::size_t i) const { return m_items[i]; }
+
+    iterator begin() { return m_items; }
+    iterator end() { return m_items + m_size; }
+    const_iterator begin() const { return m_items; }
+    const_iterator end() const { return m_items + m_size; }
+
+private:
+    T m_items[Capacity];    ///< Elementos.
+    std::size_t m_size;     ///< Quantidade de elementos.
+};
+
+#endif // FIXEDVECTOR_H
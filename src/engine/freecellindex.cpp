@@ -0,0 +1,124 @@
+#include "freecellindex.h"
+
+#include <utility>
+
+// Contagem de bits em paralelo (SWAR), sem depender de instruções específicas do processador
+static unsigned popCount(Uint64 word)
+{
+    word = word - ((word >> 1) & 0x5555555555555555ULL);
+    word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+    word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return static_cast<unsigned>((word * 0x0101010101010101ULL) >> 56);
+}
+
+// Posição do k-ésimo bit 1 da palavra: escolhe o byte pelas contagens e depois o bit dentro dele
+static unsigned selectInWord(Uint64 word, unsigned k)
+{
+    unsigned shift = 0;
+    while(true)
+    {
+        unsigned bits = popCount((word >> shift) & 0xFF);
+        if(k < bits) break;
+        k -= bits;
+        shift += 8;
+    }
+    while(true)
+    {
+        if((word >> shift) & 1)
+        {
+            if(k == 0) return shift;
+            k--;
+        }
+        shift++;
+    }
+}
+
+FreeCellIndex::FreeCellIndex()
+{
+    m_tree_step = 0;
+    m_size = 0;
+    m_count = 0;
+}
+
+void FreeCellIndex::reset(unsigned size)
+{
+    m_size = size;
+    m_count = 0;
+    m_words.assign((size + 63) / 64, 0);
+    unsigned blocks = (size + BLOCK_CELLS - 1) / BLOCK_CELLS;
+    m_tree.assign(blocks + 1, 0);
+    m_tree_step = 1;
+    while(m_tree_step * 2 <= blocks) m_tree_step *= 2;
+}
+
+void FreeCellIndex::swap(FreeCellIndex& other)
+{
+    m_words.swap(other.m_words);
+    m_tree.swap(other.m_tree);
+    std::swap(m_tree_step, other.m_tree_step);
+    std::swap(m_size, other.m_size);
+    std::swap(m_count, other.m_count);
+}
+
+unsigned FreeCellIndex::size() const
+{
+    return m_size;
+}
+
+void FreeCellIndex::set(unsigned cell, bool free)
+{
+    Uint64& word = m_words[cell / 64];
+    Uint64 bit = Uint64(1) << (cell % 64);
+    if(((word & bit) != 0) == free) return;
+    word ^= bit;
+    if(free) m_count++;
+    else m_count--;
+    for(unsigned i = cell / BLOCK_CELLS + 1; i < m_tree.size(); i += i & (0 - i))
+    {
+        if(free) m_tree[i]++;
+        else m_tree[i]--;
+    }
+}
+
+bool FreeCellIndex::test(unsigned cell) const
+{
+    return (m_words[cell / 64] >> (cell % 64)) & 1;
+}
+
+unsigned FreeCellIndex::count() const
+{
+    return m_count;
+}
+
+unsigned FreeCellIndex::rank(unsigned cell) const
+{
+    unsigned block = cell / BLOCK_CELLS;
+    unsigned result = 0;
+    for(unsigned i = block; i > 0; i -= i & (0 - i)) result += m_tree[i];
+    unsigned word = cell / 64;
+    for(unsigned i = block * BLOCK_WORDS; i < word; i++) result += popCount(m_words[i]);
+    if(cell % 64 != 0) result += popCount(m_words[word] & ((Uint64(1) << (cell % 64)) - 1));
+    return result;
+}
+
+unsigned FreeCellIndex::select(unsigned k) const
+{
+    // Descida na árvore: maior quantidade de blocos iniciais com no máximo k células livres
+    unsigned block = 0;
+    for(unsigned step = m_tree_step; step > 0; step /= 2)
+        if(block + step < m_tree.size() && m_tree[block + step] <= k)
+        {
+            block += step;
+            k -= m_tree[block];
+        }
+
+    unsigned word = block * BLOCK_WORDS;
+    while(true)
+    {
+        unsigned bits = popCount(m_words[word]);
+        if(k < bits) break;
+        k -= bits;
+        word++;
+    }
+    return word * 64 + selectInWord(m_words[word], k);
+}
@@ -0,0 +1,106 @@
+#ifndef FREECELLINDEX_H
+#define FREECELLINDEX_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+/**
+ * @brief
+ * Conjunto de células livres guardado como mapa de bits, com contagem (rank) e seleção (select) para sortear uma
+ * célula livre de forma uniforme sem tentativa e erro. As células livres de cada bloco de BLOCK_WORDS palavras ficam em
+ * uma árvore de Fenwick: marcar, contar e selecionar custam O(log blocos), mais a varredura de no máximo BLOCK_WORDS
+ * palavras dentro do bloco.
+ */
+class FreeCellIndex
+{
+public:
+    FreeCellIndex();
+
+    /**
+     * Redimensiona o conjunto; todas as células ficam ocupadas.
+     * @param size - quantidade de células
+     */
+    void reset(unsigned size);
+
+    /**
+     * Refaz o conjunto com os blocos de 2x2 células de uma grade que não contêm célula bloqueada; o bloco é indexado
+     * pela célula do canto superior esquerdo (linha * (columns - 1) + coluna). Uma passada pelas linhas, guardando
+     * as células bloqueadas da linha anterior.
+     * @param columns - colunas da grade
+     * @param rows - linhas da grade
+     * @param blocked - função (linha, coluna) que indica se a célula está bloqueada
+     * @param above - linha de trabalho (redimensionada para @a columns posições se preciso)
+     * @param current - linha de trabalho (redimensionada para @a columns posições se preciso)
+     */
+    template<typename Blocked>
+    void buildBlocks(int columns, int rows, const Blocked& blocked, std::vector<bool>& above, std::vector<bool>& current)
+    {
+        int block_columns = columns - 1;
+        reset(block_columns > 0 && rows > 1 ? block_columns * (rows - 1) : 0);
+        if(m_size == 0) return;
+
+        above.resize(columns);
+        current.resize(columns);
+        for(int row = 0; row < rows; row++)
+        {
+            for(int column = 0; column < columns; column++) current[column] = blocked(row, column);
+            if(row > 0)
+                for(int column = 0; column < block_columns; column++)
+                    set((row - 1) * block_columns + column, !above[column] && !above[column + 1] && !current[column] && !current[column + 1]);
+            above.swap(current);
+        }
+    }
+
+    /**
+     * Troca o conteúdo com outro conjunto (usado para receber um conjunto montado em outra thread).
+     * @param other - outro conjunto
+     */
+    void swap(FreeCellIndex& other);
+
+    /**
+     * @return quantidade de células
+     */
+    unsigned size() const;
+
+    /**
+     * Marca uma célula como livre ou ocupada.
+     * @param cell - índice da célula
+     * @param free - @a true se a célula estiver livre
+     */
+    void set(unsigned cell, bool free);
+
+    /**
+     * @param cell - índice da célula
+     * @return @a true se a célula estiver livre
+     */
+    bool test(unsigned cell) const;
+
+    /**
+     * @return quantidade de células livres
+     */
+    unsigned count() const;
+
+    /**
+     * @param cell - índice da célula (pode ser igual a size())
+     * @return quantidade de células livres antes de @a cell
+     */
+    unsigned rank(unsigned cell) const;
+
+    /**
+     * @param k - posição entre as células livres, menor que count()
+     * @return índice da k-ésima célula livre (começando em 0)
+     */
+    unsigned select(unsigned k) const;
+
+private:
+    static const unsigned BLOCK_WORDS = 8;  ///< Palavras de 64 bits por bloco da árvore de contagens.
+    static const unsigned BLOCK_CELLS = BLOCK_WORDS * 64;  ///< Células por bloco.
+
+    std::vector<Uint64> m_words;        ///< Bit 1 para cada célula livre.
+    std::vector<unsigned> m_tree;       ///< Árvore de Fenwick das células livres por bloco (posição 0 sem uso).
+    unsigned m_tree_step;               ///< Maior potência de 2 que não passa da quantidade de blocos (ver select()).
+    unsigned m_size;                    ///< Quantidade de células.
+    unsigned m_count;                   ///< Quantidade de células livres.
+};
+
+#endif // FREECELLINDEX_H
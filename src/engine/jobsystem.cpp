@@ -0,0 +1,158 @@
+#include "jobsystem.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+
+JobSystem& JobSystem::getInstance()
+{
+    static JobSystem instance;
+    return instance;
+}
+
+JobSystem::JobSystem() : m_pending(0), m_stop(false)
+{
+    m_queues = nullptr;
+    m_thread_count = 1;
+    m_wake = nullptr;
+    for(unsigned i = 0; i < MAX_THREADS; i++) m_workers[i] = nullptr;
+}
+
+JobSystem::~JobSystem()
+{
+    stop();
+}
+
+bool JobSystem::start(unsigned threads)
+{
+    stop();
+    if(threads == 0) threads = static_cast<unsigned>(std::max(1, SDL_GetCPUCount()));
+    threads = std::min(threads, MAX_THREADS);
+    if(threads == 1) return true;
+
+    m_queues = new WorkQueue[threads];
+    for(unsigned q = 0; q < threads; q++)
+    {
+        m_queues[q].lock = 0;
+        m_queues[q].head = 0;
+        m_queues[q].tail = 0;
+    }
+    m_stop = false;
+    m_wake = SDL_CreateSemaphore(0);
+    if(m_wake == nullptr) return false;
+
+    // A thread i usa a fila i; a quantidade só aumenta depois que a thread existe
+    for(unsigned i = 1; i < threads; i++)
+    {
+        m_workers[i] = SDL_CreateThread(worker, "jobs", reinterpret_cast<void*>(static_cast<std::uintptr_t>(i)));
+        if(m_workers[i] == nullptr) return false;
+        m_thread_count++;
+    }
+    return true;
+}
+
+void JobSystem::stop()
+{
+    if(m_thread_count > 1)
+    {
+        m_stop = true;
+        for(unsigned i = 1; i < m_thread_count; i++) SDL_SemPost(m_wake);
+        for(unsigned i = 1; i < m_thread_count; i++)
+        {
+            SDL_WaitThread(m_workers[i], nullptr);
+            m_workers[i] = nullptr;
+        }
+    }
+    if(m_wake != nullptr)
+    {
+        SDL_DestroySemaphore(m_wake);
+        m_wake = nullptr;
+    }
+    delete[] m_queues;
+    m_queues = nullptr;
+    m_thread_count = 1;
+}
+
+unsigned JobSystem::threads() const
+{
+    return m_thread_count;
+}
+
+// Cada fila recebe um trecho contínuo dos índices; o roubo só acontece quando uma thread termina o seu antes das outras
+void JobSystem::run(unsigned count, unsigned grain, JobFunction function, void* context)
+{
+    unsigned capacity = m_thread_count * QUEUE_CAPACITY;
+    grain = std::max(grain, 1u);
+    if((count + grain - 1) / grain > capacity) grain = (count + capacity - 1) / capacity;
+    unsigned jobs = (count + grain - 1) / grain;
+
+    m_pending.store(jobs, std::memory_order_release);
+    for(unsigned q = 0; q < m_thread_count; q++)
+    {
+        WorkQueue& queue = m_queues[q];
+        SDL_AtomicLock(&queue.lock);
+        queue.head = 0;
+        queue.tail = 0;
+        for(unsigned j = jobs * q / m_thread_count; j < jobs * (q + 1) / m_thread_count; j++)
+            queue.jobs[queue.tail++] = {function, context, j * grain, std::min(count, (j + 1) * grain)};
+        SDL_AtomicUnlock(&queue.lock);
+    }
+    for(unsigned i = 1; i < m_thread_count; i++) SDL_SemPost(m_wake);
+
+    // A thread que chama também trabalha; sem tarefas a pegar, espera as que estão em execução
+    Job job;
+    while(m_pending.load(std::memory_order_acquire) > 0)
+    {
+        if(take(0, job)) execute(job);
+        else std::this_thread::yield();
+    }
+}
+
+bool JobSystem::take(unsigned queue, Job& job)
+{
+    WorkQueue& own = m_queues[queue];
+    SDL_AtomicLock(&own.lock);
+    if(own.tail > own.head)
+    {
+        job = own.jobs[--own.tail];
+        SDL_AtomicUnlock(&own.lock);
+        return true;
+    }
+    SDL_AtomicUnlock(&own.lock);
+
+    for(unsigned i = 1; i < m_thread_count; i++)
+    {
+        WorkQueue& other = m_queues[(queue + i) % m_thread_count];
+        SDL_AtomicLock(&other.lock);
+        if(other.tail > other.head)
+        {
+            job = other.jobs[other.head++];
+            SDL_AtomicUnlock(&other.lock);
+            return true;
+        }
+        SDL_AtomicUnlock(&other.lock);
+    }
+    return false;
+}
+
+void JobSystem::execute(const Job& job)
+{
+    job.function(job.context, job.begin, job.end);
+    m_pending.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+// Um sinal por parallelFor(); cada despertar trabalha até não haver tarefas em nenhuma fila
+int JobSystem::worker(void* data)
+{
+    JobSystem& system = getInstance();
+    unsigned queue = static_cast<unsigned>(reinterpret_cast<std::uintptr_t>(data));
+    while(true)
+    {
+        SDL_SemWait(system.m_wake);
+        if(system.m_stop) break;
+
+        Job job;
+        while(system.take(queue, job)) system.execute(job);
+    }
+    return 0;
+}
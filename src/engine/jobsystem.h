@@ -0,0 +1,136 @@
+#ifndef JOBSYSTEM_H
+#define JOBSYSTEM_H
+
+#include <SDL2/SDL.h>
+#include <atomic>
+
+/**
+ * @brief
+ * Distribuidor de tarefas com roubo de trabalho (Singleton). parallelFor() divide um intervalo de índices em tarefas,
+ * reparte as tarefas entre as filas das threads (a thread que chamou também trabalha) e só retorna quando todas
+ * terminarem. Cada thread retira tarefas do fim da própria fila; sem tarefas, rouba do início da fila de outra.
+ * As tarefas ficam em vetores fixos criados em start(), então parallelFor() não aloca memória.
+ *
+ * O corpo do laço deve tocar apenas a entidade do seu índice: o resultado é o mesmo em qualquer quantidade de threads,
+ * e o que for compartilhado (alocações, eventos, temporizadores, sorteios) fica para um passo sequencial depois do
+ * laço, na ordem dos índices. parallelFor() não pode ser chamado de dentro de uma tarefa.
+ */
+class JobSystem
+{
+public:
+    static const unsigned MAX_THREADS = 16;     ///< Limite de threads, contando a que chama parallelFor().
+    static const unsigned QUEUE_CAPACITY = 256; ///< Tarefas por fila em um parallelFor().
+
+    /**
+     * Retorna a instância única do distribuidor.
+     * @return referência para o JobSystem
+     */
+    static JobSystem& getInstance();
+
+    /**
+     * Cria as threads de trabalho; chamada novamente, recria-as com a nova quantidade.
+     * @param threads - threads que executam as tarefas, contando a que chama parallelFor() (0: uma por núcleo;
+     * 1: tudo na thread que chama, sem threads de trabalho)
+     * @return @a false se alguma thread não puder ser criada (as que faltarem não participam)
+     */
+    bool start(unsigned threads);
+
+    /**
+     * Encerra as threads de trabalho; parallelFor() passa a executar tudo na thread que chama.
+     */
+    void stop();
+
+    /**
+     * @return threads que executam as tarefas, contando a que chama parallelFor()
+     */
+    unsigned threads() const;
+
+    /**
+     * Executa body(i) para todo i em [0, count), em paralelo, e espera o fim de todas as tarefas.
+     * Com uma thread, ou com até @a grain índices, executa em ordem na thread que chama.
+     * @param count - quantidade de índices
+     * @param grain - índices por tarefa (aumentado se as tarefas não couberem nas filas)
+     * @param body - função ou lambda chamada com cada índice
+     */
+    template<typename Body>
+    void parallelFor(unsigned count, unsigned grain, const Body& body)
+    {
+        if(m_thread_count <= 1 || count <= grain)
+        {
+            for(unsigned i = 0; i < count; i++) body(i);
+            return;
+        }
+        run(count, grain, &invoke<Body>, const_cast<Body*>(&body));
+    }
+
+private:
+    typedef void (*JobFunction)(void* context, unsigned begin, unsigned end);
+
+    /**
+     * @brief Tarefa: intervalo de índices e o laço que os processa.
+     */
+    struct Job
+    {
+        JobFunction function;   ///< Executa o corpo do laço no intervalo.
+        void* context;          ///< Corpo do laço.
+        unsigned begin;         ///< Primeiro índice.
+        unsigned end;           ///< Fim do intervalo (exclusivo).
+    };
+
+    /**
+     * @brief Fila de uma thread: o dono retira do fim, os ladrões do início.
+     */
+    struct WorkQueue
+    {
+        SDL_SpinLock lock;              ///< Protege head e tail.
+        unsigned head;                  ///< Próxima tarefa a ser roubada.
+        unsigned tail;                  ///< Fim das tarefas (o dono retira a anterior).
+        Job jobs[QUEUE_CAPACITY];       ///< Tarefas do parallelFor() atual.
+    };
+
+    JobSystem();
+    ~JobSystem();
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    template<typename Body>
+    static void invoke(void* context, unsigned begin, unsigned end)
+    {
+        const Body& body = *static_cast<const Body*>(context);
+        for(unsigned i = begin; i < end; i++) body(i);
+    }
+
+    /**
+     * Reparte as tarefas entre as filas, acorda as threads de trabalho e ajuda até todas terminarem.
+     */
+    void run(unsigned count, unsigned grain, JobFunction function, void* context);
+
+    /**
+     * Retira uma tarefa da própria fila ou rouba de outra.
+     * @param queue - fila da thread
+     * @param job - recebe a tarefa
+     * @return @a false se não houver tarefas em nenhuma fila
+     */
+    bool take(unsigned queue, Job& job);
+
+    /**
+     * Executa uma tarefa e a desconta das pendentes.
+     * @param job - tarefa
+     */
+    void execute(const Job& job);
+
+    /**
+     * Laço das threads de trabalho.
+     * @param data - índice da fila da thread
+     */
+    static int worker(void* data);
+
+    WorkQueue* m_queues;                        ///< Uma fila por thread; a 0 é da thread que chama parallelFor().
+    SDL_Thread* m_workers[MAX_THREADS];         ///< Threads de trabalho (filas 1 em diante).
+    unsigned m_thread_count;                    ///< Threads que executam tarefas, contando a que chama.
+    SDL_sem* m_wake;                            ///< Sinalizado uma vez por thread de trabalho a cada parallelFor().
+    std::atomic<unsigned> m_pending;            ///< Tarefas ainda não concluídas.
+    std::atomic<bool> m_stop;                   ///< Pede o fim das threads de trabalho.
+};
+
+#endif // JOBSYSTEM_H
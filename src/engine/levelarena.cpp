@@ -0,0 +1,129 @@
+#include "levelarena.h"
+#include "memorystats.h"
+
+// Cada objeto é precedido por um cabeçalho (do tamanho do alinhamento) com seu tamanho arredondado,
+// usado por release() para escolher a lista de reaproveitamento
+static std::size_t roundUp(std::size_t size, std::size_t alignment)
+{
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+LevelArena::LevelArena(MemoryTag tag, std::size_t block_size)
+{
+    m_block_size = block_size;
+    m_block = 0;
+    m_offset = 0;
+    m_used = 0;
+    m_live_bytes = 0;
+    m_live_count = 0;
+    m_tag = tag;
+    m_free_list_count = 0;
+}
+
+LevelArena::~LevelArena()
+{
+    reset();
+    for(auto& block : m_blocks) delete[] block.data;
+}
+
+void LevelArena::reset()
+{
+    MemoryStats::released(m_tag, m_live_bytes, m_live_count);
+    m_live_bytes = 0;
+    m_live_count = 0;
+    m_block = 0;
+    m_offset = 0;
+    m_used = 0;
+    m_free_list_count = 0;
+}
+
+void LevelArena::reserve(std::size_t bytes, std::size_t largest)
+{
+    std::size_t block_size = largest * 2 > m_block_size ? largest * 2 : m_block_size;
+    std::size_t available = 0;
+    for(std::size_t block = m_block; block < m_blocks.size(); block++)
+    {
+        std::size_t size = m_blocks[block].size - (block == m_block ? m_offset : 0);
+        if(size > largest) available += size - largest;
+    }
+    while(available < bytes)
+    {
+        m_blocks.push_back(Block{new char[block_size], block_size});
+        available += block_size - largest;
+    }
+}
+
+std::size_t LevelArena::footprint(std::size_t size)
+{
+    return roundUp(size, ALIGNMENT) + ALIGNMENT;
+}
+
+std::size_t LevelArena::used() const
+{
+    return m_used;
+}
+
+std::size_t LevelArena::reserved() const
+{
+    std::size_t total = 0;
+    for(auto& block : m_blocks) total += block.size;
+    return total;
+}
+
+void* LevelArena::allocate(std::size_t size)
+{
+    size = roundUp(size, ALIGNMENT);
+    MemoryStats::allocated(m_tag, size);
+    m_live_bytes += size;
+    m_live_count++;
+
+    for(int i = 0; i < m_free_list_count; i++)
+    {
+        FreeList& list = m_free_lists[i];
+        if(list.size != size || list.head == nullptr) continue;
+        void* memory = list.head;
+        list.head = *static_cast<void**>(memory);
+        return memory;
+    }
+
+    std::size_t needed = size + ALIGNMENT;
+    // Avança para o próximo bloco com espaço (blocos já reservados são reaproveitados após reset())
+    while(m_block < m_blocks.size() && m_offset + needed > m_blocks[m_block].size)
+    {
+        m_block++;
+        m_offset = 0;
+    }
+    if(m_block == m_blocks.size())
+    {
+        std::size_t block_size = needed > m_block_size ? needed : m_block_size;
+        m_blocks.push_back(Block{new char[block_size], block_size});
+        m_offset = 0;
+    }
+
+    char* header = m_blocks[m_block].data + m_offset;
+    *reinterpret_cast<std::size_t*>(header) = size;
+    m_offset += needed;
+    m_used += needed;
+    return header + ALIGNMENT;
+}
+
+void LevelArena::release(void* memory)
+{
+    std::size_t size = *reinterpret_cast<std::size_t*>(static_cast<char*>(memory) - ALIGNMENT);
+    MemoryStats::released(m_tag, size);
+    m_live_bytes -= size;
+    m_live_count--;
+    for(int i = 0; i < m_free_list_count; i++)
+    {
+        FreeList& list = m_free_lists[i];
+        if(list.size != size) continue;
+        *static_cast<void**>(memory) = list.head;
+        list.head = memory;
+        return;
+    }
+    // Tamanhos diferentes são poucos (um por classe); sem lista disponível a memória fica até o reset()
+    if(m_free_list_count == MAX_FREE_LISTS) return;
+    m_free_lists[m_free_list_count] = FreeList{size, memory};
+    *static_cast<void**>(memory) = nullptr;
+    m_free_list_count++;
+}
@@ -0,0 +1,146 @@
+#ifndef LEVELARENA_H
+#define LEVELARENA_H
+
+#include "../type.h"
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief
+ * Alocador monotônico para objetos que vivem enquanto a rodada estiver carregada (tijolos, pedras, água, gelo e arbustos).
+ * Os objetos são criados em blocos grandes com um simples avanço de ponteiro; reset() descarta todos de uma vez em O(1),
+ * sem chamar destrutores, e mantém os blocos para a próxima rodada. Por isso só devem ser criados aqui objetos cujo
+ * destrutor não libera recursos (como @a Object e @a Brick).
+ * Um objeto removido antes do fim da rodada (ex.: tijolo destruído) é devolvido com destroy(); sua memória é reaproveitada
+ * pelo próximo objeto do mesmo tamanho, de modo que trocas repetidas (ex.: paredes da águia) não fazem a arena crescer.
+ * Os objetos vivos são contabilizados em @a MemoryStats na categoria da arena.
+ */
+class LevelArena
+{
+public:
+    /**
+     * @param tag - categoria de memória dos objetos
+     * @param block_size - tamanho de cada bloco em bytes
+     */
+    explicit LevelArena(MemoryTag tag = MT_TERRAIN, std::size_t block_size = 32 * 1024);
+
+    /**
+     * Libera todos os blocos (sem chamar os destrutores dos objetos).
+     */
+    ~LevelArena();
+
+    LevelArena(const LevelArena&) = delete;
+    LevelArena& operator=(const LevelArena&) = delete;
+
+    /**
+     * Cria um objeto na arena.
+     * @param args - argumentos do construtor de @a T
+     * @return objeto criado
+     */
+    template <typename T, typename... Args>
+    T* create(Args&&... args)
+    {
+        return ::new (allocate(sizeof(T))) T(std::forward<Args>(args)...);
+    }
+
+    /**
+     * Destrói um objeto criado por create() e guarda sua memória para reaproveitamento.
+     * @param object - objeto (pode ser ponteiro para a classe base, se ela for polimórfica)
+     */
+    template <typename T>
+    void destroy(T* object)
+    {
+        if(object == nullptr) return;
+        void* memory = mostDerived(object);
+        object->~T();
+        release(memory);
+    }
+
+    /**
+     * Descarta todos os objetos de uma vez. Os blocos continuam reservados para a próxima rodada.
+     */
+    void reset();
+
+    /**
+     * Garante nos blocos espaço livre para @a bytes (soma de footprint() dos objetos), sem contar a memória de objetos
+     * destruídos: create() não aloca memória até esse limite.
+     * @param bytes - espaço livre desejado
+     * @param largest - maior footprint() entre os objetos (a sobra no fim de cada bloco é menor que ele)
+     */
+    void reserve(std::size_t bytes, std::size_t largest);
+
+    /**
+     * @param size - tamanho do objeto
+     * @return bytes ocupados na arena por um objeto de @a size bytes, com cabeçalho e alinhamento
+     */
+    static std::size_t footprint(std::size_t size);
+
+    /**
+     * @return bytes em uso (incluindo cabeçalhos e memória aguardando reaproveitamento)
+     */
+    std::size_t used() const;
+
+    /**
+     * @return bytes reservados em blocos
+     */
+    std::size_t reserved() const;
+
+private:
+    /**
+     * Reserva @a size bytes alinhados, reaproveitando a memória de um objeto destruído do mesmo tamanho, se houver.
+     * @param size - tamanho do objeto
+     * @return memória para o objeto
+     */
+    void* allocate(std::size_t size);
+
+    /**
+     * Guarda a memória de um objeto destruído na lista do seu tamanho.
+     * @param memory - endereço retornado por allocate()
+     */
+    void release(void* memory);
+
+    template <typename T>
+    static void* mostDerived(T* object)
+    {
+        if constexpr(std::is_polymorphic<T>::value) return dynamic_cast<void*>(object);
+        else return object;
+    }
+
+    /**
+     * @brief Lista de memória livre de um tamanho.
+     */
+    struct FreeList
+    {
+        std::size_t size;   ///< Tamanho arredondado dos objetos.
+        void* head;         ///< Primeira posição livre (cada posição guarda o endereço da próxima).
+    };
+
+    /**
+     * @brief Bloco de memória reservado.
+     */
+    struct Block
+    {
+        char* data;         ///< Início do bloco.
+        std::size_t size;   ///< Tamanho em bytes.
+    };
+
+    static const std::size_t ALIGNMENT = alignof(std::max_align_t);
+    static const int MAX_FREE_LISTS = 8;
+
+    std::vector<Block> m_blocks;            ///< Blocos reservados.
+    std::size_t m_block_size;               ///< Tamanho de cada bloco.
+    std::size_t m_block;                    ///< Bloco em uso.
+    std::size_t m_offset;                   ///< Primeiro byte livre do bloco em uso.
+    std::size_t m_used;                     ///< Bytes entregues desde o último reset().
+    std::size_t m_live_bytes;               ///< Bytes dos objetos vivos.
+    std::size_t m_live_count;               ///< Objetos vivos.
+    MemoryTag m_tag;                        ///< Categoria de memória dos objetos.
+    FreeList m_free_lists[MAX_FREE_LISTS];  ///< Memória de objetos destruídos, por tamanho.
+    int m_free_list_count;                  ///< Listas em uso.
+};
+
+#endif // LEVELARENA_H
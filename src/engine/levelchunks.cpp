@@ -0,0 +1,251 @@
+#include "levelchunks.h"
+
+LevelChunks::LevelChunks()
+{
+    m_oldest = m_newest = m_free = -1;
+    m_count = 0;
+    m_chunk_columns = m_chunk_rows = 0;
+}
+
+LevelChunks::~LevelChunks()
+{
+    for(auto chunk : m_slots) delete chunk;
+}
+
+// Todas as posições voltam à lista de livres; o conteúdo é limpo ao serem reaproveitadas
+void LevelChunks::reset(int columns, int rows)
+{
+    for(Entry& entry : m_table) entry.slot = -1;
+    m_count = 0;
+    m_oldest = m_newest = -1;
+    m_free = -1;
+    for(int slot = static_cast<int>(m_slots.size()) - 1; slot >= 0; slot--)
+    {
+        m_slots[slot]->next = m_free;
+        m_free = slot;
+    }
+    m_chunk_columns = (columns + CHUNK_SIZE - 1) >> CHUNK_BITS;
+    m_chunk_rows = (rows + CHUNK_SIZE - 1) >> CHUNK_BITS;
+}
+
+// A tabela fica no máximo meio cheia, para que as sondagens sejam curtas
+void LevelChunks::reserve(unsigned count)
+{
+    while(m_slots.size() < count)
+    {
+        Chunk* chunk = new Chunk;
+        chunk->next = m_free;
+        m_free = static_cast<int>(m_slots.size());
+        m_slots.push_back(chunk);
+    }
+    unsigned size = 16;
+    while(size < count * 2) size *= 2;
+    if(size > m_table.size()) rehash(size);
+}
+
+int LevelChunks::chunkColumns() const
+{
+    return m_chunk_columns;
+}
+
+int LevelChunks::chunkRows() const
+{
+    return m_chunk_rows;
+}
+
+unsigned LevelChunks::size() const
+{
+    return m_count;
+}
+
+LevelChunks::Chunk* LevelChunks::find(Uint32 key) const
+{
+    int entry = lookup(key);
+    return entry >= 0 ? m_slots[m_table[entry].slot] : nullptr;
+}
+
+LevelChunks::Chunk* LevelChunks::insert(Uint32 key, Uint32 used)
+{
+    int slot = m_free;
+    if(slot >= 0)
+        m_free = m_slots[slot]->next;
+    else
+    {
+        slot = static_cast<int>(m_slots.size());
+        m_slots.push_back(new Chunk);
+    }
+
+    Chunk* chunk = m_slots[slot];
+    for(int i = 0; i < CHUNK_CELLS; i++)
+    {
+        chunk->tiles[i] = nullptr;
+        chunk->bushes[i] = nullptr;
+    }
+    chunk->water_count = 0;
+    chunk->key = key;
+    chunk->used = used;
+
+    if((m_count + 1) * 2 > m_table.size()) rehash(m_table.empty() ? 16 : static_cast<unsigned>(m_table.size()) * 2);
+    unsigned mask = m_table.size() - 1;
+    unsigned entry = home(key);
+    while(m_table[entry].slot >= 0) entry = (entry + 1) & mask;
+    m_table[entry].key = key;
+    m_table[entry].slot = slot;
+    m_count++;
+    append(slot);
+    return chunk;
+}
+
+// Remoção com deslocamento para trás: as entradas seguintes que podem ocupar a vaga são puxadas, sem marcas de removido
+void LevelChunks::remove(Chunk* chunk)
+{
+    int found = lookup(chunk->key);
+    if(found < 0) return;
+    int slot = m_table[found].slot;
+    unsigned mask = m_table.size() - 1;
+    unsigned hole = found;
+    for(unsigned entry = (hole + 1) & mask; m_table[entry].slot >= 0; entry = (entry + 1) & mask)
+    {
+        // A entrada fica se sua posição inicial estiver entre a vaga (exclusive) e ela mesma
+        unsigned start = home(m_table[entry].key);
+        bool stays = hole < entry ? start > hole && start <= entry : start > hole || start <= entry;
+        if(stays) continue;
+        m_table[hole] = m_table[entry];
+        hole = entry;
+    }
+    m_table[hole].slot = -1;
+    m_count--;
+
+    unlink(slot);
+    chunk->next = m_free;
+    m_free = slot;
+}
+
+void LevelChunks::touch(Chunk* chunk, Uint32 used)
+{
+    chunk->used = used;
+    if(m_newest >= 0 && m_slots[m_newest] == chunk) return;
+    int slot = m_table[lookup(chunk->key)].slot;
+    unlink(slot);
+    append(slot);
+}
+
+LevelChunks::Chunk* LevelChunks::oldest() const
+{
+    return m_oldest >= 0 ? m_slots[m_oldest] : nullptr;
+}
+
+LevelChunks::Chunk* LevelChunks::newer(const Chunk* chunk) const
+{
+    return chunk->next >= 0 ? m_slots[chunk->next] : nullptr;
+}
+
+Uint32 LevelChunks::key(int chunk_column, int chunk_row)
+{
+    return interleave(chunk_column, chunk_row);
+}
+
+Uint32 LevelChunks::keyOf(int row, int column)
+{
+    return interleave(column >> CHUNK_BITS, row >> CHUNK_BITS);
+}
+
+int LevelChunks::chunkColumn(Uint32 key)
+{
+    return evenBits(key);
+}
+
+int LevelChunks::chunkRow(Uint32 key)
+{
+    return evenBits(key >> 1);
+}
+
+int LevelChunks::cell(int row, int column)
+{
+    return interleave(column & (CHUNK_SIZE - 1), row & (CHUNK_SIZE - 1));
+}
+
+int LevelChunks::cellColumn(int cell)
+{
+    return evenBits(cell);
+}
+
+int LevelChunks::cellRow(int cell)
+{
+    return evenBits(cell >> 1);
+}
+
+// Espalha os 16 bits baixos de cada coordenada (x nos bits pares, y nos ímpares)
+Uint32 LevelChunks::interleave(Uint32 x, Uint32 y)
+{
+    auto spread = [](Uint32 v)
+    {
+        v &= 0xFFFF;
+        v = (v | (v << 8)) & 0x00FF00FF;
+        v = (v | (v << 4)) & 0x0F0F0F0F;
+        v = (v | (v << 2)) & 0x33333333;
+        v = (v | (v << 1)) & 0x55555555;
+        return v;
+    };
+    return spread(x) | (spread(y) << 1);
+}
+
+Uint32 LevelChunks::evenBits(Uint32 code)
+{
+    code &= 0x55555555;
+    code = (code | (code >> 1)) & 0x33333333;
+    code = (code | (code >> 2)) & 0x0F0F0F0F;
+    code = (code | (code >> 4)) & 0x00FF00FF;
+    code = (code | (code >> 8)) & 0x0000FFFF;
+    return code;
+}
+
+unsigned LevelChunks::home(Uint32 key) const
+{
+    Uint32 hash = key * 0x9E3779B1u;
+    return (hash ^ (hash >> 16)) & (m_table.size() - 1);
+}
+
+int LevelChunks::lookup(Uint32 key) const
+{
+    if(m_table.empty()) return -1;
+    unsigned mask = m_table.size() - 1;
+    for(unsigned entry = home(key); m_table[entry].slot >= 0; entry = (entry + 1) & mask)
+        if(m_table[entry].key == key) return static_cast<int>(entry);
+    return -1;
+}
+
+void LevelChunks::rehash(unsigned size)
+{
+    std::vector<Entry> old;
+    old.swap(m_table);
+    m_table.assign(size, Entry{0, -1});
+    unsigned mask = size - 1;
+    for(const Entry& moved : old)
+    {
+        if(moved.slot < 0) continue;
+        unsigned entry = home(moved.key);
+        while(m_table[entry].slot >= 0) entry = (entry + 1) & mask;
+        m_table[entry] = moved;
+    }
+}
+
+void LevelChunks::unlink(int slot)
+{
+    Chunk* chunk = m_slots[slot];
+    if(chunk->prev >= 0) m_slots[chunk->prev]->next = chunk->next;
+    else m_oldest = chunk->next;
+    if(chunk->next >= 0) m_slots[chunk->next]->prev = chunk->prev;
+    else m_newest = chunk->prev;
+    chunk->prev = chunk->next = -1;
+}
+
+void LevelChunks::append(int slot)
+{
+    Chunk* chunk = m_slots[slot];
+    chunk->prev = m_newest;
+    chunk->next = -1;
+    if(m_newest >= 0) m_slots[m_newest]->next = slot;
+    else m_oldest = slot;
+    m_newest = slot;
+}
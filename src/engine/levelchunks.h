@@ -0,0 +1,223 @@
+#ifndef LEVELCHUNKS_H
+#define LEVELCHUNKS_H
+
+#include "memorystats.h"
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+class Object;
+
+/**
+ * @brief
+ * Grade de obstáculos e arbustos da rodada dividida em trechos (chunks) de CHUNK_SIZE x CHUNK_SIZE células.
+ * Dentro do trecho as células ficam em ordem de Morton (curva Z), de modo que vizinhas na horizontal e na vertical
+ * ficam próximas na memória; cada trecho é identificado pelo código de Morton da sua posição (@a key).
+ * Apenas os trechos carregados ocupam memória: uma tabela de endereçamento aberto leva do código à posição do trecho,
+ * e as posições formam uma lista do menos para o mais recentemente usado (LRU), usada para escolher o trecho a descartar.
+ * Com reserve() as posições e a tabela são criadas na carga da rodada, e carregar ou descartar trechos não aloca memória.
+ * A grade guarda apenas ponteiros: criar, destruir e salvar os objetos das células cabe ao dono (@a Game).
+ */
+class LevelChunks
+{
+public:
+    static const int CHUNK_BITS = 4;                        ///< log2 do lado do trecho.
+    static const int CHUNK_SIZE = 1 << CHUNK_BITS;          ///< Lado do trecho em células.
+    static const int CHUNK_CELLS = CHUNK_SIZE * CHUNK_SIZE; ///< Células por trecho.
+
+    /**
+     * @brief Trecho carregado.
+     */
+    struct Chunk
+    {
+        Object* tiles[CHUNK_CELLS];     ///< Obstáculos em ordem de Morton (nullptr se a célula estiver vazia).
+        Object* bushes[CHUNK_CELLS];    ///< Arbustos em ordem de Morton.
+        Uint8 water[CHUNK_CELLS];       ///< Células com água (índices em @a tiles), preenchidas pelo dono.
+        int water_count;                ///< Quantidade de células em @a water.
+        Uint32 key;                     ///< Código de Morton da posição do trecho.
+        Uint32 used;                    ///< Marca do último uso (ver touch()).
+        int prev;                       ///< Posição anterior na lista de uso, ou -1.
+        int next;                       ///< Próxima posição na lista de uso (ou na lista de posições livres), ou -1.
+
+        static void* operator new(std::size_t size)
+        {
+            MemoryStats::allocated(MT_TERRAIN, size);
+            return ::operator new(size);
+        }
+        static void operator delete(void* memory, std::size_t size)
+        {
+            MemoryStats::released(MT_TERRAIN, size);
+            ::operator delete(memory);
+        }
+    };
+
+    LevelChunks();
+
+    /**
+     * Libera as posições (os objetos das células não são destruídos).
+     */
+    ~LevelChunks();
+
+    LevelChunks(const LevelChunks&) = delete;
+    LevelChunks& operator=(const LevelChunks&) = delete;
+
+    /**
+     * Esquece todos os trechos e define o tamanho da rodada. As posições continuam reservadas.
+     * @param columns - colunas de células
+     * @param rows - linhas de células
+     */
+    void reset(int columns, int rows);
+
+    /**
+     * Cria posições e tabela para @a count trechos carregados ao mesmo tempo; acima disso insert() volta a alocar memória.
+     * @param count - quantidade de trechos
+     */
+    void reserve(unsigned count);
+
+    /**
+     * @return quantidade de trechos na horizontal
+     */
+    int chunkColumns() const;
+
+    /**
+     * @return quantidade de trechos na vertical
+     */
+    int chunkRows() const;
+
+    /**
+     * @return quantidade de trechos carregados
+     */
+    unsigned size() const;
+
+    /**
+     * @param key - código do trecho
+     * @return trecho carregado, ou nullptr
+     */
+    Chunk* find(Uint32 key) const;
+
+    /**
+     * Carrega um trecho vazio (todas as células nullptr) como o mais recente.
+     * @param key - código do trecho (não pode estar carregado)
+     * @param used - marca de uso
+     * @return trecho
+     */
+    Chunk* insert(Uint32 key, Uint32 used);
+
+    /**
+     * Descarta o trecho; os objetos das células devem ter sido destruídos.
+     * @param chunk - trecho carregado
+     */
+    void remove(Chunk* chunk);
+
+    /**
+     * Marca o uso do trecho, tornando-o o mais recente.
+     * @param chunk - trecho carregado
+     * @param used - marca de uso
+     */
+    void touch(Chunk* chunk, Uint32 used);
+
+    /**
+     * @return trecho usado há mais tempo, ou nullptr se nenhum estiver carregado
+     */
+    Chunk* oldest() const;
+
+    /**
+     * Percorre os trechos carregados do mais antigo ao mais recente.
+     * @param chunk - trecho carregado
+     * @return próximo trecho, ou nullptr
+     */
+    Chunk* newer(const Chunk* chunk) const;
+
+    /**
+     * @param chunk_column - coluna do trecho
+     * @param chunk_row - linha do trecho
+     * @return código de Morton do trecho
+     */
+    static Uint32 key(int chunk_column, int chunk_row);
+
+    /**
+     * @return código do trecho que contém a célula
+     */
+    static Uint32 keyOf(int row, int column);
+
+    /**
+     * @return coluna do trecho de código @a key
+     */
+    static int chunkColumn(Uint32 key);
+
+    /**
+     * @return linha do trecho de código @a key
+     */
+    static int chunkRow(Uint32 key);
+
+    /**
+     * @return índice da célula dentro do seu trecho (ordem de Morton)
+     */
+    static int cell(int row, int column);
+
+    /**
+     * @return coluna, dentro do trecho, da célula de índice @a cell
+     */
+    static int cellColumn(int cell);
+
+    /**
+     * @return linha, dentro do trecho, da célula de índice @a cell
+     */
+    static int cellRow(int cell);
+
+private:
+    /**
+     * Intercala os bits de @a x (posições pares) e @a y (posições ímpares).
+     */
+    static Uint32 interleave(Uint32 x, Uint32 y);
+
+    /**
+     * Separa os bits pares de @a code.
+     */
+    static Uint32 evenBits(Uint32 code);
+
+    /**
+     * @brief Entrada da tabela de códigos.
+     */
+    struct Entry
+    {
+        Uint32 key;     ///< Código do trecho.
+        int slot;       ///< Posição do trecho, ou -1 se a entrada estiver vazia.
+    };
+
+    /**
+     * @return entrada inicial da busca por @a key na tabela
+     */
+    unsigned home(Uint32 key) const;
+
+    /**
+     * @return índice da entrada de @a key na tabela, ou -1
+     */
+    int lookup(Uint32 key) const;
+
+    /**
+     * Refaz a tabela com @a size entradas (potência de 2), mantendo os trechos carregados.
+     */
+    void rehash(unsigned size);
+
+    /**
+     * Remove a posição da lista de uso.
+     */
+    void unlink(int slot);
+
+    /**
+     * Insere a posição no fim (mais recente) da lista de uso.
+     */
+    void append(int slot);
+
+    std::vector<Chunk*> m_slots;                ///< Posições (carregadas e livres); nunca mudam de endereço.
+    std::vector<Entry> m_table;                 ///< Código do trecho carregado -> posição (sondagem linear).
+    unsigned m_count;                           ///< Trechos carregados.
+    int m_oldest;                               ///< Primeira posição da lista de uso, ou -1.
+    int m_newest;                               ///< Última posição da lista de uso, ou -1.
+    int m_free;                                 ///< Primeira posição livre, ou -1.
+    int m_chunk_columns;                        ///< Trechos na horizontal.
+    int m_chunk_rows;                           ///< Trechos na vertical.
+};
+
+#endif // LEVELCHUNKS_H
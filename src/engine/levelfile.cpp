@@ -0,0 +1,181 @@
+#include "levelfile.h"
+#include "levelchunks.h"
+
+#include <cstring>
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+LevelFile::LevelFile()
+{
+    m_data = nullptr;
+    m_size = 0;
+    m_columns = 0;
+}
+
+LevelFile::~LevelFile()
+{
+    close();
+}
+
+bool LevelFile::open(const std::string& path)
+{
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if(file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER size;
+    if(!GetFileSizeEx(file, &size))
+    {
+        CloseHandle(file);
+        return false;
+    }
+    if(size.QuadPart > 0)
+    {
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if(mapping != nullptr)
+        {
+            m_data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            CloseHandle(mapping); // a vista continua válida até UnmapViewOfFile
+        }
+        if(m_data == nullptr)
+        {
+            CloseHandle(file);
+            return false;
+        }
+        m_size = static_cast<std::size_t>(size.QuadPart);
+    }
+    CloseHandle(file);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if(fd < 0) return false;
+    struct stat info;
+    if(fstat(fd, &info) != 0)
+    {
+        ::close(fd);
+        return false;
+    }
+    if(info.st_size > 0)
+    {
+        void* data = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(data == MAP_FAILED)
+        {
+            ::close(fd);
+            return false;
+        }
+        m_data = static_cast<const char*>(data);
+        m_size = info.st_size;
+    }
+    ::close(fd); // o mapeamento continua válido até munmap
+#endif
+
+    // Localiza as linhas; a última só conta se tiver conteúdo (arquivo terminado ou não em '\n')
+    std::size_t start = 0;
+    while(start < m_size)
+    {
+        const char* end = static_cast<const char*>(std::memchr(m_data + start, '\n', m_size - start));
+        std::size_t next = end != nullptr ? end - m_data : m_size;
+        std::size_t length = next - start;
+        if(length > 0 && m_data[next - 1] == '\r') length--;
+        m_lines.push_back({start, static_cast<int>(length)});
+        if(static_cast<int>(length) > m_columns) m_columns = length;
+        start = next + 1;
+    }
+    return true;
+}
+
+void LevelFile::close()
+{
+    if(m_data != nullptr)
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(m_data);
+#else
+        munmap(const_cast<char*>(m_data), m_size);
+#endif
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_lines.clear();
+    m_columns = 0;
+}
+
+void LevelFile::swap(LevelFile& other)
+{
+    std::swap(m_data, other.m_data);
+    std::swap(m_size, other.m_size);
+    m_lines.swap(other.m_lines);
+    std::swap(m_columns, other.m_columns);
+}
+
+int LevelFile::rows() const
+{
+    return m_lines.size();
+}
+
+int LevelFile::columns() const
+{
+    return m_columns;
+}
+
+char LevelFile::cell(int row, int column) const
+{
+    if(row < 0 || row >= static_cast<int>(m_lines.size()) || column < 0) return '.';
+    const Line& line = m_lines[row];
+    return column < line.length ? m_data[line.start + column] : '.';
+}
+
+void LevelFile::readChunk(Uint32 key, char* cells) const
+{
+    int row = LevelChunks::chunkRow(key) * LevelChunks::CHUNK_SIZE;
+    int column = LevelChunks::chunkColumn(key) * LevelChunks::CHUNK_SIZE;
+    for(int i = 0; i < LevelChunks::CHUNK_CELLS; i++)
+        cells[i] = cell(row + LevelChunks::cellRow(i), column + LevelChunks::cellColumn(i));
+}
+
+// Os trechos de uma faixa de CHUNK_SIZE linhas são contados juntos e fechados ao fim da faixa
+LevelFile::ChunkCounts LevelFile::countChunks() const
+{
+    ChunkCounts counts = {0, 0, 0, 0};
+    int chunk_columns = (m_columns + LevelChunks::CHUNK_SIZE - 1) >> LevelChunks::CHUNK_BITS;
+    std::vector<unsigned> bricks(chunk_columns, 0), objects(chunk_columns, 0);
+    int rows = m_lines.size();
+    for(int row = 0; row < rows; row++)
+    {
+        const char* cells = m_data + m_lines[row].start;
+        for(int column = 0; column < m_lines[row].length; column++)
+        {
+            int chunk = column >> LevelChunks::CHUNK_BITS;
+            switch(cells[column])
+            {
+            case '#': bricks[chunk]++; counts.bricks++; break;
+            case '@': case '-': case '%': objects[chunk]++; counts.objects++; break;
+            case '~': objects[chunk]++; break;
+            }
+        }
+        if((row & (LevelChunks::CHUNK_SIZE - 1)) != LevelChunks::CHUNK_SIZE - 1 && row != rows - 1) continue;
+        for(int chunk = 0; chunk < chunk_columns; chunk++)
+        {
+            if(bricks[chunk] > counts.max_bricks) counts.max_bricks = bricks[chunk];
+            if(objects[chunk] > counts.max_objects) counts.max_objects = objects[chunk];
+            bricks[chunk] = 0;
+            objects[chunk] = 0;
+        }
+    }
+    return counts;
+}
+
+bool LevelFile::solid(char cell)
+{
+    return cell == '#' || cell == '@' || cell == '~';
+}
@@ -0,0 +1,110 @@
+#ifndef LEVELFILE_H
+#define LEVELFILE_H
+
+#include <SDL2/SDL.h>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @brief
+ * Arquivo de rodada em texto (uma linha por fileira de células) mapeado em memória, somente leitura.
+ * Abrir apenas localiza o início de cada linha; as células são lidas sob demanda, um trecho de @a LevelChunks
+ * por vez, e o sistema operacional carrega e descarta as páginas do arquivo conforme o uso.
+ * Depois de aberto pode ser lido por várias threads ao mesmo tempo (ex.: pelo @a ChunkStreamer).
+ */
+class LevelFile
+{
+public:
+    /**
+     * @brief Objetos do cenário por trecho de @a LevelChunks, usados para reservar a memória dos trechos.
+     */
+    struct ChunkCounts
+    {
+        unsigned bricks;        ///< Tijolos da rodada.
+        unsigned objects;       ///< Pedras, gelo e arbustos da rodada (a água não tem estado salvo).
+        unsigned max_bricks;    ///< Mais tijolos num trecho.
+        unsigned max_objects;   ///< Mais pedras, gelo, arbustos e água num trecho.
+    };
+
+    LevelFile();
+
+    /**
+     * Fecha o arquivo.
+     */
+    ~LevelFile();
+
+    LevelFile(const LevelFile&) = delete;
+    LevelFile& operator=(const LevelFile&) = delete;
+
+    /**
+     * Mapeia o arquivo e localiza as linhas. Finais de linha "\r\n" são aceitos e uma linha vazia no fim é ignorada.
+     * @param path - caminho do arquivo
+     * @return @a false se o arquivo não puder ser aberto
+     */
+    bool open(const std::string& path);
+
+    /**
+     * Desfaz o mapeamento.
+     */
+    void close();
+
+    /**
+     * Troca o conteúdo com outro arquivo (usado para receber uma rodada aberta em outra thread).
+     * @param other - outro arquivo
+     */
+    void swap(LevelFile& other);
+
+    /**
+     * @return quantidade de linhas
+     */
+    int rows() const;
+
+    /**
+     * @return tamanho da maior linha
+     */
+    int columns() const;
+
+    /**
+     * @param row - linha
+     * @param column - coluna
+     * @return caractere da célula, ou '.' (vazio) fora do arquivo e além do fim de linhas curtas
+     */
+    char cell(int row, int column) const;
+
+    /**
+     * Lê as células de um trecho.
+     * @param key - código do trecho (@a LevelChunks::key)
+     * @param cells - recebe LevelChunks::CHUNK_CELLS caracteres em ordem de Morton
+     */
+    void readChunk(Uint32 key, char* cells) const;
+
+    /**
+     * Conta os objetos do cenário de todos os trechos, percorrendo o arquivo linha a linha.
+     * @return contagens da rodada e do trecho mais cheio
+     */
+    ChunkCounts countChunks() const;
+
+    /**
+     * @param cell - caractere de uma célula
+     * @return @a true para tijolo, pedra e água, onde nada pode surgir (gelo e arbustos não impedem)
+     */
+    static bool solid(char cell);
+
+private:
+    /**
+     * @brief Posição de uma linha no arquivo.
+     */
+    struct Line
+    {
+        std::size_t start;  ///< Primeiro caractere.
+        int length;         ///< Caracteres sem o final de linha.
+    };
+
+    const char* m_data;         ///< Conteúdo mapeado (nullptr se fechado ou vazio).
+    std::size_t m_size;         ///< Tamanho do arquivo.
+    std::vector<Line> m_lines;  ///< Linhas do arquivo.
+    int m_columns;              ///< Tamanho da maior linha.
+};
+
+#endif // LEVELFILE_H
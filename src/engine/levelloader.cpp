@@ -0,0 +1,95 @@
+#include "levelloader.h"
+#include "levelchunks.h"
+#include "../appconfig.h"
+
+LevelLoader::LevelLoader()
+{
+    m_max_chunks = 0;
+    m_chunk_counts = {0, 0, 0, 0};
+    m_opened = false;
+    m_thread = nullptr;
+}
+
+LevelLoader::~LevelLoader()
+{
+    cancel();
+}
+
+bool LevelLoader::prepare(const std::string& path, unsigned max_chunks)
+{
+    cancel();
+    m_path = path;
+    m_max_chunks = max_chunks;
+    m_opened = false;
+    m_thread = SDL_CreateThread(run, "level", this);
+    return m_thread != nullptr;
+}
+
+bool LevelLoader::take(const std::string& path, LevelFile& file, std::vector<char>& cells, FreeCellIndex& spawn_cells,
+                       LevelFile::ChunkCounts& chunk_counts)
+{
+    // A espera sincroniza com a thread de trabalho: depois dela o arquivo, as células e os blocos são só da thread do jogo
+    wait();
+    if(!m_opened || path != m_path)
+    {
+        m_file.close();
+        m_opened = false;
+        return false;
+    }
+
+    file.swap(m_file);
+    cells.swap(m_cells);
+    spawn_cells.swap(m_spawn_cells);
+    chunk_counts = m_chunk_counts;
+    m_file.close();
+    m_opened = false;
+    return true;
+}
+
+void LevelLoader::wait()
+{
+    if(m_thread == nullptr) return;
+    SDL_WaitThread(m_thread, nullptr);
+    m_thread = nullptr;
+}
+
+void LevelLoader::cancel()
+{
+    wait();
+    m_file.close();
+    m_opened = false;
+}
+
+// Mesma ordem de trechos de Game::loadLevel; os blocos livres seguem Game::cellBlocked para uma rodada sem modificações
+int LevelLoader::run(void* data)
+{
+    LevelLoader* loader = static_cast<LevelLoader*>(data);
+    loader->m_cells.clear();
+    loader->m_opened = loader->m_file.open(loader->m_path);
+    if(!loader->m_opened) return 0;
+
+    const LevelFile& file = loader->m_file;
+    int rows = file.rows();
+    int eagle_column = AppConfig::eagleColumn(file.columns());
+    loader->m_spawn_cells.buildBlocks(file.columns(), rows, [&file, rows, eagle_column](int row, int column)
+    {
+        if(row >= rows - 2 && column >= eagle_column && column < eagle_column + 2) return true;
+        return LevelFile::solid(file.cell(row, column));
+    }, loader->m_row_above, loader->m_row_current);
+    loader->m_chunk_counts = file.countChunks();
+
+    int chunk_columns = (loader->m_file.columns() + LevelChunks::CHUNK_SIZE - 1) >> LevelChunks::CHUNK_BITS;
+    int chunk_rows = (loader->m_file.rows() + LevelChunks::CHUNK_SIZE - 1) >> LevelChunks::CHUNK_BITS;
+    unsigned chunk_count = chunk_columns * chunk_rows;
+    if(chunk_count > loader->m_max_chunks) return 0; // rodada lida por partes: basta o arquivo mapeado
+
+    loader->m_cells.resize(chunk_count * LevelChunks::CHUNK_CELLS);
+    char* cells = loader->m_cells.data();
+    for(int y = 0; y < chunk_rows; y++)
+        for(int x = 0; x < chunk_columns; x++)
+        {
+            loader->m_file.readChunk(LevelChunks::key(x, y), cells);
+            cells += LevelChunks::CHUNK_CELLS;
+        }
+    return 0;
+}
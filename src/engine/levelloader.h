@@ -0,0 +1,88 @@
+#ifndef LEVELLOADER_H
+#define LEVELLOADER_H
+
+#include "levelfile.h"
+#include "freecellindex.h"
+
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+
+/**
+ * @brief
+ * Prepara a próxima rodada em uma thread de trabalho enquanto a tela de pontuação é exibida: mapeia o arquivo,
+ * localiza as linhas, monta os blocos livres onde inimigos e bônus podem surgir (@a Game::m_spawn_cells) e, se a
+ * rodada for carregada por inteiro, lê as células de todos os trechos (as faltas de página acontecem na thread de
+ * trabalho). Também conta os objetos do cenário por trecho (@a LevelFile::countChunks), com que a rodada reserva a
+ * memória dos trechos. A thread do jogo recolhe o resultado com take(), que troca o arquivo, as células e os blocos
+ * de uma vez.
+ *
+ * Os objetos do terreno continuam sendo criados na thread do jogo: a arena e os trechos do @a Game ainda guardam a
+ * rodada atual durante o placar e só são esvaziados quando a próxima começa (@a Game::continueLevel). Esse custo é
+ * medido por "Carregar rodada preparada" em --benchmark.
+ * Apenas a thread do jogo chama os métodos públicos.
+ */
+class LevelLoader
+{
+public:
+    LevelLoader();
+
+    /**
+     * Espera a thread de trabalho e descarta a preparação não recolhida.
+     */
+    ~LevelLoader();
+
+    LevelLoader(const LevelLoader&) = delete;
+    LevelLoader& operator=(const LevelLoader&) = delete;
+
+    /**
+     * Inicia a preparação de uma rodada; uma preparação anterior não recolhida é descartada.
+     * @param path - caminho do arquivo da rodada
+     * @param max_chunks - rodadas com até essa quantidade de trechos têm as células lidas por inteiro
+     * @return @a false se a thread não puder ser criada (a rodada é carregada normalmente em take())
+     */
+    bool prepare(const std::string& path, unsigned max_chunks);
+
+    /**
+     * Recolhe a rodada preparada, esperando a thread de trabalho se ainda não terminou.
+     * @param path - arquivo pedido; uma preparação de outro arquivo é descartada
+     * @param file - recebe o arquivo aberto (o que estava aberto nele é fechado)
+     * @param cells - recebe as células de todos os trechos, linha a linha de trechos e cada trecho em ordem de Morton;
+     * vazio se a rodada for lida por partes
+     * @param spawn_cells - recebe os blocos de 2x2 células sem tijolo, pedra ou água, fora do espaço da águia
+     * (ver @a FreeCellIndex::buildBlocks), da rodada sem modificações
+     * @param chunk_counts - recebe os objetos do cenário por trecho
+     * @return @a false se não houver preparação desse arquivo ou se ele não pôde ser aberto (nada é recebido)
+     */
+    bool take(const std::string& path, LevelFile& file, std::vector<char>& cells, FreeCellIndex& spawn_cells,
+              LevelFile::ChunkCounts& chunk_counts);
+
+    /**
+     * Espera a thread de trabalho terminar, sem recolher a preparação (o benchmark mede take() sem a espera).
+     */
+    void wait();
+
+    /**
+     * Espera a thread de trabalho e descarta a preparação.
+     */
+    void cancel();
+
+private:
+    /**
+     * Trabalho da thread: abre o arquivo, monta os blocos livres, conta os objetos e lê as células.
+     */
+    static int run(void* data);
+
+    std::string m_path;             ///< Arquivo em preparação.
+    unsigned m_max_chunks;          ///< Limite de trechos para ler as células.
+    LevelFile m_file;               ///< Arquivo aberto pela thread de trabalho.
+    std::vector<char> m_cells;      ///< Células lidas pela thread de trabalho.
+    FreeCellIndex m_spawn_cells;    ///< Blocos livres montados pela thread de trabalho.
+    LevelFile::ChunkCounts m_chunk_counts; ///< Objetos por trecho contados pela thread de trabalho.
+    std::vector<bool> m_row_above;  ///< Linha anterior na montagem dos blocos livres.
+    std::vector<bool> m_row_current; ///< Linha atual na montagem dos blocos livres.
+    bool m_opened;                  ///< Arquivo aberto com sucesso.
+    SDL_Thread* m_thread;           ///< Thread de trabalho, ou nullptr.
+};
+
+#endif // LEVELLOADER_H
@@ -0,0 +1,147 @@
+#include "memorystats.h"
+
+#include <csignal>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+/**
+ * @brief Números de uma categoria.
+ */
+struct TagStats
+{
+    Uint64 live_bytes;
+    Uint64 live_count;
+    Uint64 peak_bytes;
+    Uint64 allocations;
+};
+
+static TagStats s_stats[MT_COUNT] = {};
+static Uint64 s_baseline[MT_COUNT] = {};
+static unsigned s_leaks = 0;
+static volatile std::sig_atomic_t s_dump_requested = 0;
+
+static const char* const TAG_NAMES[MT_COUNT] =
+{
+    "terreno", "tanques", "projeteis", "bonus", "texturas", "fontes", "sons", "textos"
+};
+
+// Categorias de objetos que pertencem a uma partida (as demais são recursos carregados uma vez)
+static bool isGameObject(int tag)
+{
+    return tag == MT_TERRAIN || tag == MT_TANKS || tag == MT_BULLETS || tag == MT_BONUSES;
+}
+
+void MemoryStats::allocated(MemoryTag tag, std::size_t bytes, std::size_t count)
+{
+    TagStats& stats = s_stats[tag];
+    stats.live_bytes += bytes;
+    stats.live_count += count;
+    stats.allocations += count;
+    if(stats.live_bytes > stats.peak_bytes) stats.peak_bytes = stats.live_bytes;
+}
+
+void MemoryStats::released(MemoryTag tag, std::size_t bytes, std::size_t count)
+{
+    TagStats& stats = s_stats[tag];
+    stats.live_bytes = bytes < stats.live_bytes ? stats.live_bytes - bytes : 0;
+    stats.live_count = count < stats.live_count ? stats.live_count - count : 0;
+}
+
+Uint64 MemoryStats::liveBytes(MemoryTag tag)
+{
+    return s_stats[tag].live_bytes;
+}
+
+Uint64 MemoryStats::liveCount(MemoryTag tag)
+{
+    return s_stats[tag].live_count;
+}
+
+Uint64 MemoryStats::peakBytes(MemoryTag tag)
+{
+    return s_stats[tag].peak_bytes;
+}
+
+Uint64 MemoryStats::allocations(MemoryTag tag)
+{
+    return s_stats[tag].allocations;
+}
+
+const char* MemoryStats::name(MemoryTag tag)
+{
+    return TAG_NAMES[tag];
+}
+
+void MemoryStats::formatLine(MemoryTag tag, char* buffer, std::size_t size)
+{
+    const TagStats& stats = s_stats[tag];
+    std::snprintf(buffer, size, "%-9s %7.1fK %7.1fK", TAG_NAMES[tag], stats.live_bytes / 1024.0, stats.peak_bytes / 1024.0);
+}
+
+void MemoryStats::markBaseline()
+{
+    for(int i = 0; i < MT_COUNT; i++) s_baseline[i] = s_stats[i].live_count;
+}
+
+bool MemoryStats::checkLeaks(const char* where, bool expect_empty)
+{
+    bool ok = true;
+    for(int i = 0; i < MT_COUNT; i++)
+    {
+        if(!isGameObject(i)) continue;
+        Uint64 expected = expect_empty ? 0 : s_baseline[i];
+        if(s_stats[i].live_count <= expected) continue;
+        std::cerr << "Memoria: vazamento em " << TAG_NAMES[i] << " (" << where << "): "
+                  << s_stats[i].live_count - expected << " objetos a mais que o esperado, "
+                  << s_stats[i].live_bytes << " bytes vivos\n";
+        s_leaks++;
+        ok = false;
+    }
+    return ok;
+}
+
+unsigned MemoryStats::leaks()
+{
+    return s_leaks;
+}
+
+bool MemoryStats::writeJson(const std::string& path)
+{
+    std::ofstream file(path);
+    if(!file)
+    {
+        std::cerr << "Memoria: nao foi possivel gravar " << path << "\n";
+        return false;
+    }
+
+    file << "{\n  \"categorias\": {\n";
+    for(int i = 0; i < MT_COUNT; i++)
+    {
+        const TagStats& stats = s_stats[i];
+        file << "    \"" << TAG_NAMES[i] << "\": {\"bytes\": " << stats.live_bytes << ", \"objetos\": " << stats.live_count
+             << ", \"pico_bytes\": " << stats.peak_bytes << ", \"alocacoes\": " << stats.allocations << "}"
+             << (i + 1 < MT_COUNT ? ",\n" : "\n");
+    }
+    file << "  },\n  \"vazamentos\": " << s_leaks << "\n}\n";
+
+    if(!file)
+    {
+        std::cerr << "Memoria: nao foi possivel gravar " << path << "\n";
+        return false;
+    }
+    std::cout << "Memoria: relatorio gravado em " << path << "\n";
+    return true;
+}
+
+void MemoryStats::requestDump()
+{
+    s_dump_requested = 1;
+}
+
+bool MemoryStats::dumpRequested()
+{
+    if(!s_dump_requested) return false;
+    s_dump_requested = 0;
+    return true;
+}
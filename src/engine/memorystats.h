@@ -0,0 +1,113 @@
+#ifndef MEMORYSTATS_H
+#define MEMORYSTATS_H
+
+#include "../type.h"
+
+#include <SDL2/SDL.h>
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief
+ * Contabilidade de memória por categoria (@a MemoryTag): bytes e objetos vivos, total de alocações e pico de bytes.
+ * Os subsistemas registram o que alocam e liberam (operadores new/delete dos objetos, arena da rodada, texturas,
+ * fontes e sons); os números aparecem no painel de depuração da partida (tecla M) e podem ser gravados em JSON.
+ * Também aponta vazamentos: objetos do jogo que continuam vivos quando a partida termina e o menu volta.
+ * Usada apenas na thread principal.
+ */
+class MemoryStats
+{
+public:
+    /**
+     * Registra uma alocação.
+     * @param tag - categoria
+     * @param bytes - tamanho em bytes
+     * @param count - quantidade de objetos
+     */
+    static void allocated(MemoryTag tag, std::size_t bytes, std::size_t count = 1);
+
+    /**
+     * Registra uma liberação.
+     * @param tag - categoria
+     * @param bytes - tamanho em bytes
+     * @param count - quantidade de objetos
+     */
+    static void released(MemoryTag tag, std::size_t bytes, std::size_t count = 1);
+
+    /**
+     * @param tag - categoria
+     * @return bytes vivos
+     */
+    static Uint64 liveBytes(MemoryTag tag);
+
+    /**
+     * @param tag - categoria
+     * @return objetos vivos
+     */
+    static Uint64 liveCount(MemoryTag tag);
+
+    /**
+     * @param tag - categoria
+     * @return maior quantidade de bytes vivos ao mesmo tempo
+     */
+    static Uint64 peakBytes(MemoryTag tag);
+
+    /**
+     * @param tag - categoria
+     * @return total de alocações desde o início do programa
+     */
+    static Uint64 allocations(MemoryTag tag);
+
+    /**
+     * @param tag - categoria
+     * @return nome da categoria (usado no painel e no JSON)
+     */
+    static const char* name(MemoryTag tag);
+
+    /**
+     * Escreve uma linha do painel de depuração ("nome  vivos  pico", em KB).
+     * @param tag - categoria
+     * @param buffer - destino
+     * @param size - tamanho do destino
+     */
+    static void formatLine(MemoryTag tag, char* buffer, std::size_t size);
+
+    /**
+     * Guarda a quantidade de objetos do jogo (terreno, tanques, projéteis e bônus) vivos no menu, sem partida,
+     * como referência para checkLeaks().
+     */
+    static void markBaseline();
+
+    /**
+     * Procura objetos do jogo que sobreviveram ao fim da partida e informa cada categoria com sobra.
+     * @param where - momento da verificação (exibido na mensagem)
+     * @param expect_empty - @a true se nenhum objeto do jogo deveria existir (fim do programa); caso contrário
+     * compara com markBaseline()
+     * @return @a true se não houver vazamento
+     */
+    static bool checkLeaks(const char* where, bool expect_empty = false);
+
+    /**
+     * @return quantidade de vazamentos encontrados por checkLeaks()
+     */
+    static unsigned leaks();
+
+    /**
+     * Grava os números de todas as categorias em JSON.
+     * @param path - caminho do arquivo
+     * @return @a true se o arquivo foi gravado
+     */
+    static bool writeJson(const std::string& path);
+
+    /**
+     * Pede a gravação do relatório; pode ser chamada de um tratador de sinal.
+     */
+    static void requestDump();
+
+    /**
+     * @return @a true se requestDump() foi chamada desde a última consulta
+     */
+    static bool dumpRequested();
+};
+
+#endif // MEMORYSTATS_H
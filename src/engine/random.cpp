@@ -0,0 +1,56 @@
+#include "random.h"
+
+// Retorna a instância única do gerador
+Random& Random::getInstance()
+{
+    static Random instance;
+    return instance;
+}
+
+// Construtor: semente fixa até que seed() seja chamada
+Random::Random()
+{
+    seed(0);
+}
+
+// Espalha os bits da semente (splitmix64) para evitar estados iniciais fracos
+void Random::seed(Uint64 seed)
+{
+    Uint64 z = seed + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z = z ^ (z >> 31);
+    m_state = z != 0 ? z : 0x9E3779B97F4A7C15ULL;
+}
+
+// Avança o xorshift64* e retorna os 32 bits mais significativos
+Uint32 Random::next()
+{
+    m_state ^= m_state >> 12;
+    m_state ^= m_state << 25;
+    m_state ^= m_state >> 27;
+    return static_cast<Uint32>((m_state * 0x2545F4914F6CDD1DULL) >> 32);
+}
+
+// Inteiro em [0, max)
+int Random::nextInt(int max)
+{
+    if(max <= 0) return 0;
+    return static_cast<int>(next() % static_cast<Uint32>(max));
+}
+
+// Real em [0, 1]
+float Random::nextFloat()
+{
+    return static_cast<float>(next() >> 8) / static_cast<float>(0xFFFFFF);
+}
+
+Uint64 Random::state() const
+{
+    return m_state;
+}
+
+void Random::setState(Uint64 state)
+{
+    m_state = state != 0 ? state : 0x9E3779B97F4A7C15ULL;
+}
@@ -0,0 +1,67 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <SDL2/SDL.h>
+
+/**
+ * @brief
+ * Gerador de números pseudoaleatórios da simulação (xorshift64*).
+ * Substitui rand()/srand(): o estado é um único inteiro de 64 bits, o que permite
+ * salvá-lo e restaurá-lo junto com o estado do jogo e reproduzir partidas de forma determinística.
+ */
+class Random
+{
+public:
+    /**
+     * Retorna a instância única do gerador usada pela simulação (Singleton).
+     * @return referência para o gerador
+     */
+    static Random& getInstance();
+
+    /**
+     * Reinicia o gerador a partir de uma semente.
+     * @param seed - semente (qualquer valor, inclusive 0)
+     */
+    void seed(Uint64 seed);
+
+    /**
+     * Gera o próximo valor de 32 bits.
+     * @return valor pseudoaleatório
+     */
+    Uint32 next();
+
+    /**
+     * Gera um inteiro no intervalo [0, max), equivalente a rand() % max.
+     * @param max - limite superior (exclusivo); valores <= 0 retornam 0
+     * @return valor pseudoaleatório
+     */
+    int nextInt(int max);
+
+    /**
+     * Gera um número real no intervalo [0, 1], equivalente a rand() / RAND_MAX.
+     * @return valor pseudoaleatório
+     */
+    float nextFloat();
+
+    /**
+     * Retorna o estado interno do gerador.
+     * @return estado atual
+     */
+    Uint64 state() const;
+
+    /**
+     * Restaura um estado obtido com state().
+     * @param state - estado a restaurar
+     */
+    void setState(Uint64 state);
+
+private:
+    Random();
+
+    /**
+     * Estado do xorshift64* (nunca zero).
+     */
+    Uint64 m_state;
+};
+
+#endif // RANDOM_H
@@ -0,0 +1,98 @@
+#ifndef RECYCLINGALLOCATOR_H
+#define RECYCLINGALLOCATOR_H
+
+#include <cstddef>
+#include <new>
+
+/**
+ * @brief
+ * Memória reaproveitável para objetos de um tipo criados e destruídos durante a partida (projéteis, inimigos, bônus).
+ * Usada pelos operadores new/delete da classe: a memória de um objeto apagado volta para uma lista livre e é entregue
+ * ao próximo objeto do mesmo tipo, sem passar pelo alocador global. reserve() prepara a lista no carregamento da rodada,
+ * de modo que os frames da partida não alocam memória. Pedidos de outro tamanho (classes derivadas que não definem
+ * seus próprios operadores) usam o alocador global. A memória nunca é devolvida ao sistema; não é segura entre threads.
+ * @tparam T - tipo dos objetos
+ */
+template <typename T>
+class RecyclingAllocator
+{
+public:
+    /**
+     * @param size - tamanho pedido ao operador new
+     * @return memória para um objeto
+     */
+    static void* allocate(std::size_t size)
+    {
+        if(size != sizeof(T)) return ::operator new(size);
+        State& s = state();
+        if(s.free == nullptr) grow(s, s.capacity > 0 ? s.capacity : 8);
+        void* memory = s.free;
+        s.free = *static_cast<void**>(memory);
+        s.available--;
+        return memory;
+    }
+
+    /**
+     * @param memory - memória entregue por allocate()
+     * @param size - tamanho recebido pelo operador delete
+     */
+    static void release(void* memory, std::size_t size)
+    {
+        if(memory == nullptr) return;
+        if(size != sizeof(T))
+        {
+            ::operator delete(memory);
+            return;
+        }
+        State& s = state();
+        *static_cast<void**>(memory) = s.free;
+        s.free = memory;
+        s.available++;
+    }
+
+    /**
+     * Garante que @a count objetos possam ser criados sem alocar memória.
+     * @param count - quantidade de objetos
+     */
+    static void reserve(std::size_t count)
+    {
+        State& s = state();
+        if(s.available < count) grow(s, count - s.available);
+    }
+
+private:
+    /**
+     * @brief Lista livre do tipo (cada posição livre guarda o endereço da próxima).
+     */
+    struct State
+    {
+        void* free;             ///< Primeira posição livre.
+        std::size_t available;  ///< Posições livres.
+        std::size_t capacity;   ///< Posições criadas.
+    };
+
+    static State& state()
+    {
+        static State s = {nullptr, 0, 0};
+        return s;
+    }
+
+    // Reserva um bloco com @a count posições e as coloca na lista livre
+    static void grow(State& s, std::size_t count)
+    {
+        const std::size_t align = alignof(T) > alignof(void*) ? alignof(T) : alignof(void*);
+        const std::size_t size = sizeof(T) > sizeof(void*) ? sizeof(T) : sizeof(void*);
+        const std::size_t stride = (size + align - 1) / align * align;
+        char* block = static_cast<char*>(::operator new(stride * count));
+        for(std::size_t i = 0; i < count; i++)
+        {
+            void* memory = block + i * stride;
+            *static_cast<void**>(memory) = s.free;
+            s.free = memory;
+        }
+        s.available += count;
+        s.capacity += count;
+    }
+};
+
+#endif // RECYCLINGALLOCATOR_H
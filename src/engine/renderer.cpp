@@ -1,8 +1,50 @@
 #include "renderer.h"
 #include "../appconfig.h"
+#include "memorystats.h"
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_image.h>
 #include <iostream>
+#include <cstring>
+
+// Bytes ocupados pelos pixels de uma textura
+static std::size_t textureBytes(SDL_Texture* texture)
+{
+    Uint32 format;
+    int w, h;
+    if(texture == nullptr || SDL_QueryTexture(texture, &format, nullptr, &w, &h) != 0) return 0;
+    return static_cast<std::size_t>(w) * h * SDL_BYTESPERPIXEL(format);
+}
+
+// Abre uma fonte e a contabiliza pelo tamanho do arquivo (a memória usada pela biblioteca não é visível)
+static TTF_Font* openFont(int point_size)
+{
+    TTF_Font* font = TTF_OpenFont(AppConfig::font_name.c_str(), point_size);
+    if(font == nullptr) return nullptr;
+    SDL_RWops* file = SDL_RWFromFile(AppConfig::font_name.c_str(), "rb");
+    Sint64 size = file != nullptr ? SDL_RWsize(file) : 0;
+    if(file != nullptr) SDL_RWclose(file);
+    MemoryStats::allocated(MT_FONTS, size > 0 ? static_cast<std::size_t>(size) : 0);
+    return font;
+}
+
+// Fecha uma fonte aberta por openFont()
+static void closeFont(TTF_Font* font)
+{
+    if(font == nullptr) return;
+    TTF_CloseFont(font);
+    SDL_RWops* file = SDL_RWFromFile(AppConfig::font_name.c_str(), "rb");
+    Sint64 size = file != nullptr ? SDL_RWsize(file) : 0;
+    if(file != nullptr) SDL_RWclose(file);
+    MemoryStats::released(MT_FONTS, size > 0 ? static_cast<std::size_t>(size) : 0);
+}
+
+// Destrói uma textura contabilizada na categoria indicada
+static void destroyTexture(SDL_Texture* texture, MemoryTag tag)
+{
+    if(texture == nullptr) return;
+    MemoryStats::released(tag, textureBytes(texture));
+    SDL_DestroyTexture(texture);
+}
 
 // Construtor: inicializa todos os ponteiros dos recursos gráficos como nulos
 Renderer::Renderer()
@@ -10,26 +52,28 @@ Renderer::Renderer()
     m_texture = nullptr;
     m_renderer = nullptr;
     m_text_texture = nullptr;
+    for(TextCacheEntry& entry : m_text_cache) entry.texture = nullptr;
+    m_text_clock = 0;
+    m_view = {0, 0, 0, 0};
+    m_has_view = false;
     m_font1 = nullptr;
     m_font2 = nullptr;
-    // m_font3 será inicializado em loadFont()
+    m_font3 = nullptr;
 }
 
 // Destrutor: libera todos os recursos gráficos alocados
 Renderer::~Renderer()
 {
+    destroyTexture(m_texture, MT_TEXTURES); // Libera a textura principal
+    destroyTexture(m_text_texture, MT_TEXT); // Libera a textura de texto
+    for(TextCacheEntry& entry : m_text_cache)
+        destroyTexture(entry.texture, MT_TEXT); // Libera os textos guardados
+    closeFont(m_font1); // Fecha fonte 1
+    closeFont(m_font2); // Fecha fonte 2
+    closeFont(m_font3); // Fecha fonte 3
+    // Por último: destruir o renderizador também destrói suas texturas
     if(m_renderer != nullptr)
         SDL_DestroyRenderer(m_renderer); // Libera o renderizador SDL
-    if(m_texture != nullptr)
-        SDL_DestroyTexture(m_texture); // Libera a textura principal
-    if(m_text_texture != nullptr)
-        SDL_DestroyTexture(m_text_texture); // Libera a textura de texto
-    if(m_font1 != nullptr)
-        TTF_CloseFont(m_font1); // Fecha fonte 1
-    if(m_font2 != nullptr)
-        TTF_CloseFont(m_font2); // Fecha fonte 2
-    if(m_font3 != nullptr)
-        TTF_CloseFont(m_font3); // Fecha fonte 3
 }
 
 // Carrega a textura principal do jogo a partir do caminho definido em AppConfig
@@ -45,6 +89,8 @@ void Renderer::loadTexture(SDL_Window* window)
     // Se a superfície e o renderizador foram criados com sucesso, cria a textura
     if(surface != nullptr && m_renderer != nullptr)
         m_texture = SDL_CreateTextureFromSurface(m_renderer, surface);
+    if(m_texture != nullptr)
+        MemoryStats::allocated(MT_TEXTURES, textureBytes(m_texture));
 
     // Libera a superfície temporária
     SDL_FreeSurface(surface);
@@ -53,9 +99,9 @@ void Renderer::loadTexture(SDL_Window* window)
 // Carrega as fontes utilizadas para renderização de texto
 void Renderer::loadFont()
 {
-    m_font1 = TTF_OpenFont(AppConfig::font_name.c_str(), 28); // Fonte grande
-    m_font2 = TTF_OpenFont(AppConfig::font_name.c_str(), 14); // Fonte média
-    m_font3 = TTF_OpenFont(AppConfig::font_name.c_str(), 10); // Fonte pequena
+    m_font1 = openFont(28); // Fonte grande
+    m_font2 = openFont(14); // Fonte média
+    m_font3 = openFont(10); // Fonte pequena
 }
 
 // Limpa o buffer de renderização com uma cor de fundo padrão
@@ -74,12 +120,17 @@ void Renderer::flush()
 // Desenha um objeto (sprite) na tela usando uma região da textura
 void Renderer::drawObject(const SDL_Rect *texture_src, const SDL_Rect *window_dest)
 {
+    SDL_Rect screen;
+    if(!toScreen(window_dest, screen)) return; // Fora da vista
     SDL_RenderCopy(m_renderer, m_texture, texture_src, window_dest); // Desenha no back buffer
 }
 
 // Desenha um objeto (sprite) na tela com uma cor específica aplicada
 void Renderer::drawObjectWithColor(const SDL_Rect *texture_src, const SDL_Rect *window_dest, SDL_Color color)
 {
+    SDL_Rect screen;
+    if(!toScreen(window_dest, screen)) return; // Fora da vista
+
     // Salva a cor atual da textura
     Uint8 r, g, b, a;
     SDL_GetTextureColorMod(m_texture, &r, &g, &b);
@@ -118,58 +169,106 @@ void Renderer::setScale(float xs, float ys)
 }
 
 // Desenha um texto na tela em uma posição específica, usando a fonte e cor indicadas
-void Renderer::drawText(const SDL_Point* start, string text, SDL_Color text_color, int font_size)
+void Renderer::drawText(const SDL_Point* start, const char* text, SDL_Color text_color, int font_size)
 {
     // Verifica se as fontes estão carregadas
     if(m_font1 == nullptr || m_font2 == nullptr || m_font3 == nullptr) return;
-    // Libera a textura de texto anterior, se existir
-    if(m_text_texture != nullptr)
-        SDL_DestroyTexture(m_text_texture);
 
-    SDL_Surface* text_surface = nullptr;
-    // Seleciona a fonte de acordo com o tamanho solicitado
-    if(font_size == 2) 
-        text_surface = TTF_RenderText_Solid(m_font2, text.c_str(), text_color);
-    else if(font_size == 3) 
-        text_surface = TTF_RenderText_Solid(m_font3, text.c_str(), text_color);
-    else 
-        text_surface = TTF_RenderText_Solid(m_font1, text.c_str(), text_color);
-
-    if(text_surface == nullptr) return; // Falha ao criar superfície de texto
-
-    // Cria a textura de texto a partir da superfície
-    m_text_texture = SDL_CreateTextureFromSurface(m_renderer, text_surface);
-    if(m_text_texture == nullptr) return; // Falha ao criar textura
+    int w, h;
+    SDL_Texture* texture = textTexture(text, text_color, font_size, w, h);
+    if(texture == nullptr) return; // Falha ao criar a textura
 
     SDL_Rect window_dest;
     // Calcula a posição do texto: centralizado se start for nulo ou negativo
     if(start == nullptr)
     {
-        window_dest.x = (AppConfig::map_rect.w + AppConfig::status_rect.w - text_surface->w)/2;
-        window_dest.y = (AppConfig::map_rect.h - text_surface->h)/2;
+        window_dest.x = (AppConfig::map_rect.w + AppConfig::status_rect.w - w)/2;
+        window_dest.y = (AppConfig::map_rect.h - h)/2;
     }
     else
     {
         if(start->x < 0) 
-            window_dest.x = (AppConfig::map_rect.w + AppConfig::status_rect.w - text_surface->w)/2;
+            window_dest.x = (AppConfig::map_rect.w + AppConfig::status_rect.w - w)/2;
         else 
             window_dest.x = start->x;
 
         if(start->y < 0) 
-            window_dest.y = (AppConfig::map_rect.h - text_surface->h)/2;
+            window_dest.y = (AppConfig::map_rect.h - h)/2;
         else 
             window_dest.y = start->y;
     }
-    window_dest.w = text_surface->w;
-    window_dest.h = text_surface->h;
+    window_dest.w = w;
+    window_dest.h = h;
 
     // Renderiza o texto na tela
-    SDL_RenderCopy(m_renderer, m_text_texture, NULL, &window_dest);
+    SDL_RenderCopy(m_renderer, texture, NULL, &window_dest);
+}
+
+void Renderer::drawText(const SDL_Point* start, const string& text, SDL_Color text_color, int font_size)
+{
+    drawText(start, text.c_str(), text_color, font_size);
+}
+
+// Procura o texto entre os guardados; se não estiver, renderiza e substitui o menos usado recentemente
+SDL_Texture* Renderer::textTexture(const char* text, SDL_Color text_color, int font_size, int& w, int& h)
+{
+    bool cacheable = strlen(text) < TEXT_CACHE_LENGTH;
+    TextCacheEntry* slot = nullptr;
+    if(cacheable)
+    {
+        for(TextCacheEntry& entry : m_text_cache)
+        {
+            if(entry.texture != nullptr && entry.font_size == font_size && strcmp(entry.text, text) == 0
+                    && entry.color.r == text_color.r && entry.color.g == text_color.g
+                    && entry.color.b == text_color.b && entry.color.a == text_color.a)
+            {
+                entry.last_used = ++m_text_clock;
+                w = entry.w;
+                h = entry.h;
+                return entry.texture;
+            }
+            if(slot == nullptr || entry.texture == nullptr || (slot->texture != nullptr && entry.last_used < slot->last_used))
+                slot = &entry;
+        }
+    }
+
+    // Seleciona a fonte de acordo com o tamanho solicitado
+    TTF_Font* font = font_size == 2 ? m_font2 : (font_size == 3 ? m_font3 : m_font1);
+    SDL_Surface* text_surface = TTF_RenderText_Solid(font, text, text_color);
+    if(text_surface == nullptr) return nullptr; // Falha ao criar superfície de texto
+
+    // Cria a textura de texto a partir da superfície, que não é mais necessária
+    SDL_Texture* texture = SDL_CreateTextureFromSurface(m_renderer, text_surface);
+    w = text_surface->w;
+    h = text_surface->h;
+    SDL_FreeSurface(text_surface);
+    if(texture == nullptr) return nullptr;
+    MemoryStats::allocated(MT_TEXT, textureBytes(texture));
+
+    if(!cacheable)
+    {
+        destroyTexture(m_text_texture, MT_TEXT);
+        m_text_texture = texture;
+        return texture;
+    }
+
+    destroyTexture(slot->texture, MT_TEXT);
+    strcpy(slot->text, text);
+    slot->font_size = font_size;
+    slot->color = text_color;
+    slot->texture = texture;
+    slot->w = w;
+    slot->h = h;
+    slot->last_used = ++m_text_clock;
+    return texture;
 }
 
 // Desenha um retângulo na tela, preenchido ou apenas contornado
 void Renderer::drawRect(const SDL_Rect *rect, SDL_Color rect_color, bool fill)
 {
+    SDL_Rect screen;
+    if(!toScreen(rect, screen)) return; // Fora da vista
+
     SDL_SetRenderDrawColor(m_renderer, rect_color.r, rect_color.g, rect_color.b, rect_color.a);
 
     if(fill)
@@ -177,3 +276,22 @@ void Renderer::drawRect(const SDL_Rect *rect, SDL_Color rect_color, bool fill)
     else
         SDL_RenderDrawRects(m_renderer, rect, 1); // Desenha apenas a borda do retângulo
 }
+
+// A vista é desenhada na área do mapa; o corte impede que objetos na borda cubram o painel de status
+void Renderer::setView(const SDL_Rect* view)
+{
+    m_has_view = view != nullptr;
+    if(m_has_view) m_view = *view;
+    SDL_RenderSetClipRect(m_renderer, m_has_view ? &AppConfig::map_rect : nullptr);
+}
+
+bool Renderer::toScreen(const SDL_Rect*& rect, SDL_Rect& screen) const
+{
+    if(!m_has_view || rect == nullptr) return true;
+    if(rect->x >= m_view.x + m_view.w || rect->x + rect->w <= m_view.x
+            || rect->y >= m_view.y + m_view.h || rect->y + rect->h <= m_view.y)
+        return false;
+    screen = {rect->x - m_view.x + AppConfig::map_rect.x, rect->y - m_view.y + AppConfig::map_rect.y, rect->w, rect->h};
+    rect = &screen;
+    return true;
+}
@@ -63,12 +63,15 @@ public:
 
     /**
      * Desenha um texto na tela em uma posição específica.
+     * As texturas dos textos desenhados recentemente são guardadas e reaproveitadas: um texto que se repete a cada frame
+     * (placar, número da rodada) é renderizado pela SDL_ttf apenas uma vez.
      * @param start Posição inicial do texto; valores negativos centralizam o texto naquele eixo.
      * @param text Texto a ser desenhado.
      * @param text_color Cor do texto.
      * @param font_size Tamanho da fonte: 1 (grande), 2 (média), 3 (pequena).
      */
-    void drawText(const SDL_Point* start, std::string text, SDL_Color text_color, int font_size = 1);
+    void drawText(const SDL_Point* start, const char* text, SDL_Color text_color, int font_size = 1);
+    void drawText(const SDL_Point* start, const std::string& text, SDL_Color text_color, int font_size = 1);
 
     /**
      * Desenha um retângulo na tela.
@@ -78,7 +81,33 @@ public:
      */
     void drawRect(const SDL_Rect* rect, SDL_Color rect_color, bool fill = false);
 
+    /**
+     * Define a parte do mundo mostrada na área do mapa (@a Camera). Enquanto definida, drawObject(), drawObjectWithColor()
+     * e drawRect() recebem coordenadas do mundo: o que estiver fora da vista é descartado sem chamar a SDL e o restante é
+     * deslocado para a área do mapa e cortado nela. Textos continuam em coordenadas da tela.
+     * @param view - área vista do mundo, ou nullptr para voltar às coordenadas da tela (painel de status)
+     */
+    void setView(const SDL_Rect* view);
+
 private:
+    /**
+     * Converte um retângulo do mundo para a tela, se houver vista definida.
+     * @param rect - retângulo no mundo; passa a apontar para @a screen quando convertido
+     * @param screen - área para o retângulo convertido
+     * @return @a false se o retângulo estiver fora da vista
+     */
+    bool toScreen(const SDL_Rect*& rect, SDL_Rect& screen) const;
+
+    /**
+     * Área vista do mundo (válida se m_has_view).
+     */
+    SDL_Rect m_view;
+
+    /**
+     * Indica se setView() definiu uma vista.
+     */
+    bool m_has_view;
+
     /**
      * Ponteiro para o renderizador SDL associado ao buffer da janela.
      */
@@ -90,7 +119,40 @@ private:
     SDL_Texture* m_texture;
 
     /**
-     * Ponteiro para a textura auxiliar utilizada na renderização de textos.
+     * Retorna a textura de um texto, renderizando-o apenas se não estiver guardado.
+     * @return textura ou nullptr se a renderização falhar
+     */
+    SDL_Texture* textTexture(const char* text, SDL_Color text_color, int font_size, int& w, int& h);
+
+    static const int TEXT_CACHE_SIZE = 16;      ///< Quantidade de textos guardados.
+    static const int TEXT_CACHE_LENGTH = 32;    ///< Tamanho máximo (com '\0') de um texto guardado.
+
+    /**
+     * @brief Texto renderizado guardado para os próximos frames.
+     */
+    struct TextCacheEntry
+    {
+        char text[TEXT_CACHE_LENGTH];   ///< Texto.
+        int font_size;                  ///< Fonte usada.
+        SDL_Color color;                ///< Cor usada.
+        SDL_Texture* texture;           ///< Textura renderizada (nullptr se a entrada estiver livre).
+        int w;                          ///< Largura da textura.
+        int h;                          ///< Altura da textura.
+        Uint32 last_used;               ///< Valor de m_text_clock no último uso (para descartar a menos usada).
+    };
+
+    /**
+     * Textos guardados.
+     */
+    TextCacheEntry m_text_cache[TEXT_CACHE_SIZE];
+
+    /**
+     * Contador de usos dos textos guardados.
+     */
+    Uint32 m_text_clock;
+
+    /**
+     * Ponteiro para a textura auxiliar utilizada na renderização de textos longos demais para serem guardados.
      */
     SDL_Texture* m_text_texture;
 
@@ -0,0 +1,234 @@
+#include "rewindbuffer.h"
+
+#include <algorithm>
+#include <cstring>
+
+// Menor sequência de zeros que interrompe um trecho literal do RLE
+static const unsigned RLE_MIN_ZERO_RUN = 4;
+static const unsigned RLE_MAX_RUN = 0xFFFF;
+
+RewindBuffer::RewindBuffer(unsigned capacity, unsigned max_frames, unsigned keyframe_interval)
+    : m_data(capacity), m_frames(max_frames > 0 ? max_frames : 1)
+{
+    m_keyframe_interval = keyframe_interval > 0 ? keyframe_interval : 1;
+    clear();
+}
+
+void RewindBuffer::clear()
+{
+    m_first = 0;
+    m_count = 0;
+    m_write = 0;
+    m_since_keyframe = 0;
+    m_force_keyframe = true;
+}
+
+// O pior caso do RLE é um trecho de 4 bytes de cabeçalho para cada literal isolado entre zeros
+void RewindBuffer::reserve(unsigned state_size)
+{
+    m_keyframe_state.reserve(state_size);
+    m_encoded.reserve(4 + state_size * 2);
+}
+
+unsigned RewindBuffer::size() const
+{
+    return m_count;
+}
+
+// Guarda o estado como quadro-chave ou como delta contra o último quadro-chave
+void RewindBuffer::push(const std::vector<Uint8>& state)
+{
+    if(m_count == m_frames.size()) dropOldest();
+
+    bool keyframe = m_force_keyframe || m_since_keyframe >= m_keyframe_interval;
+    encode(state, keyframe ? m_empty : m_keyframe_state, m_encoded);
+    int offset = allocate(m_encoded.size());
+
+    // O descarte de estados antigos pode ter removido o quadro-chave de referência: guarda como quadro-chave
+    if(offset >= 0 && !keyframe && (m_count == 0 || frame(m_first + m_count - 1).keyframe < m_first))
+    {
+        keyframe = true;
+        encode(state, m_empty, m_encoded);
+        offset = allocate(m_encoded.size());
+    }
+    if(offset < 0) return; // estado maior que o buffer inteiro
+
+    unsigned index = m_first + m_count;
+
+    Frame& f = frame(index);
+    f.offset = offset;
+    f.length = m_encoded.size();
+    std::copy(m_encoded.begin(), m_encoded.end(), m_data.begin() + offset);
+    m_write = offset + f.length;
+    m_count++;
+
+    if(keyframe)
+    {
+        f.keyframe = index;
+        m_keyframe_state = state;
+        m_since_keyframe = 0;
+        m_force_keyframe = false;
+    }
+    else
+        f.keyframe = frame(index - 1).keyframe;
+    m_since_keyframe++;
+}
+
+// Reconstrói e remove o estado mais recente
+bool RewindBuffer::pop(std::vector<Uint8>& state)
+{
+    if(m_count == 0) return false;
+
+    unsigned index = m_first + m_count - 1;
+    Frame f = frame(index);
+    if(f.keyframe == index)
+        decode(&m_data[f.offset], f.length, m_empty, state);
+    else
+    {
+        Frame& key = frame(f.keyframe);
+        decode(&m_data[key.offset], key.length, m_empty, m_keyframe_state);
+        decode(&m_data[f.offset], f.length, m_keyframe_state, state);
+    }
+
+    m_count--;
+    m_write = f.offset; // o estado mais recente é sempre o último escrito
+    m_force_keyframe = true;
+    return true;
+}
+
+RewindBuffer::Frame& RewindBuffer::frame(unsigned index)
+{
+    return m_frames[index % m_frames.size()];
+}
+
+// Descarta o estado mais antigo; deltas que dependiam dele não podem mais ser decodificados
+void RewindBuffer::dropOldest()
+{
+    if(m_count == 0) return;
+    m_first++;
+    m_count--;
+    while(m_count > 0 && frame(m_first).keyframe != m_first)
+    {
+        m_first++;
+        m_count--;
+    }
+}
+
+// Reserva espaço contíguo, voltando ao início do buffer e descartando estados antigos se necessário
+int RewindBuffer::allocate(unsigned length)
+{
+    if(length > m_data.size()) return -1;
+
+    if(m_write + length > m_data.size())
+    {
+        // Os estados guardados entre m_write e o fim do buffer são os mais antigos
+        unsigned old_write = m_write;
+        while(m_count > 0 && frame(m_first).offset >= old_write) dropOldest();
+        m_write = 0;
+    }
+
+    while(m_count > 0)
+    {
+        Frame& oldest = frame(m_first);
+        if(oldest.offset < m_write + length && m_write < oldest.offset + oldest.length) dropOldest();
+        else break;
+    }
+    return m_write;
+}
+
+// XOR contra a referência seguido de RLE. Com milhares de objetos (modo horda) o estado tem alguns MB, então os trechos
+// são percorridos por palavras de 8 bytes em vez de byte a byte
+void RewindBuffer::encode(const std::vector<Uint8>& state, const std::vector<Uint8>& base, std::vector<Uint8>& out)
+{
+    const unsigned size = state.size();
+    const unsigned base_size = base.size();
+    auto byte_at = [&](unsigned i) -> Uint8 {
+        return state[i] ^ (i < base_size ? base[i] : 0);
+    };
+    // Palavras só onde a referência cobre a palavra inteira ou está vazia
+    auto word_ready = [&](unsigned i, unsigned length) {
+        return i + length <= size && (base_size == 0 || i + length <= base_size);
+    };
+    auto word64_at = [&](unsigned i) -> Uint64 {
+        Uint64 word, reference = 0;
+        std::memcpy(&word, &state[i], 8);
+        if(base_size > 0) std::memcpy(&reference, &base[i], 8);
+        return word ^ reference;
+    };
+    auto write16 = [&](unsigned pos, unsigned value) {
+        out[pos] = value & 0xFF;
+        out[pos + 1] = (value >> 8) & 0xFF;
+    };
+
+    out.clear();
+    out.push_back(size & 0xFF);
+    out.push_back((size >> 8) & 0xFF);
+    out.push_back((size >> 16) & 0xFF);
+    out.push_back((size >> 24) & 0xFF);
+
+    unsigned i = 0;
+    while(i < size)
+    {
+        unsigned zeros = 0;
+        while(word_ready(i, 8) && zeros + 8 <= RLE_MAX_RUN && word64_at(i) == 0) { zeros += 8; i += 8; }
+        while(i < size && zeros < RLE_MAX_RUN && byte_at(i) == 0) { zeros++; i++; }
+
+        // Interrompe o trecho literal em uma sequência longa de zeros. Em cada palavra de 8 bytes, as sequências que começam
+        // nos 5 primeiros bytes são testadas juntas com a máscara de bytes nulos; sem nenhuma, o trecho avança 5 bytes
+        unsigned start = i;
+        unsigned end = std::min(size, start + RLE_MAX_RUN);
+        while(i < end)
+        {
+            if(word_ready(i, 8))
+            {
+                Uint64 word = SDL_SwapLE64(word64_at(i));
+                Uint64 zero = ~(((word & 0x7F7F7F7F7F7F7F7FULL) + 0x7F7F7F7F7F7F7F7FULL) | word) & 0x8080808080808080ULL;
+                if((zero & (zero >> 8) & (zero >> 16) & (zero >> 24) & 0x000000FFFFFFFFFFULL) == 0)
+                {
+                    i = std::min(end, i + 5);
+                    continue;
+                }
+            }
+            unsigned run = 0;
+            while(run < RLE_MIN_ZERO_RUN && i + run < size && byte_at(i + run) == 0) run++;
+            if(run == RLE_MIN_ZERO_RUN) break;
+            i++;
+        }
+
+        unsigned header = out.size();
+        unsigned literals = i - start;
+        out.resize(header + 4 + literals);
+        write16(header, zeros);
+        write16(header + 2, literals);
+        Uint8* literal = &out[header + 4];
+        unsigned common = std::min(i, std::max(start, base_size));
+        for(unsigned k = start; k < common; k++) *literal++ = state[k] ^ base[k];
+        for(unsigned k = common; k < i; k++) *literal++ = state[k];
+    }
+}
+
+void RewindBuffer::decode(const Uint8* data, unsigned length, const std::vector<Uint8>& base, std::vector<Uint8>& state)
+{
+    if(length < 4)
+    {
+        state.clear();
+        return;
+    }
+    unsigned size = data[0] | (data[1] << 8) | (data[2] << 16) | (static_cast<unsigned>(data[3]) << 24);
+    state.resize(size);
+
+    auto base_at = [&](unsigned i) -> Uint8 {
+        return i < base.size() ? base[i] : 0;
+    };
+
+    unsigned pos = 0;
+    unsigned in = 4;
+    while(pos < size && in + 4 <= length)
+    {
+        unsigned zeros = data[in] | (data[in + 1] << 8);
+        unsigned literals = data[in + 2] | (data[in + 3] << 8);
+        in += 4;
+        for(unsigned k = 0; k < zeros && pos < size; k++, pos++) state[pos] = base_at(pos);
+        for(unsigned k = 0; k < literals && pos < size && in < length; k++, pos++, in++) state[pos] = data[in] ^ base_at(pos);
+    }
+}
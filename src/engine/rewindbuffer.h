@@ -0,0 +1,116 @@
+#ifndef REWINDBUFFER_H
+#define REWINDBUFFER_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+/**
+ * @brief
+ * Buffer circular de estados da simulação, usado para retroceder a partida tick a tick.
+ * Cada estado é guardado como quadro-chave (a cada @a keyframe_interval estados) ou como delta:
+ * XOR contra o último quadro-chave, comprimido com RLE. Toda a memória é reservada no construtor,
+ * de modo que o consumo fica limitado a @a capacity bytes independentemente da quantidade de objetos;
+ * quando o espaço acaba, os estados mais antigos são descartados.
+ */
+class RewindBuffer
+{
+public:
+    /**
+     * @param capacity - tamanho do buffer de dados em bytes
+     * @param max_frames - quantidade máxima de estados guardados
+     * @param keyframe_interval - quantidade de estados entre dois quadros-chave
+     */
+    RewindBuffer(unsigned capacity, unsigned max_frames, unsigned keyframe_interval);
+
+    /**
+     * Guarda um novo estado (o mais recente).
+     * @param state - estado serializado (ex.: por Game::saveState)
+     */
+    void push(const std::vector<Uint8>& state);
+
+    /**
+     * Remove o estado mais recente e o reconstrói em @a state.
+     * @param state - recebe o estado reconstruído
+     * @return false se não houver estados guardados
+     */
+    bool pop(std::vector<Uint8>& state);
+
+    /**
+     * Descarta todos os estados guardados.
+     */
+    void clear();
+
+    /**
+     * Reserva as áreas temporárias para estados de até @a state_size bytes, para que push() e pop() não aloquem memória.
+     * @param state_size - maior tamanho de estado esperado
+     */
+    void reserve(unsigned state_size);
+
+    /**
+     * Retorna a quantidade de estados guardados.
+     * @return número de estados disponíveis para retroceder
+     */
+    unsigned size() const;
+
+private:
+    /**
+     * @brief Descritor de um estado guardado no buffer de dados.
+     */
+    struct Frame
+    {
+        unsigned offset;    ///< Posição dos dados codificados no buffer.
+        unsigned length;    ///< Tamanho dos dados codificados.
+        unsigned keyframe;  ///< Índice absoluto do quadro-chave de referência (igual ao próprio índice se for quadro-chave).
+    };
+
+    /**
+     * Codifica @a state como XOR contra @a base (completado com zeros) seguido de RLE:
+     * pares [zeros: Uint16][literais: Uint16] e os bytes literais. Os primeiros 4 bytes guardam o tamanho do estado.
+     * @param state - estado a codificar
+     * @param base - referência (vazia para quadros-chave)
+     * @param out - recebe os dados codificados
+     */
+    static void encode(const std::vector<Uint8>& state, const std::vector<Uint8>& base, std::vector<Uint8>& out);
+
+    /**
+     * Decodifica dados produzidos por encode().
+     * @param data - dados codificados
+     * @param length - tamanho dos dados codificados
+     * @param base - mesma referência usada na codificação
+     * @param state - recebe o estado
+     */
+    static void decode(const Uint8* data, unsigned length, const std::vector<Uint8>& base, std::vector<Uint8>& state);
+
+    /**
+     * Retorna o descritor de um estado pelo índice absoluto.
+     * @param index - índice absoluto (entre m_first e m_first + m_count - 1)
+     */
+    Frame& frame(unsigned index);
+
+    /**
+     * Descarta o estado mais antigo e os deltas que dependiam dele, se ele for quadro-chave.
+     */
+    void dropOldest();
+
+    /**
+     * Reserva @a length bytes contíguos no buffer de dados, descartando estados antigos que ocupem a região.
+     * @param length - tamanho necessário
+     * @return posição reservada, ou -1 se @a length for maior que a capacidade
+     */
+    int allocate(unsigned length);
+
+    std::vector<Uint8> m_data;          ///< Buffer circular de dados codificados.
+    std::vector<Frame> m_frames;        ///< Descritores, indexados por índice absoluto módulo max_frames.
+    unsigned m_keyframe_interval;       ///< Estados entre quadros-chave.
+    unsigned m_first;                   ///< Índice absoluto do estado mais antigo.
+    unsigned m_count;                   ///< Quantidade de estados guardados.
+    unsigned m_write;                   ///< Próxima posição livre no buffer de dados.
+    unsigned m_since_keyframe;          ///< Estados guardados desde o último quadro-chave.
+    bool m_force_keyframe;              ///< O próximo estado deve ser quadro-chave (após pop ou clear).
+
+    std::vector<Uint8> m_keyframe_state;    ///< Último quadro-chave guardado, sem codificação.
+    std::vector<Uint8> m_encoded;           ///< Área temporária para codificação.
+    std::vector<Uint8> m_empty;             ///< Referência vazia para quadros-chave.
+};
+
+#endif // REWINDBUFFER_H
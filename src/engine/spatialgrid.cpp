@@ -0,0 +1,66 @@
+#include "spatialgrid.h"
+
+SpatialGrid::SpatialGrid()
+{
+    m_world = {0, 0, 0, 0};
+    m_cell_size = 1;
+    m_columns = m_rows = 1;
+    m_cell_start.assign(2, 0);
+}
+
+void SpatialGrid::reset(const SDL_Rect& world, int cell_size)
+{
+    m_world = world;
+    m_cell_size = cell_size > 0 ? cell_size : 1;
+    m_columns = world.w > 0 ? (world.w + m_cell_size - 1) / m_cell_size : 1;
+    m_rows = world.h > 0 ? (world.h + m_cell_size - 1) / m_cell_size : 1;
+    m_cell_start.assign(m_columns * m_rows + 1, 0);
+    m_fill.assign(m_columns * m_rows, 0);
+    m_items.clear();
+}
+
+void SpatialGrid::reserve(unsigned count)
+{
+    // Retângulos do tamanho de uma célula tocam no máximo quatro células
+    m_items.reserve(count * 4);
+}
+
+// Ordenação por contagem: conta os retângulos de cada célula, acumula os inícios e distribui os índices.
+// Retângulos vazios (tanques surgindo ou destruídos) não colidem com nada e ficam fora da grade
+void SpatialGrid::build(const SDL_Rect* rects, unsigned count)
+{
+    unsigned cells = m_columns * m_rows;
+    for(unsigned cell = 0; cell <= cells; cell++) m_cell_start[cell] = 0;
+
+    int x_start, y_start, x_end, y_end;
+    for(unsigned i = 0; i < count; i++)
+    {
+        if(rects[i].w <= 0 || rects[i].h <= 0) continue;
+        cellRange(rects[i], x_start, y_start, x_end, y_end);
+        for(int y = y_start; y <= y_end; y++)
+            for(int x = x_start; x <= x_end; x++) m_cell_start[y * m_columns + x + 1]++;
+    }
+    for(unsigned cell = 0; cell < cells; cell++)
+    {
+        m_cell_start[cell + 1] += m_cell_start[cell];
+        m_fill[cell] = m_cell_start[cell];
+    }
+
+    m_items.resize(m_cell_start[cells]);
+    for(unsigned i = 0; i < count; i++)
+    {
+        if(rects[i].w <= 0 || rects[i].h <= 0) continue;
+        cellRange(rects[i], x_start, y_start, x_end, y_end);
+        for(int y = y_start; y <= y_end; y++)
+            for(int x = x_start; x <= x_end; x++) m_items[m_fill[y * m_columns + x]++] = i;
+    }
+}
+
+void SpatialGrid::cellRange(const SDL_Rect& rect, int& x_start, int& y_start, int& x_end, int& y_end) const
+{
+    auto clamp = [](int value, int max) { return value < 0 ? 0 : (value > max ? max : value); };
+    x_start = clamp((rect.x - m_world.x) / m_cell_size, m_columns - 1);
+    y_start = clamp((rect.y - m_world.y) / m_cell_size, m_rows - 1);
+    x_end = clamp((rect.x + rect.w - m_world.x) / m_cell_size, m_columns - 1);
+    y_end = clamp((rect.y + rect.h - m_world.y) / m_cell_size, m_rows - 1);
+}
@@ -0,0 +1,74 @@
+#ifndef SPATIALGRID_H
+#define SPATIALGRID_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+/**
+ * @brief
+ * Grade uniforme para encontrar retângulos próximos sem comparar todos os pares (fase larga das colisões).
+ * A cada tick a grade é refeita com build() a partir dos retângulos dos objetos; query() visita os objetos das células
+ * que um retângulo toca. Os vetores mantêm a capacidade entre usos, portanto build() não aloca memória depois de reserve().
+ * Retângulos maiores que uma célula funcionam, mas são listados em várias células; retângulos vazios são ignorados.
+ */
+class SpatialGrid
+{
+public:
+    SpatialGrid();
+
+    /**
+     * Define a área coberta e o tamanho das células; retângulos fora da área ficam nas células da borda.
+     * @param world - área coberta
+     * @param cell_size - lado de uma célula
+     */
+    void reset(const SDL_Rect& world, int cell_size);
+
+    /**
+     * Reserva memória para @a count retângulos.
+     * @param count - quantidade esperada de retângulos
+     */
+    void reserve(unsigned count);
+
+    /**
+     * Refaz a grade.
+     * @param rects - retângulos; o índice de cada um é o valor passado a query()
+     * @param count - quantidade de retângulos
+     */
+    void build(const SDL_Rect* rects, unsigned count);
+
+    /**
+     * Visita os retângulos das células tocadas por @a rect. Um retângulo que ocupe várias dessas células é visitado uma vez
+     * por célula; os índices de uma célula são visitados em ordem crescente.
+     * @param rect - área consultada
+     * @param visit - função chamada com o índice de cada retângulo
+     */
+    template <typename F>
+    void query(const SDL_Rect& rect, F visit) const
+    {
+        if(rect.w <= 0 || rect.h <= 0) return;
+        int x_start, y_start, x_end, y_end;
+        cellRange(rect, x_start, y_start, x_end, y_end);
+        for(int y = y_start; y <= y_end; y++)
+            for(int x = x_start; x <= x_end; x++)
+            {
+                unsigned cell = y * m_columns + x;
+                for(unsigned i = m_cell_start[cell]; i < m_cell_start[cell + 1]; i++) visit(m_items[i]);
+            }
+    }
+
+private:
+    /**
+     * Calcula as células tocadas por um retângulo, limitadas à grade.
+     */
+    void cellRange(const SDL_Rect& rect, int& x_start, int& y_start, int& x_end, int& y_end) const;
+
+    SDL_Rect m_world;                       ///< Área coberta.
+    int m_cell_size;                        ///< Lado de uma célula.
+    int m_columns;                          ///< Colunas de células.
+    int m_rows;                             ///< Linhas de células.
+    std::vector<unsigned> m_cell_start;     ///< Início de cada célula em @a m_items (uma posição a mais no fim).
+    std::vector<unsigned> m_fill;           ///< Próxima posição livre de cada célula durante build().
+    std::vector<unsigned> m_items;          ///< Índices dos retângulos agrupados por célula.
+};
+
+#endif // SPATIALGRID_H
@@ -76,5 +76,5 @@ const SpriteData* SpriteConfig::getSpriteData(SpriteType st) const
 //   l   - indica se o sprite é animado (loop)
 void SpriteConfig::insert(SpriteType st, int x, int y, int w, int h, int fc, int fd, bool l)
 {
-    m_configs[st] = SpriteData(x, y, w, h, fc, fd, l);
+    m_configs[st] = SpriteData(st, x, y, w, h, fc, fd, l);
 }
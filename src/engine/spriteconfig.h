@@ -13,10 +13,16 @@
 struct SpriteData
 {
     // Construtor padrão: inicializa todos os campos com valores neutros
-    SpriteData() { rect.x = 0; rect.y = 0; rect.w = 0; rect.h = 0; frames_count = 0; frame_duration = 0; loop = false;}
+    SpriteData() { type = ST_NONE; rect.x = 0; rect.y = 0; rect.w = 0; rect.h = 0; frames_count = 0; frame_duration = 0; loop = false;}
     // Construtor parametrizado: define todos os campos de acordo com os argumentos
-    SpriteData(int x, int y, int w, int h, int fc, int fd, bool l)
-        { rect.x = x; rect.y = y; rect.w = w; rect.h = h; frames_count = fc; frame_duration = fd; loop = l;}
+    SpriteData(SpriteType st, int x, int y, int w, int h, int fc, int fd, bool l)
+        { type = st; rect.x = x; rect.y = y; rect.w = w; rect.h = h; frames_count = fc; frame_duration = fd; loop = l;}
+
+    /**
+     * Tipo do sprite ao qual estes dados pertencem.
+     * Permite serializar o sprite atual de um objeto sem guardar ponteiros.
+     */
+    SpriteType type;
 
     /**
      * Posição e dimensões do retângulo da primeira frame da animação na textura.
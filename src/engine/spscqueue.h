@@ -0,0 +1,76 @@
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @brief Fila circular sem travas (lock-free) para um único produtor e um único consumidor.
+ * A capacidade é fixa e definida em tempo de compilação, portanto a fila nunca aloca memória.
+ * O produtor usa apenas push(); o consumidor usa apenas peek() e pop().
+ * @tparam T - tipo dos elementos (deve ser copiável)
+ * @tparam Capacity - quantidade máxima de elementos (potência de dois)
+ */
+template <typename T, std::size_t Capacity>
+class SpscQueue
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity deve ser potência de dois");
+
+public:
+    SpscQueue() : m_head(0), m_tail(0) {}
+
+    /**
+     * Insere um elemento no fim da fila (lado do produtor).
+     * @param item - elemento a inserir
+     * @return false se a fila estiver cheia (o elemento é descartado)
+     */
+    bool push(const T& item)
+    {
+        std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        if(tail - m_head.load(std::memory_order_acquire) == Capacity) return false;
+        m_items[tail & (Capacity - 1)] = item;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Lê o primeiro elemento sem removê-lo (lado do consumidor).
+     * @param item - recebe o elemento lido
+     * @return false se a fila estiver vazia
+     */
+    bool peek(T& item) const
+    {
+        std::size_t head = m_head.load(std::memory_order_relaxed);
+        if(head == m_tail.load(std::memory_order_acquire)) return false;
+        item = m_items[head & (Capacity - 1)];
+        return true;
+    }
+
+    /**
+     * Remove o primeiro elemento da fila (lado do consumidor).
+     * @param item - recebe o elemento removido
+     * @return false se a fila estiver vazia
+     */
+    bool pop(T& item)
+    {
+        if(!peek(item)) return false;
+        m_head.store(m_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Verifica se a fila está vazia (valor aproximado se o produtor estiver ativo).
+     * @return true se não houver elementos
+     */
+    bool empty() const
+    {
+        return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+    }
+
+private:
+    T m_items[Capacity];                ///< Armazenamento circular dos elementos.
+    std::atomic<std::size_t> m_head;    ///< Próxima posição a ser lida (consumidor).
+    std::atomic<std::size_t> m_tail;    ///< Próxima posição a ser escrita (produtor).
+};
+
+#endif // SPSCQUEUE_H
@@ -0,0 +1,131 @@
+#ifndef STATEBUFFER_H
+#define STATEBUFFER_H
+
+#include <SDL2/SDL.h>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief
+ * Escreve valores em um buffer plano de bytes, usado para salvar o estado da simulação.
+ * O buffer não contém ponteiros, portanto pode ser copiado, comparado e restaurado em qualquer posição de memória.
+ * A capacidade do vetor é reaproveitada entre usos, evitando alocações a cada tick.
+ */
+class StateWriter
+{
+public:
+    /**
+     * Cria o escritor e esvazia o buffer (a capacidade é mantida).
+     * @param buffer - buffer de destino
+     */
+    explicit StateWriter(std::vector<Uint8>& buffer) : m_buffer(buffer) { m_buffer.clear(); }
+
+    /**
+     * Acrescenta a representação binária de @a value ao buffer.
+     * @param value - valor trivialmente copiável (números, enums, SDL_Rect, SDL_Color...)
+     */
+    template <typename T>
+    void write(const T& value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "StateWriter::write requer tipo trivialmente copiável");
+        std::size_t pos = m_buffer.size();
+        m_buffer.resize(pos + sizeof(T));
+        std::memcpy(m_buffer.data() + pos, &value, sizeof(T));
+    }
+
+    /**
+     * Acrescenta bytes já serializados (ex.: uma seção guardada de um estado anterior).
+     * @param data - início dos bytes
+     * @param size - quantidade de bytes
+     */
+    void writeBytes(const Uint8* data, std::size_t size)
+    {
+        std::size_t pos = m_buffer.size();
+        m_buffer.resize(pos + size);
+        if(size > 0) std::memcpy(m_buffer.data() + pos, data, size);
+    }
+
+    /**
+     * Retorna a quantidade de bytes escritos.
+     * @return tamanho do buffer
+     */
+    std::size_t size() const { return m_buffer.size(); }
+
+private:
+    std::vector<Uint8>& m_buffer;   ///< Buffer de destino.
+};
+
+/**
+ * @brief
+ * Lê valores de um buffer produzido por StateWriter.
+ * Leituras além do fim do buffer não acessam memória inválida: retornam valores zerados e marcam o leitor como inválido.
+ */
+class StateReader
+{
+public:
+    /**
+     * @param data - início do buffer
+     * @param size - tamanho do buffer em bytes
+     */
+    StateReader(const Uint8* data, std::size_t size) : m_data(data), m_size(size), m_pos(0), m_ok(true) {}
+
+    /**
+     * Lê o próximo valor do buffer.
+     * @param value - recebe o valor lido (zerado se não houver bytes suficientes)
+     * @return false se o buffer terminou antes do valor
+     */
+    template <typename T>
+    bool read(T& value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "StateReader::read requer tipo trivialmente copiável");
+        if(!m_ok || m_pos + sizeof(T) > m_size)
+        {
+            m_ok = false;
+            std::memset(static_cast<void*>(&value), 0, sizeof(T));
+            return false;
+        }
+        std::memcpy(static_cast<void*>(&value), m_data + m_pos, sizeof(T));
+        m_pos += sizeof(T);
+        return true;
+    }
+
+    /**
+     * Lê bytes gravados com StateWriter::writeBytes.
+     * @param data - recebe os bytes lidos (zerados se não houver bytes suficientes)
+     * @param size - quantidade de bytes
+     * @return false se o buffer terminou antes dos bytes
+     */
+    bool readBytes(Uint8* data, std::size_t size)
+    {
+        if(!m_ok || m_pos + size > m_size)
+        {
+            m_ok = false;
+            if(size > 0) std::memset(data, 0, size);
+            return false;
+        }
+        if(size > 0) std::memcpy(data, m_data + m_pos, size);
+        m_pos += size;
+        return true;
+    }
+
+    /**
+     * Indica se todas as leituras até agora foram válidas.
+     * @return false se alguma leitura ultrapassou o fim do buffer
+     */
+    bool ok() const { return m_ok; }
+
+    /**
+     * Retorna a quantidade de bytes já lidos.
+     * @return posição atual no buffer
+     */
+    std::size_t position() const { return m_pos; }
+
+private:
+    const Uint8* m_data;    ///< Início do buffer.
+    std::size_t m_size;     ///< Tamanho do buffer.
+    std::size_t m_pos;      ///< Posição da próxima leitura.
+    bool m_ok;              ///< Falso após uma leitura inválida.
+};
+
+#endif // STATEBUFFER_H
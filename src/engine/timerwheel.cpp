@@ -0,0 +1,282 @@
+#include "timerwheel.h"
+
+#include <algorithm>
+
+TimerWheel* TimerWheel::s_active = nullptr;
+
+// Posições do nível 0 e de cada nível superior
+static const int LEVEL0_SIZE = 256;
+static const int LEVEL_SIZE = 64;
+// Maior intervalo representável (nível 3 completo)
+static const Uint32 MAX_DELAY = (1u << 26) - 1;
+
+TimerListener::TimerListener()
+{
+    for(int i = 0; i < MAX_TIMERS; i++) m_timer_nodes[i] = -1;
+}
+
+TimerListener::~TimerListener()
+{
+    for(int i = 0; i < MAX_TIMERS; i++) stopTimer(i);
+}
+
+void TimerListener::startTimer(int timer_id, Uint32 delay)
+{
+    stopTimer(timer_id);
+    TimerWheel* wheel = TimerWheel::active();
+    if(wheel == nullptr || wheel->m_loading) return;
+    if(delay < 1) delay = 1;
+    m_timer_nodes[timer_id] = wheel->schedule(this, timer_id, wheel->m_now + delay, wheel->m_sequence++);
+}
+
+void TimerListener::stopTimer(int timer_id)
+{
+    if(m_timer_nodes[timer_id] < 0) return;
+    TimerWheel* wheel = TimerWheel::active();
+    if(wheel != nullptr) wheel->cancel(m_timer_nodes[timer_id]);
+    m_timer_nodes[timer_id] = -1;
+}
+
+bool TimerListener::timerActive(int timer_id) const
+{
+    return m_timer_nodes[timer_id] >= 0;
+}
+
+Uint32 TimerListener::timerRemaining(int timer_id) const
+{
+    TimerWheel* wheel = TimerWheel::active();
+    if(m_timer_nodes[timer_id] < 0 || wheel == nullptr) return 0;
+    return wheel->m_nodes[m_timer_nodes[timer_id]].expire - wheel->m_now;
+}
+
+// Apenas os temporizadores ativos: quantidade seguida de (identificador, tempo restante, ordem)
+void TimerListener::saveTimers(StateWriter& out) const
+{
+    TimerWheel* wheel = TimerWheel::active();
+    Uint8 count = 0;
+    for(int i = 0; i < MAX_TIMERS; i++)
+        if(timerRemaining(i) > 0) count++;
+    out.write(count);
+    for(Uint8 i = 0; i < MAX_TIMERS; i++)
+    {
+        Uint32 remaining = timerRemaining(i);
+        if(remaining == 0) continue;
+        out.write(i);
+        out.write(remaining);
+        out.write(wheel->m_nodes[m_timer_nodes[i]].sequence);
+    }
+}
+
+void TimerListener::loadTimers(StateReader& in)
+{
+    for(int i = 0; i < MAX_TIMERS; i++) stopTimer(i);
+
+    TimerWheel* wheel = TimerWheel::active();
+    Uint8 count;
+    in.read(count);
+    for(Uint8 i = 0; i < count; i++)
+    {
+        Uint8 timer_id;
+        Uint32 remaining, sequence;
+        in.read(timer_id);
+        in.read(remaining);
+        in.read(sequence);
+        if(!in.ok() || timer_id >= MAX_TIMERS || remaining == 0 || wheel == nullptr) continue;
+        stopTimer(timer_id);
+        m_timer_nodes[timer_id] = wheel->schedule(this, timer_id, wheel->m_now + remaining, sequence);
+    }
+}
+
+TimerWheel::TimerWheel()
+{
+    for(int i = 0; i < SLOT_COUNT; i++) m_slots[i] = -1;
+    m_free = -1;
+    m_count = 0;
+    m_now = 0;
+    m_sequence = 0;
+    m_loading = false;
+}
+
+TimerWheel::~TimerWheel()
+{
+    clear();
+    if(s_active == this) s_active = nullptr;
+}
+
+TimerWheel* TimerWheel::active()
+{
+    return s_active;
+}
+
+void TimerWheel::setActive(TimerWheel* wheel)
+{
+    s_active = wheel;
+}
+
+// Avança um milissegundo por vez: quando o índice de um nível volta a zero, a próxima posição do nível
+// acima é redistribuída; depois, os temporizadores da posição atual do nível 0 expiram
+void TimerWheel::advance(Uint32 dt)
+{
+    for(Uint32 step = 0; step < dt; step++)
+    {
+        m_now++;
+        if((m_now & (LEVEL0_SIZE - 1)) == 0)
+        {
+            for(int level = 1; level < LEVEL_COUNT; level++)
+            {
+                int shift = LEVEL0_BITS + (level - 1) * LEVEL_BITS;
+                int index = (m_now >> shift) & (LEVEL_SIZE - 1);
+                cascade(LEVEL0_SIZE + (level - 1) * LEVEL_SIZE + index);
+                if(index != 0) break;
+            }
+        }
+
+        int slot = m_now & (LEVEL0_SIZE - 1);
+        if(m_slots[slot] < 0) continue;
+
+        // Retira a lista da posição antes de chamar os objetos, que podem agendar e cancelar temporizadores
+        m_expired.clear();
+        for(int node = m_slots[slot]; node >= 0; node = m_nodes[node].next)
+        {
+            m_nodes[node].slot = -1;
+            m_expired.push_back(node);
+        }
+        m_slots[slot] = -1;
+        std::sort(m_expired.begin(), m_expired.end(), [this](int a, int b) { return m_nodes[a].sequence < m_nodes[b].sequence; });
+
+        for(std::size_t i = 0; i < m_expired.size(); i++)
+        {
+            int node = m_expired[i];
+            // Cancelado (e talvez reaproveitado) por um temporizador anterior do mesmo milissegundo
+            if(m_nodes[node].listener == nullptr || m_nodes[node].slot != -1) continue;
+            TimerListener* listener = m_nodes[node].listener;
+            int timer_id = m_nodes[node].timer_id;
+            listener->m_timer_nodes[timer_id] = -1;
+            cancel(node);
+            listener->onTimer(timer_id);
+        }
+        m_expired.clear();
+    }
+}
+
+void TimerWheel::clear()
+{
+    for(std::size_t i = 0; i < m_nodes.size(); i++)
+    {
+        if(m_nodes[i].listener == nullptr) continue;
+        m_nodes[i].listener->m_timer_nodes[m_nodes[i].timer_id] = -1;
+        m_nodes[i].slot = -1;
+        cancel(static_cast<int>(i));
+    }
+    for(int i = 0; i < SLOT_COUNT; i++) m_slots[i] = -1;
+}
+
+void TimerWheel::reserve(unsigned count)
+{
+    m_nodes.reserve(count);
+    m_expired.reserve(count);
+}
+
+Uint32 TimerWheel::now() const
+{
+    return m_now;
+}
+
+unsigned TimerWheel::size() const
+{
+    return m_count;
+}
+
+void TimerWheel::saveClock(StateWriter& out) const
+{
+    out.write(m_now);
+    out.write(m_sequence);
+}
+
+void TimerWheel::loadClock(StateReader& in)
+{
+    clear();
+    in.read(m_now);
+    in.read(m_sequence);
+    m_loading = true;
+}
+
+void TimerWheel::finishLoad()
+{
+    m_loading = false;
+}
+
+int TimerWheel::schedule(TimerListener* listener, int timer_id, Uint32 expire, Uint32 sequence)
+{
+    int node = m_free;
+    if(node >= 0)
+        m_free = m_nodes[node].next;
+    else
+    {
+        node = static_cast<int>(m_nodes.size());
+        m_nodes.push_back(Node());
+    }
+
+    if(expire - m_now > MAX_DELAY) expire = m_now + MAX_DELAY;
+    Node& n = m_nodes[node];
+    n.expire = expire;
+    n.sequence = sequence;
+    n.listener = listener;
+    n.timer_id = timer_id;
+    m_count++;
+    insert(node);
+    return node;
+}
+
+void TimerWheel::cancel(int node)
+{
+    unlink(node);
+    m_nodes[node].listener = nullptr;
+    m_nodes[node].next = m_free;
+    m_free = node;
+    m_count--;
+}
+
+void TimerWheel::insert(int node)
+{
+    Node& n = m_nodes[node];
+    Uint32 delta = n.expire - m_now;
+    int slot;
+    if(delta < (1u << LEVEL0_BITS))
+        slot = n.expire & (LEVEL0_SIZE - 1);
+    else
+    {
+        int level = 1;
+        while(level < LEVEL_COUNT - 1 && delta >= (1u << (LEVEL0_BITS + level * LEVEL_BITS))) level++;
+        int shift = LEVEL0_BITS + (level - 1) * LEVEL_BITS;
+        slot = LEVEL0_SIZE + (level - 1) * LEVEL_SIZE + ((n.expire >> shift) & (LEVEL_SIZE - 1));
+    }
+
+    n.slot = slot;
+    n.prev = -1;
+    n.next = m_slots[slot];
+    if(n.next >= 0) m_nodes[n.next].prev = node;
+    m_slots[slot] = node;
+}
+
+void TimerWheel::unlink(int node)
+{
+    Node& n = m_nodes[node];
+    if(n.slot < 0) return;
+    if(n.prev >= 0) m_nodes[n.prev].next = n.next;
+    else m_slots[n.slot] = n.next;
+    if(n.next >= 0) m_nodes[n.next].prev = n.prev;
+    n.slot = -1;
+}
+
+void TimerWheel::cascade(int slot)
+{
+    int node = m_slots[slot];
+    m_slots[slot] = -1;
+    while(node >= 0)
+    {
+        int next = m_nodes[node].next;
+        insert(node);
+        node = next;
+    }
+}
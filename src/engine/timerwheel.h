@@ -0,0 +1,216 @@
+#ifndef TIMERWHEEL_H
+#define TIMERWHEEL_H
+
+#include "statebuffer.h"
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+class TimerWheel;
+
+/**
+ * @brief
+ * Base para objetos que agendam temporizadores em um @a TimerWheel e recebem onTimer() quando eles expiram.
+ * Cada objeto tem até MAX_TIMERS temporizadores, identificados por @a TimerId; reiniciar um temporizador substitui o anterior.
+ * Os temporizadores são agendados na roda ativa (TimerWheel::active(), a da partida em andamento); sem roda ativa
+ * (menu, tela de pontuação) não há agendamento. Os temporizadores pendentes são cancelados automaticamente
+ * quando o objeto ou a roda são destruídos.
+ */
+class TimerListener
+{
+public:
+    /**
+     * Quantidade de identificadores de temporizador (ver @a TimerId).
+     */
+    static const int MAX_TIMERS = 12;
+
+    TimerListener();
+    virtual ~TimerListener();
+
+    /**
+     * Chamada quando um temporizador expira (o temporizador já está inativo ao ser chamada).
+     * @param timer_id - identificador do temporizador (@a TimerId)
+     */
+    virtual void onTimer(int timer_id) = 0;
+
+protected:
+    /**
+     * Agenda (ou reinicia) um temporizador.
+     * @param timer_id - identificador do temporizador
+     * @param delay - tempo até expirar em milissegundos (mínimo 1)
+     */
+    void startTimer(int timer_id, Uint32 delay);
+
+    /**
+     * Cancela um temporizador, se estiver ativo.
+     * @param timer_id - identificador do temporizador
+     */
+    void stopTimer(int timer_id);
+
+    /**
+     * @param timer_id - identificador do temporizador
+     * @return @a true se o temporizador estiver agendado
+     */
+    bool timerActive(int timer_id) const;
+
+    /**
+     * @param timer_id - identificador do temporizador
+     * @return tempo até o temporizador expirar em milissegundos, ou 0 se estiver inativo
+     */
+    Uint32 timerRemaining(int timer_id) const;
+
+    /**
+     * Salva o tempo restante e a ordem de agendamento dos temporizadores ativos.
+     * @param out - escritor do buffer de estado
+     */
+    void saveTimers(StateWriter& out) const;
+
+    /**
+     * Restaura os temporizadores salvos por saveTimers(), reagendando-os na roda ativa.
+     * @param in - leitor do buffer de estado
+     */
+    void loadTimers(StateReader& in);
+
+private:
+    friend class TimerWheel;
+
+    int m_timer_nodes[MAX_TIMERS];      ///< Índice do temporizador na roda ativa, ou -1 se inativo.
+};
+
+/**
+ * @brief
+ * Roda de temporizadores hierárquica com resolução de 1 ms (256 posições de 1 ms e três níveis de 64 posições,
+ * cobrindo ~18 horas). Agendar e cancelar custam O(1); advance() percorre apenas as posições do intervalo avançado
+ * e chama os temporizadores que expiram, então o custo por tick depende da quantidade de eventos e não da quantidade de objetos.
+ * Temporizadores que expiram no mesmo milissegundo são chamados na ordem em que foram agendados, o que mantém
+ * a simulação determinística (inclusive após restaurar um estado salvo).
+ */
+class TimerWheel
+{
+public:
+    TimerWheel();
+
+    /**
+     * Cancela os temporizadores pendentes e deixa de ser a roda ativa.
+     */
+    ~TimerWheel();
+
+    /**
+     * Retorna a roda usada pelos objetos ao agendar temporizadores (a da partida em andamento).
+     * @return roda ativa ou nullptr
+     */
+    static TimerWheel* active();
+
+    /**
+     * Define a roda ativa.
+     * @param wheel - roda da partida em andamento
+     */
+    static void setActive(TimerWheel* wheel);
+
+    /**
+     * Avança o relógio, chamando em ordem os temporizadores que expiram no intervalo.
+     * @param dt - tempo em milissegundos
+     */
+    void advance(Uint32 dt);
+
+    /**
+     * Cancela todos os temporizadores.
+     */
+    void clear();
+
+    /**
+     * Reserva espaço para @a count temporizadores simultâneos, para que agendar não aloque memória até esse limite.
+     * @param count - quantidade de temporizadores
+     */
+    void reserve(unsigned count);
+
+    /**
+     * @return tempo atual da roda em milissegundos
+     */
+    Uint32 now() const;
+
+    /**
+     * @return quantidade de temporizadores agendados
+     */
+    unsigned size() const;
+
+    /**
+     * Salva o relógio e o contador de agendamentos. Os temporizadores são salvos pelos próprios objetos.
+     * @param out - escritor do buffer de estado
+     */
+    void saveClock(StateWriter& out) const;
+
+    /**
+     * Cancela todos os temporizadores e restaura o relógio salvo por saveClock().
+     * Até finishLoad(), startTimer() é ignorado: os objetos recriados durante a restauração recebem
+     * os temporizadores salvos por loadTimers(), sem consumir números de ordem.
+     * @param in - leitor do buffer de estado
+     */
+    void loadClock(StateReader& in);
+
+    /**
+     * Encerra a restauração iniciada por loadClock().
+     */
+    void finishLoad();
+
+private:
+    friend class TimerListener;
+
+    /**
+     * @brief Temporizador agendado; os nós ficam em listas duplamente encadeadas por índice.
+     */
+    struct Node
+    {
+        Uint32 expire;              ///< Tempo em que expira.
+        Uint32 sequence;            ///< Ordem de agendamento (desempate entre temporizadores do mesmo milissegundo).
+        TimerListener* listener;    ///< Dono do temporizador (nullptr se o nó está livre).
+        int timer_id;               ///< Identificador do temporizador no dono.
+        int prev;                   ///< Nó anterior na posição.
+        int next;                   ///< Próximo nó na posição (ou na lista de nós livres).
+        int slot;                   ///< Posição onde o nó está.
+    };
+
+    static const int LEVEL0_BITS = 8;
+    static const int LEVEL_BITS = 6;
+    static const int LEVEL_COUNT = 4;
+    static const int SLOT_COUNT = (1 << LEVEL0_BITS) + (LEVEL_COUNT - 1) * (1 << LEVEL_BITS);
+
+    /**
+     * Agenda um temporizador com tempo de expiração e ordem definidos.
+     * @return índice do nó
+     */
+    int schedule(TimerListener* listener, int timer_id, Uint32 expire, Uint32 sequence);
+
+    /**
+     * Remove o nó da roda e o devolve à lista de nós livres.
+     */
+    void cancel(int node);
+
+    /**
+     * Insere o nó na posição correspondente ao seu tempo de expiração.
+     */
+    void insert(int node);
+
+    /**
+     * Remove o nó da lista da posição onde está.
+     */
+    void unlink(int node);
+
+    /**
+     * Redistribui os nós de uma posição de nível superior entre os níveis inferiores.
+     */
+    void cascade(int slot);
+
+    std::vector<Node> m_nodes;      ///< Todos os nós (agendados e livres).
+    int m_slots[SLOT_COUNT];        ///< Primeiro nó de cada posição, ou -1.
+    int m_free;                     ///< Primeiro nó livre, ou -1.
+    unsigned m_count;               ///< Temporizadores agendados.
+    Uint32 m_now;                   ///< Tempo atual em milissegundos.
+    Uint32 m_sequence;              ///< Próximo número de ordem de agendamento.
+    bool m_loading;                 ///< Restauração de estado em andamento (startTimer ignorado).
+    std::vector<int> m_expired;     ///< Nós que expiram no milissegundo em processamento.
+
+    static TimerWheel* s_active;    ///< Roda ativa.
+};
+
+#endif // TIMERWHEEL_H
@@ -0,0 +1,84 @@
+#include "eventbus.h"
+
+#include <cstdio>
+
+EventBus& EventBus::getInstance()
+{
+    static EventBus instance;
+    return instance;
+}
+
+EventBus::EventBus()
+{
+    m_consumer = nullptr;
+    m_dropped = 0;
+}
+
+// Com a fila cheia, os eventos pendentes são entregues antes; só há descarte sem consumidor
+void EventBus::emit(GameEventType type, SpriteType source, int x, int y)
+{
+    GameEvent event = {type, source, x, y};
+    if(m_events.push(event)) return;
+    flush();
+    if(!m_events.push(event)) m_dropped++;
+}
+
+bool EventBus::poll(GameEvent& event)
+{
+    return m_events.pop(event);
+}
+
+void EventBus::setConsumer(Consumer consumer)
+{
+    m_consumer = consumer;
+}
+
+void EventBus::flush()
+{
+    if(m_consumer == nullptr) return;
+    GameEvent event;
+    while(m_events.pop(event)) m_consumer(event);
+}
+
+void EventBus::clear()
+{
+    GameEvent event;
+    while(m_events.pop(event)) {}
+}
+
+Uint32 EventBus::dropped() const
+{
+    return m_dropped;
+}
+
+static Uint32 s_counts[GE_COUNT] = {};
+
+static const char* const EVENT_NAMES[GE_COUNT] =
+{
+    "SHOT", "HIT", "SHIELD", "KILL", "WALL HIT", "WALL DEST", "ICE", "BONUS", "BONUS GOT", "LIFE", "EAGLE", "LEVEL", "LEVEL END"
+};
+
+void EventStats::record(const GameEvent& event)
+{
+    s_counts[event.type]++;
+}
+
+Uint32 EventStats::count(GameEventType type)
+{
+    return s_counts[type];
+}
+
+void EventStats::formatLine(GameEventType type, char* buffer, std::size_t size)
+{
+    std::snprintf(buffer, size, "%-9s %7u", EVENT_NAMES[type], static_cast<unsigned>(s_counts[type]));
+}
+
+void EventStats::formatDropped(char* buffer, std::size_t size)
+{
+    std::snprintf(buffer, size, "%-9s %7u", "DROPPED", static_cast<unsigned>(EventBus::getInstance().dropped()));
+}
+
+const char* EventStats::name(GameEventType type)
+{
+    return EVENT_NAMES[type];
+}
@@ -0,0 +1,157 @@
+#ifndef EVENTBUS_H
+#define EVENTBUS_H
+
+#include "engine/spscqueue.h"
+#include "type.h"
+
+#include <SDL2/SDL.h>
+#include <cstddef>
+
+/**
+ * @brief Tipos de eventos da partida.
+ */
+enum GameEventType
+{
+    GE_SHOT,                ///< Jogador disparou.
+    GE_HIT,                 ///< Jogador atingido (com ou sem escudo, barco ou estrelas).
+    GE_SHIELD_HIT,          ///< Tiro contra o escudo do jogador.
+    GE_KILL,                ///< Tanque destruído.
+    GE_BRICK_HIT,           ///< Parede atingida.
+    GE_BRICK_DESTROYED,     ///< Célula de parede removida do mapa.
+    GE_ICE,                 ///< Tanque entrou no gelo.
+    GE_BONUS_SPAWNED,       ///< Bônus criado no mapa.
+    GE_BONUS_PICKED,        ///< Bônus recolhido por um jogador.
+    GE_LIFE,                ///< Jogador ganhou uma vida.
+    GE_EAGLE_DESTROYED,     ///< Águia destruída.
+    GE_LEVEL_START,         ///< Início de rodada (tela STAGE).
+    GE_LEVEL_END,           ///< Fim de rodada (vitória ou fim de jogo).
+    GE_COUNT
+};
+
+/**
+ * @brief Evento da partida: tipo, objeto que o causou ou sofreu e posição.
+ */
+struct GameEvent
+{
+    GameEventType type;     ///< Tipo do evento.
+    SpriteType source;      ///< Tipo do objeto envolvido (ex.: tanque destruído, parede atingida).
+    int x;                  ///< Posição horizontal do objeto.
+    int y;                  ///< Posição vertical do objeto.
+};
+
+/**
+ * @brief
+ * Fluxo de eventos da partida (Singleton). A simulação apenas registra o que aconteceu com emit(), sem tocar som
+ * nem fazer E/S dentro das colisões; a aplicação registra um consumidor (sons, estatísticas) com setConsumer(), e
+ * flush() entrega a ele os eventos pendentes. Os eventos ficam em uma fila circular sem travas de capacidade fixa
+ * (@a SpscQueue), então emit() nunca aloca memória. Uma granada ou a águia na horda registram milhares de eventos
+ * em uma só fase do tick: Game::update chama flush() ao fim de cada fase e, com a fila cheia, emit() também a
+ * esvazia antes de registrar. Sem consumidor (replays, benchmark) o evento é descartado e contado em dropped();
+ * os eventos não fazem parte do estado da simulação.
+ */
+class EventBus
+{
+public:
+    static const std::size_t CAPACITY = 4096;  ///< Eventos guardados entre duas entregas.
+
+    /**
+     * Consumidor dos eventos, chamado na thread da simulação.
+     */
+    typedef void (*Consumer)(const GameEvent& event);
+
+    /**
+     * Retorna a instância única do fluxo de eventos.
+     * @return referência para o EventBus
+     */
+    static EventBus& getInstance();
+
+    /**
+     * Registra um evento (lado da simulação).
+     * @param type - tipo do evento
+     * @param source - tipo do objeto envolvido
+     * @param x - posição horizontal
+     * @param y - posição vertical
+     */
+    void emit(GameEventType type, SpriteType source = ST_NONE, int x = 0, int y = 0);
+
+    /**
+     * Retira o evento mais antigo (lado dos consumidores).
+     * @param event - recebe o evento
+     * @return @a false se não houver eventos
+     */
+    bool poll(GameEvent& event);
+
+    /**
+     * Define quem recebe os eventos em flush().
+     * @param consumer - consumidor, ou nullptr para que os eventos fiquem na fila até poll() ou clear()
+     */
+    void setConsumer(Consumer consumer);
+
+    /**
+     * Entrega ao consumidor, em ordem, os eventos pendentes; sem consumidor, não faz nada.
+     */
+    void flush();
+
+    /**
+     * Descarta os eventos pendentes (usado por quem executa a simulação sem consumidores, como os replays).
+     */
+    void clear();
+
+    /**
+     * @return quantidade de eventos descartados com a fila cheia
+     */
+    Uint32 dropped() const;
+
+private:
+    EventBus();
+    EventBus(const EventBus&) = delete;
+    EventBus& operator=(const EventBus&) = delete;
+
+    SpscQueue<GameEvent, CAPACITY> m_events;    ///< Eventos ainda não lidos.
+    Consumer m_consumer;                        ///< Recebe os eventos em flush(), ou nullptr.
+    Uint32 m_dropped;                           ///< Eventos descartados com a fila cheia.
+};
+
+/**
+ * @brief
+ * Consumidor de estatísticas: contagem de cada tipo de evento desde o início do programa, exibida no painel de
+ * memória da partida (tecla M).
+ */
+class EventStats
+{
+public:
+    /**
+     * Conta um evento.
+     * @param event - evento lido do @a EventBus
+     */
+    static void record(const GameEvent& event);
+
+    /**
+     * @param type - tipo do evento
+     * @return quantidade de eventos do tipo
+     */
+    static Uint32 count(GameEventType type);
+
+    /**
+     * Escreve o nome e a contagem de um tipo de evento (ex.: "KILL 12").
+     * @param type - tipo do evento
+     * @param buffer - recebe o texto
+     * @param size - tamanho de @a buffer
+     */
+    static void formatLine(GameEventType type, char* buffer, std::size_t size);
+
+    /**
+     * Escreve a quantidade de eventos descartados pelo @a EventBus com a fila cheia (ex.: "DROPPED 0").
+     * @param buffer - recebe o texto
+     * @param size - tamanho de @a buffer
+     */
+    static void formatDropped(char* buffer, std::size_t size);
+
+    /**
+     * @param type - tipo do evento
+     * @return nome curto do tipo
+     */
+    static const char* name(GameEventType type);
+};
+
+#endif // EVENTBUS_H
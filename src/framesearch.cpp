@@ -0,0 +1,193 @@
+#include "framesearch.h"
+#include "appconfig.h"
+#include "app_state/game.h"
+#include "eventbus.h"
+#include "engine/engine.h"
+#include "engine/random.h"
+
+#include <algorithm>
+#include <climits>
+#include <iostream>
+#include <iomanip>
+#include <utility>
+#include <vector>
+
+Uint64 FrameSearch::m_random_state = 0;
+
+// Nomes das fases no relatório, na ordem de UpdatePhase
+static const char* const PHASE_NAMES[UP_COUNT] = {"entrada", "colisoes", "alvos", "temporizadores", "objetos", "retrocesso"};
+
+bool FrameSearch::run(unsigned rounds)
+{
+    Engine::getEngine().initModules();
+    Random::getInstance().seed(SDL_GetPerformanceCounter());
+    m_random_state = Random::getInstance().state();
+
+    // Melhor candidato de cada subida
+    std::vector<std::pair<Replay, Result>> climbs;
+    Replay current;
+    Result current_result = {};
+    int stale = RESTART_AFTER;
+
+    for(unsigned round = 0; round < rounds; round++)
+    {
+        Replay candidate;
+        bool restart = stale >= RESTART_AFTER;
+        if(restart)
+        {
+            if(round > 0) climbs.push_back({current, current_result});
+            int level = 1 + nextInt(35);
+            candidate.generate(level, 2, AppConfig::replay_ticks, nextInt(INT_MAX));
+            stale = 0;
+        }
+        else
+        {
+            candidate = current;
+            mutate(candidate);
+        }
+
+        Result result = measure(candidate);
+        if(restart || result.frame_us > current_result.frame_us)
+        {
+            if(!restart) stale = 0;
+            current = candidate;
+            current_result = result;
+            std::cout << std::fixed << std::setprecision(1) << "Avaliacao " << round + 1 << "/" << rounds << (restart ? " (recomeco)" : "")
+                      << ": rodada " << candidate.m_level << ", pior frame " << result.frame_us << " us no tick " << result.tick << "\n";
+        }
+        else
+            stale++;
+    }
+    if(rounds > 0) climbs.push_back({current, current_result});
+
+    std::sort(climbs.begin(), climbs.end(), [](const std::pair<Replay, Result>& a, const std::pair<Replay, Result>& b)
+    {
+        return a.second.frame_us > b.second.frame_us;
+    });
+
+    // Os replays guardam os hashes de cada tick: a cena pode ser reproduzida e conferida depois de otimizações
+    bool ok = true;
+    for(int i = 0; i < WORST_CASES && i < static_cast<int>(climbs.size()); i++)
+    {
+        Replay& replay = climbs[i].first;
+        std::string path = "worst_case_" + std::string(Engine::intToString(i + 1)) + ".rpl";
+        replay.record();
+        if(!replay.save(path))
+        {
+            std::cout << path << ": nao foi possivel gravar\n";
+            ok = false;
+            continue;
+        }
+        print(path, replay, climbs[i].second);
+    }
+
+    Engine::getEngine().destroyModules();
+    return ok;
+}
+
+FrameSearch::Result FrameSearch::measure(const Replay& replay)
+{
+    const int columns = UP_COUNT + 1; // fases de update e draw
+    std::vector<double> totals(replay.m_ticks, 0);
+    std::vector<double> parts(replay.m_ticks * columns, 0);
+    double frequency = SDL_GetPerformanceFrequency() / 1000000.0;
+    Uint64 phases[UP_COUNT];
+
+    for(int run = 0; run < 2; run++)
+    {
+        Random::getInstance().seed(replay.m_seed);
+        Game* game = new Game(replay.m_player_count, replay.m_level);
+        game->measurePhases(phases);
+
+        for(Uint32 t = 0; t < replay.m_ticks; t++)
+        {
+            for(auto& phase : phases) phase = 0;
+            game->setScriptedInput(replay.actions(t));
+            Uint64 start = SDL_GetPerformanceCounter();
+            game->update(replay.m_dt);
+            Uint64 middle = SDL_GetPerformanceCounter();
+            game->draw();
+            Uint64 end = SDL_GetPerformanceCounter();
+            EventBus::getInstance().clear();
+
+            double total = (end - start) / frequency;
+            if(run > 0 && total >= totals[t]) continue;
+            totals[t] = total;
+            for(int p = 0; p < UP_COUNT; p++) parts[t * columns + p] = phases[p] / frequency;
+            parts[t * columns + UP_COUNT] = (end - middle) / frequency;
+        }
+        delete game;
+    }
+
+    Result result = {};
+    for(Uint32 t = 0; t < replay.m_ticks; t++)
+    {
+        if(totals[t] <= result.frame_us) continue;
+        result.frame_us = totals[t];
+        result.tick = t;
+        for(int p = 0; p < UP_COUNT; p++) result.phase_us[p] = parts[t * columns + p];
+        result.draw_us = parts[t * columns + UP_COUNT];
+    }
+    return result;
+}
+
+// Trechos de 8 a 120 ticks: o bastante para levar um tanque até um bônus ou atravessar uma parede a tiros
+void FrameSearch::mutate(Replay& replay)
+{
+    static const Uint8 directions[] = {IA_NONE, IA_UP, IA_DOWN, IA_LEFT, IA_RIGHT};
+    replay.m_hashes.clear();
+
+    int operation = nextInt(4);
+    if(operation == 3)
+    {
+        // Mesma entrada com outra semente: outros inimigos, bônus e decisões da IA
+        replay.m_seed = nextInt(INT_MAX);
+        return;
+    }
+
+    int count = replay.m_player_count;
+    int player = nextInt(count);
+    Uint32 length = std::min<Uint32>(8 + nextInt(113), replay.m_ticks);
+    Uint32 start = nextInt(replay.m_ticks - length + 1);
+    Uint8* actions = replay.m_actions.data();
+    if(operation == 0)
+    {
+        // Nova direção mantida, atirando em ~1/4 dos ticks (como Replay::generate)
+        Uint8 direction = directions[nextInt(5)];
+        for(Uint32 t = start; t < start + length; t++)
+            actions[t * count + player] = direction | (nextInt(4) == 0 ? IA_FIRE : 0);
+    }
+    else if(operation == 1)
+    {
+        // Rajada: atira em todos os ticks do trecho
+        for(Uint32 t = start; t < start + length; t++) actions[t * count + player] |= IA_FIRE;
+    }
+    else
+    {
+        // Copia um trecho de outro momento (de qualquer jogador)
+        int source_player = nextInt(count);
+        Uint32 source = nextInt(replay.m_ticks - length + 1);
+        std::vector<Uint8> copy(length);
+        for(Uint32 i = 0; i < length; i++) copy[i] = actions[(source + i) * count + source_player];
+        for(Uint32 i = 0; i < length; i++) actions[(start + i) * count + player] = copy[i];
+    }
+}
+
+void FrameSearch::print(const std::string& label, const Replay& replay, const Result& result)
+{
+    std::cout << std::fixed << std::setprecision(1) << label << ": rodada " << replay.m_level << ", semente " << replay.m_seed
+              << ", tick " << result.tick << ", frame " << result.frame_us << " us (";
+    for(int p = 0; p < UP_COUNT; p++) std::cout << PHASE_NAMES[p] << " " << result.phase_us[p] << ", ";
+    std::cout << "desenho " << result.draw_us << ")\n";
+}
+
+int FrameSearch::nextInt(int max)
+{
+    Random& random = Random::getInstance();
+    Uint64 game_state = random.state();
+    random.setState(m_random_state);
+    int value = random.nextInt(max);
+    m_random_state = random.state();
+    random.setState(game_state);
+    return value;
+}
@@ -0,0 +1,76 @@
+#ifndef FRAMESEARCH_H
+#define FRAMESEARCH_H
+
+#include "replay.h"
+#include "type.h"
+
+#include <SDL2/SDL.h>
+#include <string>
+
+/**
+ * @brief
+ * Busca sem janela (opção --worst-case) das cenas com o frame mais lento (Game::update + Game::draw).
+ * Cada candidato é um replay (rodada, semente da simulação e entrada dos dois jogadores) avaliado pelo pior tick.
+ * A busca sobe a encosta: altera trechos da entrada (direções sorteadas, rajadas de tiros, trechos copiados) ou a
+ * semente e mantém a alteração se o pior tick piorar; sem melhora por algumas avaliações, recomeça de uma rodada e
+ * semente sorteadas. Os piores casos encontrados são gravados como replays (worst_case_N.rpl, verificáveis com
+ * --replay-verify arquivo) e exibidos no console com o tempo de cada fase do tick.
+ */
+class FrameSearch
+{
+public:
+    /**
+     * Executa a busca.
+     * @param rounds - quantidade de candidatos avaliados
+     * @return @a false se algum pior caso não puder ser gravado
+     */
+    static bool run(unsigned rounds);
+
+private:
+    static const int WORST_CASES = 3;       ///< Piores casos gravados (de subidas diferentes).
+    static const int RESTART_AFTER = 15;    ///< Avaliações sem melhora antes de recomeçar.
+
+    /**
+     * @brief Pior tick de um candidato e o tempo de cada fase nele, em microssegundos.
+     */
+    struct Result
+    {
+        double frame_us;            ///< update + draw.
+        Uint32 tick;                ///< Tick do pior frame.
+        double phase_us[UP_COUNT];  ///< Fases de update (@a UpdatePhase).
+        double draw_us;             ///< Game::draw.
+    };
+
+    /**
+     * Joga o replay duas vezes medindo cada tick; o tempo de cada tick é o da execução mais rápida, para que picos
+     * do sistema operacional não contem como cena lenta.
+     * @param replay - candidato
+     * @return pior tick
+     */
+    static Result measure(const Replay& replay);
+
+    /**
+     * Altera um trecho da entrada de um jogador ou a semente da simulação.
+     * @param replay - candidato alterado
+     */
+    static void mutate(Replay& replay);
+
+    /**
+     * Escreve o resultado no console.
+     * @param label - identificação do caso
+     * @param replay - candidato
+     * @param result - pior tick
+     */
+    static void print(const std::string& label, const Replay& replay, const Result& result);
+
+    /**
+     * Sorteios da busca, com estado próprio guardado entre as avaliações (cada partida reinicia o gerador da simulação).
+     * @param max - limite superior (exclusivo)
+     * @return inteiro em [0, max)
+     */
+    static int nextInt(int max);
+
+    static Uint64 m_random_state;   ///< Estado do gerador da busca.
+};
+
+#endif // FRAMESEARCH_H
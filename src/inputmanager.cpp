@@ -0,0 +1,296 @@
+#include "inputmanager.h"
+#include "appconfig.h"
+
+#include <iostream>
+#include <iomanip>
+
+// Retorna a instância única do gerenciador de entrada
+InputManager& InputManager::getInstance()
+{
+    static InputManager instance;
+    return instance;
+}
+
+// Intervalos do histograma de latência: 0.1 ms cada, até 250 ms
+static const unsigned LATENCY_BUCKETS = 2500;
+static const double LATENCY_BUCKET_MS = 0.1;
+
+// Abre todos os controles conectados e registra a captura de eventos
+void InputManager::init()
+{
+    int num_joysticks = SDL_NumJoysticks();
+    for(int i = 0; i < num_joysticks; i++)
+        openController(i);
+
+    if(AppConfig::measure_input_latency)
+        m_latency_histogram.assign(LATENCY_BUCKETS, 0);
+
+    SDL_AddEventWatch(eventWatch, this);
+}
+
+// Remove a captura de eventos e fecha todos os controles abertos
+void InputManager::cleanup()
+{
+    SDL_DelEventWatch(eventWatch, this);
+
+    if(AppConfig::measure_input_latency)
+        printLatencyReport();
+
+    for(auto controller : m_controllers)
+        if(controller != nullptr) SDL_GameControllerClose(controller);
+    m_controllers.clear();
+    m_instance_ids.clear();
+    m_latched_buttons.clear();
+}
+
+// Atualiza o cache de controles quando um dispositivo é conectado ou removido
+void InputManager::eventProcess(SDL_Event *ev)
+{
+    if(ev->type == SDL_CONTROLLERDEVICEADDED)
+        openController(ev->cdevice.which);
+    else if(ev->type == SDL_CONTROLLERDEVICEREMOVED)
+        closeController(ev->cdevice.which);
+}
+
+// Retorna o controle do slot informado (ou nullptr)
+SDL_GameController* InputManager::getController(int slot) const
+{
+    if(slot < 0 || slot >= static_cast<int>(m_controllers.size())) return nullptr;
+    return m_controllers[slot];
+}
+
+// Verifica se há um controle conectado no slot
+bool InputManager::isControllerActive(int slot) const
+{
+    return getController(slot) != nullptr;
+}
+
+// Conta os slots ocupados
+int InputManager::controllerCount() const
+{
+    int count = 0;
+    for(auto controller : m_controllers)
+        if(controller != nullptr) count++;
+    return count;
+}
+
+// Abre um controle e o coloca no primeiro slot livre
+void InputManager::openController(int device_index)
+{
+    if(!SDL_IsGameController(device_index)) return;
+
+    SDL_GameController* controller = SDL_GameControllerOpen(device_index);
+    if(controller == nullptr) return;
+
+    SDL_JoystickID id = SDL_JoystickInstanceID(SDL_GameControllerGetJoystick(controller));
+    for(unsigned i = 0; i < m_controllers.size(); i++)
+    {
+        // O SDL também envia SDL_CONTROLLERDEVICEADDED para os controles já abertos em init()
+        if(m_controllers[i] != nullptr && m_instance_ids[i] == id)
+        {
+            SDL_GameControllerClose(controller); // apenas decrementa a contagem de referências
+            return;
+        }
+    }
+
+    for(unsigned i = 0; i < m_controllers.size(); i++)
+    {
+        if(m_controllers[i] == nullptr)
+        {
+            m_controllers[i] = controller;
+            m_instance_ids[i] = id;
+            m_latched_buttons[i] = 0;
+            return;
+        }
+    }
+    m_controllers.push_back(controller);
+    m_instance_ids.push_back(id);
+    m_latched_buttons.push_back(0);
+}
+
+// Fecha o controle removido e libera seu slot
+void InputManager::closeController(SDL_JoystickID instance_id)
+{
+    for(unsigned i = 0; i < m_controllers.size(); i++)
+    {
+        if(m_controllers[i] != nullptr && m_instance_ids[i] == instance_id)
+        {
+            SDL_GameControllerClose(m_controllers[i]);
+            m_controllers[i] = nullptr;
+            m_instance_ids[i] = -1;
+        }
+    }
+}
+
+// Gera a máscara de ações do jogador a partir de teclado e controle
+Uint8 InputManager::sampleActions(const Player::PlayerKeys& keys, int slot) const
+{
+    const Uint8 move_mask = IA_UP | IA_DOWN | IA_LEFT | IA_RIGHT;
+    Uint8 actions = IA_NONE;
+
+    if(keys.type == Player::InputType::Keyboard || keys.type == Player::InputType::Hybrid)
+        actions |= sampleKeyboard(keys);
+
+    if(keys.type == Player::InputType::Controller ||
+       (keys.type == Player::InputType::Hybrid && (actions & move_mask) == 0))
+    {
+        SDL_GameController* controller = getController(slot);
+        if(controller != nullptr)
+        {
+            Sint16 deadzone = keys.type == Player::InputType::Controller ? Player::ANALOG_DEADZONE_CONTROLLER
+                                                                          : Player::ANALOG_DEADZONE_HYBRID;
+            actions |= sampleController(keys, controller, deadzone);
+        }
+    }
+    return actions;
+}
+
+// Lê as teclas de direção e disparo do jogador
+Uint8 InputManager::sampleKeyboard(const Player::PlayerKeys& keys) const
+{
+    const Uint8 *key_state = SDL_GetKeyboardState(NULL);
+    if(key_state == nullptr) return IA_NONE;
+
+    Uint8 actions = IA_NONE;
+    // Tecla pressionada agora ou pressionada (e talvez já solta) desde o último tick
+    if(key_state[keys.up] || m_latched_keys[keys.up]) actions |= IA_UP;
+    if(key_state[keys.down] || m_latched_keys[keys.down]) actions |= IA_DOWN;
+    if(key_state[keys.left] || m_latched_keys[keys.left]) actions |= IA_LEFT;
+    if(key_state[keys.right] || m_latched_keys[keys.right]) actions |= IA_RIGHT;
+    if(key_state[keys.fire] || m_latched_keys[keys.fire]) actions |= IA_FIRE;
+    return actions;
+}
+
+// Lê analógicos ou D-pad e o botão de disparo
+Uint8 InputManager::sampleController(const Player::PlayerKeys& keys, SDL_GameController* controller, Sint16 deadzone) const
+{
+    Uint8 actions = IA_NONE;
+
+    // Botões pressionados desde o último tick
+    Uint32 latched = 0;
+    for(unsigned i = 0; i < m_controllers.size(); i++)
+        if(m_controllers[i] == controller) latched = m_latched_buttons[i];
+    auto pressed = [&](int button) {
+        return (latched & (1u << button)) || SDL_GameControllerGetButton(controller, SDL_GameControllerButton(button));
+    };
+
+    if(keys.axis_up < 0 || keys.axis_down < 0 || keys.axis_left < 0 || keys.axis_right < 0)
+    {
+        // Analógico esquerdo
+        Sint16 axis_y = SDL_GameControllerGetAxis(controller, SDL_CONTROLLER_AXIS_LEFTY);
+        Sint16 axis_x = SDL_GameControllerGetAxis(controller, SDL_CONTROLLER_AXIS_LEFTX);
+        if(axis_y < -deadzone) actions |= IA_UP;
+        else if(axis_y > deadzone) actions |= IA_DOWN;
+        if(axis_x < -deadzone) actions |= IA_LEFT;
+        else if(axis_x > deadzone) actions |= IA_RIGHT;
+    }
+    else
+    {
+        // D-pad (botões)
+        if(pressed(keys.axis_up)) actions |= IA_UP;
+        if(pressed(keys.axis_down)) actions |= IA_DOWN;
+        if(pressed(keys.axis_left)) actions |= IA_LEFT;
+        if(pressed(keys.axis_right)) actions |= IA_RIGHT;
+    }
+
+    if(keys.button_fire >= 0 && pressed(keys.button_fire))
+        actions |= IA_FIRE;
+    return actions;
+}
+
+// Captura pressionamentos assim que o SDL os recebe e os publica na fila
+int SDLCALL InputManager::eventWatch(void* userdata, SDL_Event* ev)
+{
+    InputManager* manager = static_cast<InputManager*>(userdata);
+    InputEvent input;
+    if(ev->type == SDL_KEYDOWN && ev->key.repeat == 0)
+    {
+        input.scancode = ev->key.keysym.scancode;
+        input.which = -1;
+        input.button = 0;
+    }
+    else if(ev->type == SDL_CONTROLLERBUTTONDOWN)
+    {
+        input.scancode = SDL_SCANCODE_UNKNOWN;
+        input.which = ev->cbutton.which;
+        input.button = ev->cbutton.button;
+    }
+    else return 0;
+
+    input.timestamp = SDL_GetPerformanceCounter();
+    manager->m_events.push(input); // fila cheia: o estado atual do dispositivo ainda é lido no tick
+    return 0;
+}
+
+// Consome os eventos anteriores ao início do tick e retém os pressionamentos
+void InputManager::beginTick()
+{
+    for(auto& key : m_latched_keys) key = false;
+    for(auto& buttons : m_latched_buttons) buttons = 0;
+    // Os carimbos acumulam até framePresented(): no modo turbo um frame tem vários ticks
+
+    Uint64 tick_start = SDL_GetPerformanceCounter();
+    InputEvent input;
+    while(m_events.peek(input) && input.timestamp <= tick_start)
+    {
+        m_events.pop(input);
+        if(input.which < 0)
+            m_latched_keys[input.scancode] = true;
+        else
+        {
+            for(unsigned i = 0; i < m_controllers.size(); i++)
+                if(m_controllers[i] != nullptr && m_instance_ids[i] == input.which)
+                    m_latched_buttons[i] |= 1u << input.button;
+        }
+
+        if(m_tick_timestamp_count < sizeof(m_tick_timestamps) / sizeof(m_tick_timestamps[0]))
+            m_tick_timestamps[m_tick_timestamp_count++] = input.timestamp;
+    }
+}
+
+// Registra a latência dos eventos do tick após a apresentação do frame
+void InputManager::framePresented()
+{
+    if(m_latency_histogram.empty())
+    {
+        m_tick_timestamp_count = 0;
+        return;
+    }
+
+    Uint64 now = SDL_GetPerformanceCounter();
+    double ticks_per_ms = SDL_GetPerformanceFrequency() / 1000.0;
+    for(unsigned i = 0; i < m_tick_timestamp_count; i++)
+    {
+        double latency = (now - m_tick_timestamps[i]) / ticks_per_ms;
+        unsigned bucket = static_cast<unsigned>(latency / LATENCY_BUCKET_MS);
+        if(bucket >= LATENCY_BUCKETS) bucket = LATENCY_BUCKETS - 1;
+        m_latency_histogram[bucket]++;
+        m_latency_samples++;
+        if(latency > m_latency_max) m_latency_max = latency;
+    }
+    m_tick_timestamp_count = 0;
+}
+
+// Escreve os percentis da latência entrada-apresentação
+void InputManager::printLatencyReport() const
+{
+    std::cout << "Latencia entrada-apresentacao: " << m_latency_samples << " eventos\n";
+    if(m_latency_samples == 0) return;
+
+    const double percentiles[] = {0.50, 0.90, 0.99};
+    const char* names[] = {"p50", "p90", "p99"};
+    for(int p = 0; p < 3; p++)
+    {
+        Uint64 target = static_cast<Uint64>(percentiles[p] * m_latency_samples);
+        Uint64 accumulated = 0;
+        unsigned bucket = 0;
+        for(; bucket < m_latency_histogram.size(); bucket++)
+        {
+            accumulated += m_latency_histogram[bucket];
+            if(accumulated > target) break;
+        }
+        std::cout << "  " << names[p] << ": " << std::fixed << std::setprecision(1)
+                  << (bucket + 1) * LATENCY_BUCKET_MS << " ms\n";
+    }
+    std::cout << "  max: " << std::fixed << std::setprecision(1) << m_latency_max << " ms\n";
+}
@@ -0,0 +1,197 @@
+#ifndef INPUTMANAGER_H
+#define INPUTMANAGER_H
+
+#include "objects/player.h"
+#include "engine/spscqueue.h"
+#include "type.h"
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+/**
+ * @brief
+ * Classe responsável por centralizar o acesso aos dispositivos de entrada (controles).
+ * Os controles são abertos uma única vez e mantidos em cache; conexões e desconexões
+ * são acompanhadas pelos eventos SDL_CONTROLLERDEVICEADDED/REMOVED, evitando
+ * enumerar os dispositivos a cada frame.
+ * Também converte o estado dos dispositivos em máscaras de ações (InputAction) por tick.
+ *
+ * Pressionamentos de teclas e botões são capturados por um SDL_AddEventWatch no momento
+ * em que o SDL recebe o evento, recebem um carimbo de tempo de alta resolução e passam por
+ * uma fila sem travas até o início do próximo tick (beginTick), onde ficam retidos durante o tick.
+ * Assim um toque mais curto que um frame não é perdido.
+ */
+class InputManager
+{
+public:
+    /**
+     * Retorna a instância única do gerenciador de entrada (Singleton).
+     * @return referência para o InputManager
+     */
+    static InputManager& getInstance();
+
+    /**
+     * Abre todos os controles já conectados.
+     * Deve ser chamada após SDL_Init com SDL_INIT_GAMECONTROLLER.
+     */
+    void init();
+
+    /**
+     * Fecha todos os controles abertos. Deve ser chamada antes de SDL_Quit.
+     */
+    void cleanup();
+
+    /**
+     * Processa eventos de conexão e desconexão de controles.
+     * Outros tipos de evento são ignorados.
+     * @param ev - ponteiro para o evento SDL
+     */
+    void eventProcess(SDL_Event* ev);
+
+    /**
+     * Retorna o controle associado a um slot.
+     * Os slots seguem a ordem de conexão e são preservados quando um controle é desconectado,
+     * de modo que o controle 1 não assume o lugar do controle 0.
+     * @param slot - índice do controle físico
+     * @return ponteiro para o controle ou nullptr se o slot estiver vazio
+     */
+    SDL_GameController* getController(int slot) const;
+
+    /**
+     * Verifica se existe um controle conectado no slot.
+     * @param slot - índice do controle físico
+     * @return true se o controle estiver conectado
+     */
+    bool isControllerActive(int slot) const;
+
+    /**
+     * Retorna a quantidade de controles conectados no momento.
+     * @return número de controles conectados
+     */
+    int controllerCount() const;
+
+    /**
+     * Amostra os dispositivos de um jogador (teclado e/ou controle) e gera a máscara de ações do tick.
+     * No modo híbrido o teclado tem prioridade: o controle só é lido se nenhuma direção foi pressionada no teclado.
+     * @param keys - configuração de teclas/controle do jogador
+     * @param slot - índice do controle físico do jogador
+     * @return máscara de bits com valores de InputAction
+     */
+    Uint8 sampleActions(const Player::PlayerKeys& keys, int slot) const;
+
+    /**
+     * Inicia um tick de simulação: consome da fila os eventos com carimbo de tempo
+     * anterior ao início do tick e retém os pressionamentos até o próximo beginTick().
+     */
+    void beginTick();
+
+    /**
+     * Informa que o frame foi apresentado na tela.
+     * No modo de medição (AppConfig::measure_input_latency) registra a latência
+     * entre cada evento consumido nos ticks do frame e a apresentação.
+     */
+    void framePresented();
+
+    /**
+     * Escreve na saída padrão a distribuição da latência entrada-apresentação (p50, p90, p99 e máximo).
+     */
+    void printLatencyReport() const;
+
+private:
+    /**
+     * @brief Evento de entrada com carimbo de tempo de alta resolução.
+     */
+    struct InputEvent
+    {
+        Uint64 timestamp;       ///< Valor de SDL_GetPerformanceCounter() na captura.
+        SDL_Scancode scancode;  ///< Tecla pressionada (SDL_SCANCODE_UNKNOWN para controles).
+        SDL_JoystickID which;   ///< Instância do controle (-1 para teclado).
+        Uint8 button;           ///< Botão do controle pressionado.
+    };
+
+    /**
+     * Callback registrado com SDL_AddEventWatch; executa no contexto em que o SDL recebe o evento.
+     * Apenas publica o evento na fila, sem tocar no estado do jogo.
+     * @param userdata - ponteiro para o InputManager
+     * @param ev - evento recebido
+     * @return sempre 0 (o evento segue para a fila do SDL normalmente)
+     */
+    static int SDLCALL eventWatch(void* userdata, SDL_Event* ev);
+
+
+    InputManager() = default;
+    ~InputManager() = default;
+    InputManager(const InputManager&) = delete;
+    InputManager& operator=(const InputManager&) = delete;
+
+    /**
+     * Abre o controle com índice de dispositivo @a device_index e o coloca no primeiro slot livre.
+     * Ignora o dispositivo se ele já estiver aberto.
+     * @param device_index - índice do dispositivo (SDL_CONTROLLERDEVICEADDED)
+     */
+    void openController(int device_index);
+
+    /**
+     * Fecha o controle com o identificador de instância informado e libera seu slot.
+     * @param instance_id - identificador de instância (SDL_CONTROLLERDEVICEREMOVED)
+     */
+    void closeController(SDL_JoystickID instance_id);
+
+    /**
+     * Lê as teclas do jogador no estado atual do teclado.
+     * @param keys - configuração de teclas do jogador
+     * @return máscara de bits com valores de InputAction
+     */
+    Uint8 sampleKeyboard(const Player::PlayerKeys& keys) const;
+
+    /**
+     * Lê analógicos ou D-pad e o botão de disparo do controle.
+     * Valores negativos em @a keys.axis_* indicam uso do analógico esquerdo.
+     * @param keys - configuração de controle do jogador
+     * @param controller - controle aberto do jogador
+     * @param deadzone - zona morta do analógico
+     * @return máscara de bits com valores de InputAction
+     */
+    Uint8 sampleController(const Player::PlayerKeys& keys, SDL_GameController* controller, Sint16 deadzone) const;
+
+    /**
+     * Controles abertos, indexados pelo slot. Slots vazios contêm nullptr.
+     */
+    std::vector<SDL_GameController*> m_controllers;
+
+    /**
+     * Identificadores de instância dos controles, na mesma ordem de @a m_controllers.
+     */
+    std::vector<SDL_JoystickID> m_instance_ids;
+
+    /**
+     * Botões retidos no tick atual, um bit por SDL_GameControllerButton, na mesma ordem de @a m_controllers.
+     */
+    std::vector<Uint32> m_latched_buttons;
+
+    /**
+     * Teclas pressionadas desde o último tick, indexadas pelo scancode.
+     */
+    bool m_latched_keys[SDL_NUM_SCANCODES] = {};
+
+    /**
+     * Fila de eventos entre o callback do SDL (produtor) e beginTick() (consumidor).
+     */
+    SpscQueue<InputEvent, 256> m_events;
+
+    /**
+     * Carimbos de tempo dos eventos consumidos nos ticks do frame atual (medição de latência).
+     */
+    Uint64 m_tick_timestamps[64];
+    unsigned m_tick_timestamp_count = 0;
+
+    /**
+     * Histograma da latência entrada-apresentação, em intervalos de 0.1 ms.
+     * Alocado apenas no modo de medição; o último intervalo acumula valores acima do limite.
+     */
+    std::vector<Uint32> m_latency_histogram;
+    double m_latency_max = 0.0;
+    Uint64 m_latency_samples = 0;
+};
+
+#endif // INPUTMANAGER_H
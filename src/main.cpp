@@ -10,11 +10,39 @@
  */
 
 #include "app.h"
+#include "appconfig.h"
+#include "replay.h"
+#include "benchmark.h"
+#include "framesearch.h"
+#include "soak.h"
+#include "engine/jobsystem.h"
 
 // Função principal do programa.
 // Inicializa a aplicação e executa o loop principal do jogo.
 int main(int argc, char* args[])
 {
+    // Lê as opções de linha de comando
+    AppConfig::parseArguments(argc, args);
+
+    // Threads das fases paralelas da partida (em todos os modos, inclusive replays e medições)
+    JobSystem::getInstance().start(AppConfig::threads);
+
+    // Replays de regressão: executados sem janela, o código de saída indica o resultado
+    if(AppConfig::replay_verify || AppConfig::replay_generate)
+        return Replay::runSuite(AppConfig::replays_path, AppConfig::replay_generate) ? 0 : 1;
+
+    // Medições de desempenho sem janela
+    if(AppConfig::benchmark)
+        return Benchmark::run(AppConfig::benchmark_iterations) ? 0 : 1;
+
+    // Busca dos frames mais lentos sem janela
+    if(AppConfig::worst_case)
+        return FrameSearch::run(AppConfig::worst_case_rounds) ? 0 : 1;
+
+    // Teste de longa duração sem janela
+    if(AppConfig::soak)
+        return Soak::run(AppConfig::soak_minutes) ? 0 : 1;
+
     // Cria a instância principal da aplicação
     App app;
     // Inicia o loop principal do jogo
@@ -5,16 +5,18 @@
 Bonus::Bonus()
     : Object(0, 0, ST_BONUS_STAR)
 {
-    m_bonus_show_time = 0; // Tempo de exibição do bônus começa em 0
-    m_show = true;         // O bônus começa visível
+    startTimer(TI_BONUS_SHOW, AppConfig::bonus_show_time); // Tempo de exibição do bônus
+    startTimer(TI_BONUS_BLINK, AppConfig::bonus_blink_time); // Primeira troca do piscar
+    m_show = false;        // O bônus começa apagado e pisca
 }
 
 // Construtor parametrizado: inicializa o bônus na posição (x, y) e com o tipo especificado
-Bonus::Bonus(double x, double y, SpriteType type)
+Bonus::Bonus(Fixed x, Fixed y, SpriteType type)
     : Object(x, y, type)
 {
-    m_bonus_show_time = 0; // Tempo de exibição do bônus começa em 0
-    m_show = true;         // O bônus começa visível
+    startTimer(TI_BONUS_SHOW, AppConfig::bonus_show_time); // Tempo de exibição do bônus
+    startTimer(TI_BONUS_BLINK, AppConfig::bonus_blink_time); // Primeira troca do piscar
+    m_show = false;        // O bônus começa apagado e pisca
 }
 
 // Desenha o bônus na tela se ele estiver visível
@@ -23,21 +25,34 @@ void Bonus::draw()
     if(m_show) Object::draw(); // Chama o método de desenho da classe base se m_show for verdadeiro
 }
 
-// Atualiza o estado do bônus
-void Bonus::update(Uint32 dt)
+// Fim do tempo de exibição ou troca do piscar
+void Bonus::onTimer(int timer_id)
 {
-    Object::update(dt); // Atualiza o estado base do objeto
-
-    m_bonus_show_time += dt; // Incrementa o tempo de exibição do bônus
-
-    // Se o tempo de exibição excedeu o limite configurado, marca para remoção
-    if(m_bonus_show_time > AppConfig::bonus_show_time)
+    if(timer_id == TI_BONUS_SHOW)
+    {
+        // Tempo de exibição esgotado: marca para remoção
         to_erase = true;
+        stopTimer(TI_BONUS_BLINK);
+    }
+    else if(timer_id == TI_BONUS_BLINK)
+    {
+        // Nos primeiros 3/4 do tempo, pisca mais devagar; no último 1/4, pisca mais rápido
+        m_show = !m_show;
+        Uint32 show_time = AppConfig::bonus_show_time - timerRemaining(TI_BONUS_SHOW);
+        startTimer(TI_BONUS_BLINK, show_time < AppConfig::bonus_show_time / 4 * 3 ? AppConfig::bonus_blink_time : AppConfig::bonus_blink_time / 2);
+    }
+}
 
-    // Controla o efeito de "piscar" do bônus:
-    // Nos primeiros 3/4 do tempo, pisca mais devagar; no último 1/4, pisca mais rápido
-    if(m_bonus_show_time / (m_bonus_show_time < AppConfig::bonus_show_time / 4 * 3 ? AppConfig::bonus_blink_time : AppConfig::bonus_blink_time / 2) % 2)
-        m_show = true;
-    else
-        m_show = false;
+void Bonus::saveState(StateWriter &out) const
+{
+    Object::saveState(out);
+    saveTimers(out);
+    out.write(m_show);
+}
+
+void Bonus::loadState(StateReader &in)
+{
+    Object::loadState(in);
+    loadTimers(in);
+    in.read(m_show);
 }
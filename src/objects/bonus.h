@@ -2,12 +2,14 @@
 #define BONUS_H
 
 #include "object.h"
+#include "../engine/timerwheel.h"
 
 /**
  * @brief Classe responsável por exibir e gerenciar o bônus no jogo.
- * Herda de Object e adiciona lógica de tempo de exibição e piscar.
+ * Herda de Object e adiciona lógica de tempo de exibição (temporizador TI_BONUS_SHOW) e piscar (TI_BONUS_BLINK).
+ * O bônus é estático: não é atualizado a cada tick, apenas quando um dos temporizadores expira.
  */
-class Bonus : public Object
+class Bonus : public Object, public TimerListener
 {
 public:
     /**
@@ -22,7 +24,21 @@ public:
      * @param y - posição vertical inicial do bônus
      * @param type - tipo do bônus (ex: estrela, granada, capacete, etc)
      */
-    Bonus(double x, double y, SpriteType type);
+    Bonus(Fixed x, Fixed y, SpriteType type);
+
+    /**
+     * Bônus aparecem e somem durante a rodada: a memória é reaproveitada (@a RecyclingAllocator).
+     */
+    static void* operator new(std::size_t size)
+    {
+        MemoryStats::allocated(MT_BONUSES, size);
+        return RecyclingAllocator<Bonus>::allocate(size);
+    }
+    static void operator delete(void* memory, std::size_t size)
+    {
+        MemoryStats::released(MT_BONUSES, size);
+        RecyclingAllocator<Bonus>::release(memory, size);
+    }
 
     /**
      * Desenha o bônus na tela, se estiver visível.
@@ -31,20 +47,25 @@ public:
     void draw();
 
     /**
-     * Atualiza a animação e o estado do bônus.
-     * Controla o tempo de exibição, define quando o bônus deve ser removido
-     * e aumenta a frequência do piscar quando está próximo de sumir.
-     * @param dt - tempo (em ms) desde a última atualização
+     * Marca o bônus para remoção quando o tempo de exibição termina (TI_BONUS_SHOW) ou alterna a visibilidade (TI_BONUS_BLINK),
+     * piscando mais rápido no último quarto do tempo de exibição.
+     * @param timer_id - temporizador que expirou
      */
-    void update(Uint32 dt);
+    void onTimer(int timer_id);
 
-private:
     /**
-     * Tempo (em ms) desde a criação do bônus.
-     * Usado para controlar duração e frequência do piscar.
+     * Salva o estado do bônus (tempo de exibição e visibilidade).
+     * @param out - escritor do buffer de estado
      */
-    Uint32 m_bonus_show_time;
+    void saveState(StateWriter& out) const;
 
+    /**
+     * Restaura o estado salvo por saveState().
+     * @param in - leitor do buffer de estado
+     */
+    void loadState(StateReader& in);
+
+private:
     /**
      * Indica se o bônus está visível no momento.
      * Usado para efeito de piscar antes de sumir.
@@ -1,5 +1,5 @@
 #include "brick.h"
-#include "../soundmanager.h"
+#include "../eventbus.h"
 #include <iostream>
 
 // Construtor padrão: inicializa o tijolo na posição (0,0) com sprite de parede de tijolo
@@ -11,7 +11,7 @@ Brick::Brick()
 }
 
 // Construtor parametrizado: inicializa o tijolo na posição (x, y)
-Brick::Brick(double x, double y)
+Brick::Brick(Fixed x, Fixed y)
     : Object(x, y, ST_BRICK_WALL)
 {
     m_collision_count = 0; // contador de colisões começa em 0
@@ -26,11 +26,7 @@ void Brick::update(Uint32 dt)
 // Função chamada quando o tijolo é atingido por um tiro
 void Brick::bulletHit(Direction bullet_direction)
 {
-    // sound
-    SoundManager::getInstance().playSound("brick_hit");
-    if (type == ST_STONE_WALL) {
-        SoundManager::getInstance().playSound("steelhit");
-    }
+    EventBus::getInstance().emit(GE_BRICK_HIT, type, pos_x.toInt(), pos_y.toInt());
 
     int bd = bullet_direction;
     m_collision_count++; // incrementa o número de colisões
@@ -47,7 +43,7 @@ void Brick::bulletHit(Direction bullet_direction)
         if(sum_square % 2 == 1)
         {
             // Calcula novo código de estado para casos de colisão em cantos
-            m_state_code = ((double)sum_square + 19.0) / 4.0;
+            m_state_code = (sum_square + 19) / 4;
         }
         else
         {
@@ -67,50 +63,50 @@ void Brick::bulletHit(Direction bullet_direction)
     switch(m_state_code)
     {
     case 1: // Metade superior
-        collision_rect.x = pos_x;
-        collision_rect.y = pos_y;
+        collision_rect.x = pos_x.toInt();
+        collision_rect.y = pos_y.toInt();
         collision_rect.h = m_sprite->rect.h / 2;
         collision_rect.w = m_sprite->rect.w;
         break;
     case 2: // Metade direita
-        collision_rect.x = pos_x + m_sprite->rect.w / 2;
-        collision_rect.y = pos_y;
+        collision_rect.x = pos_x.toInt() + m_sprite->rect.w / 2;
+        collision_rect.y = pos_y.toInt();
         collision_rect.h = m_sprite->rect.h;
         collision_rect.w = m_sprite->rect.w / 2;
         break;
     case 3: // Metade inferior
-        collision_rect.x = pos_x;
-        collision_rect.y = pos_y +  m_sprite->rect.h / 2;
+        collision_rect.x = pos_x.toInt();
+        collision_rect.y = pos_y.toInt() +  m_sprite->rect.h / 2;
         collision_rect.h = m_sprite->rect.h / 2;
         collision_rect.w = m_sprite->rect.w;
         break;
     case 4: // Metade esquerda
-        collision_rect.x = pos_x;
-        collision_rect.y = pos_y;
+        collision_rect.x = pos_x.toInt();
+        collision_rect.y = pos_y.toInt();
         collision_rect.h = m_sprite->rect.h;
         collision_rect.w = m_sprite->rect.w / 2;
         break;
     case 5: // Quarto superior direito
-        collision_rect.x = pos_x + m_sprite->rect.w / 2;
-        collision_rect.y = pos_y;
+        collision_rect.x = pos_x.toInt() + m_sprite->rect.w / 2;
+        collision_rect.y = pos_y.toInt();
         collision_rect.h = m_sprite->rect.h / 2;
         collision_rect.w = m_sprite->rect.w / 2;
         break;
     case 6: // Quarto inferior direito
-        collision_rect.x = pos_x + m_sprite->rect.w / 2;
-        collision_rect.y = pos_y + m_sprite->rect.h / 2;
+        collision_rect.x = pos_x.toInt() + m_sprite->rect.w / 2;
+        collision_rect.y = pos_y.toInt() + m_sprite->rect.h / 2;
         collision_rect.h = m_sprite->rect.h / 2;
         collision_rect.w = m_sprite->rect.w / 2;
         break;
     case 7: // Quarto superior esquerdo
-        collision_rect.x = pos_x;
-        collision_rect.y = pos_y;
+        collision_rect.x = pos_x.toInt();
+        collision_rect.y = pos_y.toInt();
         collision_rect.h = m_sprite->rect.h / 2;
         collision_rect.w = m_sprite->rect.w / 2;
         break;
     case 8: // Quarto inferior esquerdo
-        collision_rect.x = pos_x;
-        collision_rect.y = pos_y + m_sprite->rect.h / 2;
+        collision_rect.x = pos_x.toInt();
+        collision_rect.y = pos_y.toInt() + m_sprite->rect.h / 2;
         collision_rect.h = m_sprite->rect.h / 2;
         collision_rect.w = m_sprite->rect.w / 2;
         break;
@@ -125,3 +121,17 @@ void Brick::bulletHit(Direction bullet_direction)
     // Atualiza o retângulo fonte do sprite de acordo com o estado
     src_rect = moveRect(m_sprite->rect, 0, m_state_code);
 }
+
+void Brick::saveState(StateWriter &out) const
+{
+    Object::saveState(out);
+    out.write(m_collision_count);
+    out.write(m_state_code);
+}
+
+void Brick::loadState(StateReader &in)
+{
+    Object::loadState(in);
+    in.read(m_collision_count);
+    in.read(m_state_code);
+}
@@ -21,7 +21,7 @@ public:
      * @param x - posição horizontal inicial do tijolo
      * @param y - posição vertical inicial do tijolo
      */
-    Brick(double x, double y);
+    Brick(Fixed x, Fixed y);
 
     /**
      * Atualiza o estado do tijolo.
@@ -38,6 +38,18 @@ public:
      */
     void bulletHit(Direction bullet_direction);
 
+    /**
+     * Salva o estado do tijolo, incluindo o código de dano.
+     * @param out - escritor do buffer de estado
+     */
+    void saveState(StateWriter& out) const;
+
+    /**
+     * Restaura o estado salvo por saveState().
+     * @param in - leitor do buffer de estado
+     */
+    void loadState(StateReader& in);
+
 private:
     /**
      * Número de vezes que o tijolo foi atingido por projéteis.
@@ -5,17 +5,17 @@
 Bullet::Bullet()
     : Object(0, 0, ST_BULLET)
 {
-    speed = 0.0;
+    speed = 0;
     direction = D_UP;
     increased_damage = false;
     collide = false;
 }
 
 // Construtor parametrizado: inicializa o projétil na posição (x, y) com sprite padrão
-Bullet::Bullet(double x, double y)
+Bullet::Bullet(Fixed x, Fixed y)
     : Object(x, y, ST_BULLET)
 {
-    speed = 0.0;
+    speed = 0;
     direction = D_UP;
     increased_damage = false;
     collide = false;
@@ -85,20 +85,20 @@ void Bullet::destroy()
     switch(direction)
     {
     case D_UP:
-        dest_rect.x = pos_x + (dest_rect.w - m_sprite->rect.w) / 2; // dest_rect.w, dest_rect.h - tamanho antigo do projétil
-        dest_rect.y = pos_y - m_sprite->rect.h / 2;
+        dest_rect.x = pos_x.toInt() + (dest_rect.w - m_sprite->rect.w) / 2; // dest_rect.w, dest_rect.h - tamanho antigo do projétil
+        dest_rect.y = pos_y.toInt() - m_sprite->rect.h / 2;
         break;
     case D_RIGHT:
-        dest_rect.x = pos_x + dest_rect.w - m_sprite->rect.w / 2;
-        dest_rect.y = pos_y + (dest_rect.h - m_sprite->rect.h) / 2;
+        dest_rect.x = pos_x.toInt() + dest_rect.w - m_sprite->rect.w / 2;
+        dest_rect.y = pos_y.toInt() + (dest_rect.h - m_sprite->rect.h) / 2;
         break;
     case D_DOWN:
-        dest_rect.x = pos_x + (dest_rect.w - m_sprite->rect.w) / 2;
-        dest_rect.y = pos_y + dest_rect.h - m_sprite->rect.h / 2;
+        dest_rect.x = pos_x.toInt() + (dest_rect.w - m_sprite->rect.w) / 2;
+        dest_rect.y = pos_y.toInt() + dest_rect.h - m_sprite->rect.h / 2;
         break;
     case D_LEFT:
-        dest_rect.x = pos_x - m_sprite->rect.w / 2;
-        dest_rect.y = pos_y + (dest_rect.h - m_sprite->rect.h) / 2;
+        dest_rect.x = pos_x.toInt() - m_sprite->rect.w / 2;
+        dest_rect.y = pos_y.toInt() + (dest_rect.h - m_sprite->rect.h) / 2;
         break;
     }
 
@@ -113,3 +113,21 @@ void Bullet::destroy()
     src_rect.w = m_sprite->rect.w;
 
 }
+
+void Bullet::saveState(StateWriter &out) const
+{
+    Object::saveState(out);
+    out.write(speed);
+    out.write(collide);
+    out.write(increased_damage);
+    out.write(direction);
+}
+
+void Bullet::loadState(StateReader &in)
+{
+    Object::loadState(in);
+    in.read(speed);
+    in.read(collide);
+    in.read(increased_damage);
+    in.read(direction);
+}
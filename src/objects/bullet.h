@@ -21,7 +21,21 @@ public:
      * @param x - posição horizontal inicial do projétil
      * @param y - posição vertical inicial do projétil
      */
-    Bullet(double x, double y);
+    Bullet(Fixed x, Fixed y);
+
+    /**
+     * Projéteis são criados a cada disparo: a memória é reaproveitada (@a RecyclingAllocator).
+     */
+    static void* operator new(std::size_t size)
+    {
+        MemoryStats::allocated(MT_BULLETS, size);
+        return RecyclingAllocator<Bullet>::allocate(size);
+    }
+    static void operator delete(void* memory, std::size_t size)
+    {
+        MemoryStats::released(MT_BULLETS, size);
+        RecyclingAllocator<Bullet>::release(memory, size);
+    }
 
     /**
      * Atualiza a posição do projétil.
@@ -35,11 +49,23 @@ public:
      * Marca o projétil para remoção após a animação.
      */
     void destroy();
+
+    /**
+     * Salva o estado do projétil.
+     * @param out - escritor do buffer de estado
+     */
+    void saveState(StateWriter& out) const;
+
+    /**
+     * Restaura o estado salvo por saveState().
+     * @param in - leitor do buffer de estado
+     */
+    void loadState(StateReader& in);
     
     /**
      * Velocidade de deslocamento do projétil (pixels/ms).
      */
-    double speed;
+    Fixed speed;
 
     /**
      * Indica se o projétil colidiu com algum objeto.
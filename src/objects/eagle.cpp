@@ -1,4 +1,5 @@
 #include "eagle.h"
+#include "../eventbus.h"
 
 // Construtor padrão: inicializa a águia na posição (0,0) com o sprite padrão de águia
 Eagle::Eagle()
@@ -7,7 +8,7 @@ Eagle::Eagle()
 }
 
 // Construtor parametrizado: inicializa a águia na posição (x, y) com o sprite padrão de águia
-Eagle::Eagle(double x, double y)
+Eagle::Eagle(Fixed x, Fixed y)
     : Object(x, y, ST_EAGLE)
 {
 }
@@ -46,6 +47,7 @@ void Eagle::destroy()
 {
     // Só executa se a águia ainda não estiver destruída
     if(type != ST_EAGLE) return;
+    EventBus::getInstance().emit(GE_EAGLE_DESTROYED, type, pos_x.toInt(), pos_y.toInt());
 
     // Troca o sprite para o de destruição e atualiza o tipo
     m_sprite = Engine::getEngine().getSpriteConfig()->getSpriteData(ST_DESTROY_EAGLE);
@@ -53,8 +55,8 @@ void Eagle::destroy()
     src_rect = moveRect(m_sprite->rect, 0, 0);
 
     // Centraliza o sprite de destruição na posição da águia
-    dest_rect.x = pos_x + (dest_rect.w - m_sprite->rect.w)/2;
-    dest_rect.y = pos_y + (dest_rect.h - m_sprite->rect.h)/2;
+    dest_rect.x = pos_x.toInt() + (dest_rect.w - m_sprite->rect.w)/2;
+    dest_rect.y = pos_y.toInt() + (dest_rect.h - m_sprite->rect.h)/2;
     dest_rect.h = m_sprite->rect.h;
     dest_rect.w = m_sprite->rect.w;
 }
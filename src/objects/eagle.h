@@ -21,7 +21,21 @@ public:
      * @param x - posição horizontal inicial da águia
      * @param y - posição vertical inicial da águia
      */
-    Eagle(double x, double y);
+    Eagle(Fixed x, Fixed y);
+
+    /**
+     * A águia é contabilizada com o terreno (@a MemoryStats).
+     */
+    static void* operator new(std::size_t size)
+    {
+        MemoryStats::allocated(MT_TERRAIN, size);
+        return ::operator new(size);
+    }
+    static void operator delete(void* memory, std::size_t size)
+    {
+        MemoryStats::released(MT_TERRAIN, size);
+        ::operator delete(memory);
+    }
 
     /**
      * Atualiza o estado e a animação da águia.
@@ -1,5 +1,6 @@
 #include "enemy.h"
 #include "../appconfig.h"
+#include "../engine/random.h"
 #include <stdlib.h>
 #include <ctime>
 #include <iostream>
@@ -9,56 +10,44 @@ Enemy::Enemy()
     : Tank(AppConfig::enemy_starting_point.at(0).x, AppConfig::enemy_starting_point.at(0).y, ST_TANK_A)
 {
     direction = D_DOWN; // Direção inicial para baixo
-    m_direction_time = 0; // Tempo acumulado para troca de direção
-    m_keep_direction_time = 100; // Tempo mínimo para manter a direção
-
-    m_speed_time = 0; // Tempo acumulado para tentar se mover
-    m_try_to_go_time = 100; // Intervalo para tentar se mover
-
-    m_fire_time = 0; // Tempo acumulado para disparo
-    m_reload_time = 100; // Tempo de recarga do disparo
+    startTimer(TI_DIRECTION, 100); // Tempo mínimo para manter a direção
+    startTimer(TI_MOVE, 100); // Intervalo para tentar se mover
+    startTimer(TI_FIRE, 100); // Tempo de recarga do disparo
     lives_count = 1; // Número de vidas do inimigo
 
     m_bullet_max_size = 1; // Quantidade máxima de balas simultâneas
 
-    m_frozen_time = 0; // Tempo de congelamento
-
     // Ajusta a velocidade padrão dependendo do tipo do tanque
     if(type == ST_TANK_B)
-        default_speed = AppConfig::tank_default_speed * 1.3;
+        default_speed = AppConfig::tank_default_speed * 13 / 10;
     else
         default_speed = AppConfig::tank_default_speed;
 
     target_position = {-1, -1}; // Posição alvo inicial inválida
+    lod_time = 0;
 
     respawn(); // Reposiciona o inimigo e reseta estados
 }
 
 // Construtor parametrizado do inimigo. Permite definir posição e tipo do sprite.
-Enemy::Enemy(double x, double y, SpriteType type)
+Enemy::Enemy(Fixed x, Fixed y, SpriteType type)
     : Tank(x, y, type)
 {
     direction = D_DOWN;
-    m_direction_time = 0;
-    m_keep_direction_time = 100;
-
-    m_speed_time = 0;
-    m_try_to_go_time = 100;
-
-    m_fire_time = 0;
-    m_reload_time = 100;
+    startTimer(TI_DIRECTION, 100);
+    startTimer(TI_MOVE, 100);
+    startTimer(TI_FIRE, 100);
     lives_count = 1;
 
     m_bullet_max_size = 1;
 
-    m_frozen_time = 0;
-
     if(type == ST_TANK_B)
-        default_speed = AppConfig::tank_default_speed * 1.3;
+        default_speed = AppConfig::tank_default_speed * 13 / 10;
     else
         default_speed = AppConfig::tank_default_speed;
 
     target_position = {-1, -1};
+    lod_time = 0;
 
     respawn();
 }
@@ -85,11 +74,25 @@ void Enemy::draw()
     Tank::draw(); // Chama o desenho padrão do tanque
 }
 
-// Atualiza o estado do inimigo, incluindo movimentação, direção, disparo e animação.
+// Atualiza o estado do inimigo e o sprite de acordo com a direção e a armadura.
 void Enemy::update(Uint32 dt)
+{
+    update(dt, dt);
+}
+
+// Os projéteis podem andar num passo diferente do tanque (simulação reduzida dos inimigos distantes)
+void Enemy::update(Uint32 tank_dt, Uint32 bullet_dt)
 {
     if(to_erase) return; // Não atualiza se marcado para remoção
-    Tank::update(dt); // Atualiza lógica base do tanque
+    advance(tank_dt, bullet_dt);
+    eraseBullets();
+}
+
+void Enemy::advance(Uint32 tank_dt, Uint32 bullet_dt)
+{
+    if(to_erase) return;
+    updateTank(tank_dt); // Atualiza lógica base do tanque
+    moveBullets(bullet_dt);
 
     // Atualiza o sprite de acordo com flags e vidas
     if(testFlag(TSF_LIFE))
@@ -108,18 +111,31 @@ void Enemy::update(Uint32 dt)
     // Se está congelado, não faz nada além de atualizar sprite
     if(testFlag(TSF_FROZEN)) return;
 
-    // Acumula tempo para cada ação
-    m_direction_time += dt;
-    m_speed_time += dt;
-    m_fire_time += dt;
+    stop = false; // Reseta flag de parada para próxima atualização
+}
+
+// Decisões da IA do inimigo, chamadas pela roda de temporizadores.
+void Enemy::onTimer(int timer_id)
+{
+    if(timer_id != TI_DIRECTION && timer_id != TI_MOVE && timer_id != TI_FIRE)
+    {
+        Tank::onTimer(timer_id);
+        return;
+    }
+
+    // Congelado: a decisão espera o fim do congelamento
+    if(testFlag(TSF_FROZEN))
+    {
+        startTimer(timer_id, timerRemaining(TI_FROZEN) + 1);
+        return;
+    }
 
     // Troca de direção após tempo aleatório
-    if(m_direction_time > m_keep_direction_time)
+    if(timer_id == TI_DIRECTION)
     {
-        m_direction_time = 0;
-        m_keep_direction_time = rand() % 800 + 100; // Novo tempo aleatório para manter direção
+        startTimer(TI_DIRECTION, Random::getInstance().nextInt(800) + 100); // Novo tempo aleatório para manter direção
 
-        float p = static_cast<float>(rand()) / RAND_MAX;
+        float p = Random::getInstance().nextFloat();
 
         // Decide se vai perseguir o alvo ou escolher direção aleatória
         if(p < (type == ST_TANK_A ? 0.8f : 0.5f) && target_position.x > 0 && target_position.y > 0)
@@ -127,7 +143,7 @@ void Enemy::update(Uint32 dt)
             int dx = target_position.x - (dest_rect.x + dest_rect.w / 2);
             int dy = target_position.y - (dest_rect.y + dest_rect.h / 2);
 
-            p = static_cast<float>(rand()) / RAND_MAX;
+            p = Random::getInstance().nextFloat();
 
             // Prioriza o eixo de maior distância para perseguir o alvo
             if(abs(dx) > abs(dy))
@@ -136,24 +152,22 @@ void Enemy::update(Uint32 dt)
                 setDirection(p < 0.7 ? (dy < 0 ? D_UP : D_DOWN) : (dx < 0 ? D_LEFT : D_RIGHT));
         }
         else
-            setDirection(static_cast<Direction>(rand() % 4)); // Direção aleatória
+            setDirection(static_cast<Direction>(Random::getInstance().nextInt(4))); // Direção aleatória
     }
 
     // Tenta se mover após tempo aleatório
-    if(m_speed_time > m_try_to_go_time)
+    if(timer_id == TI_MOVE)
     {
-        m_speed_time = 0;
-        m_try_to_go_time = rand() % 300; // Novo tempo aleatório para tentar se mover
+        startTimer(TI_MOVE, Random::getInstance().nextInt(300)); // Novo tempo aleatório para tentar se mover
         speed = default_speed; // Restaura velocidade padrão
     }
 
     // Lógica de disparo automática do inimigo
-    if(m_fire_time > m_reload_time)
+    if(timer_id == TI_FIRE)
     {
-        m_fire_time = 0;
         if(type == ST_TANK_D)
         {
-            m_reload_time = rand() % 400; // Recarga mais rápida para TANK_D
+            startTimer(TI_FIRE, Random::getInstance().nextInt(400)); // Recarga mais rápida para TANK_D
             int dx = target_position.x - (dest_rect.x + dest_rect.w / 2);
             int dy = target_position.y - (dest_rect.y + dest_rect.h / 2);
 
@@ -179,17 +193,15 @@ void Enemy::update(Uint32 dt)
         }
         else if(type == ST_TANK_C)
         {
-            m_reload_time = rand() % 800; // Recarga intermediária para TANK_C
+            startTimer(TI_FIRE, Random::getInstance().nextInt(800)); // Recarga intermediária para TANK_C
             fire();
         }
         else
         {
-            m_reload_time = rand() % 1000; // Recarga mais lenta para outros tipos
+            startTimer(TI_FIRE, Random::getInstance().nextInt(1000)); // Recarga mais lenta para outros tipos
             fire();
         }
     }
-
-    stop = false; // Reseta flag de parada para próxima atualização
 }
 
 // Diminui a quantidade de vidas do inimigo e destrói se chegar a zero.
@@ -210,3 +222,19 @@ unsigned Enemy::scoreForHit()
     if(lives_count > 0) return 50;
     return 100;
 }
+
+// Salva o estado do inimigo
+void Enemy::saveState(StateWriter &out) const
+{
+    Tank::saveState(out);
+    out.write(target_position);
+    out.write(lod_time);
+}
+
+// Restaura o estado do inimigo
+void Enemy::loadState(StateReader &in)
+{
+    Tank::loadState(in);
+    in.read(target_position);
+    in.read(lod_time);
+}
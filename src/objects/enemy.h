@@ -22,7 +22,21 @@ public:
      * @param y - posição vertical inicial do inimigo
      * @param type - tipo do sprite do tanque inimigo
      */
-    Enemy(double x, double y, SpriteType type);
+    Enemy(Fixed x, Fixed y, SpriteType type);
+
+    /**
+     * Inimigos entram e saem durante a rodada: a memória é reaproveitada (@a RecyclingAllocator).
+     */
+    static void* operator new(std::size_t size)
+    {
+        MemoryStats::allocated(MT_TANKS, size);
+        return RecyclingAllocator<Enemy>::allocate(size);
+    }
+    static void operator delete(void* memory, std::size_t size)
+    {
+        MemoryStats::released(MT_TANKS, size);
+        RecyclingAllocator<Enemy>::release(memory, size);
+    }
 
     /**
      * Desenha o tanque inimigo na tela.
@@ -31,58 +45,66 @@ public:
     void draw();
 
     /**
-     * Atualiza a posição do tanque inimigo, decide direção e momento do próximo disparo
-     * de acordo com o tipo do inimigo.
+     * Atualiza o sprite do tanque inimigo de acordo com a direção, o bônus e a armadura.
      * @param dt - tempo (em ms) desde a última atualização
      */
     void update(Uint32 dt);
 
     /**
-     * Reduz o nível de armadura em 1. Se chegar a zero, o tanque é destruído (explode).
+     * Atualiza o tanque e os projéteis com passos diferentes (simulação reduzida longe dos jogadores, ver Game::updateLod).
+     * @param tank_dt - tempo (em ms) simulado para o tanque
+     * @param bullet_dt - tempo (em ms) desde a última atualização dos projéteis
      */
-    void destroy();
+    void update(Uint32 tank_dt, Uint32 bullet_dt);
 
     /**
-     * Retorna a quantidade de pontos que o jogador recebe ao destruir este inimigo.
-     * @return pontos
+     * update(tank_dt, bullet_dt) sem remover os projéteis destruídos (Tank::eraseBullets): toca apenas este inimigo e
+     * seus projéteis, então pode rodar em paralelo com os outros inimigos.
+     * @param tank_dt - tempo (em ms) simulado para o tanque
+     * @param bullet_dt - tempo (em ms) desde a última atualização dos projéteis
      */
-    unsigned scoreForHit();
+    void advance(Uint32 tank_dt, Uint32 bullet_dt);
 
     /**
-     * Posição alvo para onde o tanque inimigo está se dirigindo.
+     * Decisões da IA: troca de direção (TI_DIRECTION), volta a andar (TI_MOVE) e tentativa de disparo (TI_FIRE),
+     * cada uma reagendada com um intervalo aleatório. Enquanto o tanque está congelado, as decisões são adiadas
+     * para o fim do congelamento.
+     * @param timer_id - temporizador que expirou
      */
-    SDL_Point target_position;
+    void onTimer(int timer_id);
 
-private:
     /**
-     * Tempo desde a última mudança de direção (em ms).
+     * Reduz o nível de armadura em 1. Se chegar a zero, o tanque é destruído (explode).
      */
-    Uint32 m_direction_time;
+    void destroy();
 
     /**
-     * Tempo durante o qual o tanque mantém a direção atual antes de mudar (em ms).
+     * Retorna a quantidade de pontos que o jogador recebe ao destruir este inimigo.
+     * @return pontos
      */
-    Uint32 m_keep_direction_time;
+    unsigned scoreForHit();
 
     /**
-     * Tempo desde a última tentativa de retomar o movimento (em ms).
+     * Salva o estado do inimigo (tanque, temporizadores da IA e alvo).
+     * @param out - escritor do buffer de estado
      */
-    Uint32 m_speed_time;
+    void saveState(StateWriter& out) const;
 
     /**
-     * Tempo até a próxima tentativa de retomar o movimento (em ms); define quando a velocidade será diferente de zero.
+     * Restaura o estado salvo por saveState().
+     * @param in - leitor do buffer de estado
      */
-    Uint32 m_try_to_go_time;
+    void loadState(StateReader& in);
 
     /**
-     * Tempo desde a última tentativa de disparar um projétil (em ms).
+     * Posição alvo para onde o tanque inimigo está se dirigindo.
      */
-    Uint32 m_fire_time;
+    SDL_Point target_position;
 
     /**
-     * Tempo até a próxima tentativa de disparo (em ms).
+     * Tempo (em ms) passado longe dos jogadores e da águia e ainda não simulado (ver Game::updateLod).
      */
-    Uint32 m_reload_time;
+    Uint32 lod_time;
 };
 
 #endif // ENEMY_H
@@ -6,8 +6,8 @@
 // Construtor padrão: inicializa o objeto com valores padrão
 Object::Object()
 {
-    pos_x = 0.0;
-    pos_y = 0.0;
+    pos_x = 0;
+    pos_y = 0;
     type = ST_NONE;
     to_erase = false;
     m_sprite = nullptr;
@@ -17,7 +17,7 @@ Object::Object()
 }
 
 // Construtor: inicializa o objeto em (x, y) com o tipo de sprite fornecido
-Object::Object(double x, double y, SpriteType type)
+Object::Object(Fixed x, Fixed y, SpriteType type)
 {
     pos_x = x;
     pos_y = y;
@@ -35,20 +35,20 @@ Object::Object(double x, double y, SpriteType type)
     src_rect.w = m_sprite->rect.w;
 
     // Inicializa o retângulo de destino (posição na tela)
-    dest_rect.x = pos_x;
-    dest_rect.y = pos_y;
+    dest_rect.x = pos_x.toInt();
+    dest_rect.y = pos_y.toInt();
     dest_rect.h = m_sprite->rect.h;
     dest_rect.w = m_sprite->rect.w;
 
     // Inicializa o retângulo de colisão
-    collision_rect.x = pos_x;
-    collision_rect.y = pos_y;
+    collision_rect.x = pos_x.toInt();
+    collision_rect.y = pos_y.toInt();
     collision_rect.h = m_sprite->rect.h;
     collision_rect.w = m_sprite->rect.w;
 }
 
 // Construtor: inicializa o objeto em (x, y) com um ponteiro para SpriteData
-Object::Object(double x, double y, const SpriteData *sprite)
+Object::Object(Fixed x, Fixed y, const SpriteData *sprite)
 {
     pos_x = x;
     pos_y = y;
@@ -66,14 +66,14 @@ Object::Object(double x, double y, const SpriteData *sprite)
     src_rect.w = m_sprite->rect.w;
 
     // Inicializa o retângulo de destino (posição na tela)
-    dest_rect.x = pos_x;
-    dest_rect.y = pos_y;
+    dest_rect.x = pos_x.toInt();
+    dest_rect.y = pos_y.toInt();
     dest_rect.h = m_sprite->rect.h;
     dest_rect.w = m_sprite->rect.w;
 
     // Inicializa o retângulo de colisão
-    collision_rect.x = pos_x;
-    collision_rect.y = pos_y;
+    collision_rect.x = pos_x.toInt();
+    collision_rect.y = pos_y.toInt();
     collision_rect.h = m_sprite->rect.h;
     collision_rect.w = m_sprite->rect.w;
 }
@@ -83,6 +83,18 @@ Object::~Object()
 {
 }
 
+void* Object::operator new(std::size_t size)
+{
+    MemoryStats::allocated(MT_TANKS, size);
+    return RecyclingAllocator<Object>::allocate(size);
+}
+
+void Object::operator delete(void* memory, std::size_t size)
+{
+    MemoryStats::released(MT_TANKS, size);
+    RecyclingAllocator<Object>::release(memory, size);
+}
+
 // Desenha o objeto na tela, se houver sprite e não estiver marcado para remoção
 void Object::draw()
 {
@@ -105,14 +117,14 @@ void Object::update(Uint32 dt)
     if(to_erase) return;
 
     // Atualiza posição e tamanho do retângulo de destino
-    dest_rect.x = pos_x;
-    dest_rect.y = pos_y;
+    dest_rect.x = pos_x.toInt();
+    dest_rect.y = pos_y.toInt();
     dest_rect.h = m_sprite->rect.h;
     dest_rect.w = m_sprite->rect.w;
 
     // Atualiza posição e tamanho do retângulo de colisão
-    collision_rect.x = pos_x;
-    collision_rect.y = pos_y;
+    collision_rect.x = pos_x.toInt();
+    collision_rect.y = pos_y.toInt();
     collision_rect.h = m_sprite->rect.h;
     collision_rect.w = m_sprite->rect.w;
 
@@ -137,6 +149,48 @@ void Object::update(Uint32 dt)
     }
 }
 
+// Mostra o frame indicado sem depender do tempo acumulado do próprio objeto
+void Object::setFrame(int frame)
+{
+    m_current_frame = frame;
+    m_frame_display_time = 0;
+    src_rect = moveRect(m_sprite->rect, 0, m_current_frame);
+}
+
+// Salva os campos comuns a todos os objetos
+void Object::saveState(StateWriter &out) const
+{
+    out.write(to_erase);
+    out.write(collision_rect);
+    out.write(dest_rect);
+    out.write(src_rect);
+    out.write(type);
+    out.write(pos_x);
+    out.write(pos_y);
+    out.write(color);
+    out.write(m_sprite != nullptr ? m_sprite->type : ST_NONE); // o sprite é salvo pelo tipo, nunca pelo ponteiro
+    out.write(m_frame_display_time);
+    out.write(m_current_frame);
+}
+
+// Restaura os campos comuns a todos os objetos
+void Object::loadState(StateReader &in)
+{
+    SpriteType sprite_type;
+    in.read(to_erase);
+    in.read(collision_rect);
+    in.read(dest_rect);
+    in.read(src_rect);
+    in.read(type);
+    in.read(pos_x);
+    in.read(pos_y);
+    in.read(color);
+    in.read(sprite_type);
+    in.read(m_frame_display_time);
+    in.read(m_current_frame);
+    m_sprite = sprite_type != ST_NONE ? Engine::getEngine().getSpriteConfig()->getSpriteData(sprite_type) : nullptr;
+}
+
 // Move o retângulo de origem do sprite para o frame desejado (usado em animações)
 // x e y são deslocamentos em número de frames na horizontal e vertical
 SDL_Rect Object::moveRect(const SDL_Rect &rect, int x, int y)
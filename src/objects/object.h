@@ -2,6 +2,10 @@
 #define OBJECT_H
 
 #include "../engine/engine.h"
+#include "../engine/statebuffer.h"
+#include "../engine/fixed.h"
+#include "../engine/recyclingallocator.h"
+#include "../engine/memorystats.h"
 
 /**
  * @brief
@@ -24,7 +28,7 @@ public:
      * @param y - posição vertical inicial
      * @param type - tipo do sprite/objeto
      */
-    Object(double x, double y, SpriteType type);
+    Object(Fixed x, Fixed y, SpriteType type);
 
     /**
      * Construtor alternativo.
@@ -33,7 +37,7 @@ public:
      * @param y - posição vertical inicial
      * @param sprite - ponteiro para os dados de animação do sprite
      */
-    Object(double x, double y, const SpriteData* sprite);
+    Object(Fixed x, Fixed y, const SpriteData* sprite);
 
     /**
      * Destrutor virtual.
@@ -41,6 +45,16 @@ public:
      */
     virtual ~Object();
 
+    /**
+     * Escudos e barcos são criados e apagados durante a partida: a memória é reaproveitada (@a RecyclingAllocator).
+     * Classes derivadas sem operadores próprios usam o alocador global e, como os escudos e barcos,
+     * são contabilizadas como tanques (@a MemoryStats).
+     * Definidos em object.cpp: se fossem expandidos no local, o compilador veria o ::operator new dessas classes
+     * derivadas (ex.: Player) liberado por Object::operator delete e acusaria o par como incompatível.
+     */
+    static void* operator new(std::size_t size);
+    static void operator delete(void* memory, std::size_t size);
+
     /**
      * Desenha o objeto na tela.
      * Utiliza o método drawObject da classe Renderer, desenhando a textura definida por src_rect na área dest_rect.
@@ -55,6 +69,25 @@ public:
      */
     virtual void update(Uint32 dt);
 
+    /**
+     * Mostra um frame específico da animação, para objetos animados por um relógio compartilhado em vez de update().
+     * @param frame - índice do frame (0 a frames_count - 1)
+     */
+    void setFrame(int frame);
+
+    /**
+     * Salva o estado do objeto (posição, retângulos, sprite e animação) em um buffer plano.
+     * Classes derivadas acrescentam seus próprios campos após os da classe base.
+     * @param out - escritor do buffer de estado
+     */
+    virtual void saveState(StateWriter& out) const;
+
+    /**
+     * Restaura o estado salvo por saveState(), na mesma ordem dos campos.
+     * @param in - leitor do buffer de estado
+     */
+    virtual void loadState(StateReader& in);
+
     /**
      * Indica se o objeto deve ser removido do jogo.
      * Se for true, o objeto não será atualizado nem desenhado.
@@ -86,14 +119,14 @@ public:
     SpriteType type;
 
     /**
-     * Posição horizontal precisa do objeto (em pixels ou unidades do mundo).
+     * Posição horizontal precisa do objeto, em pixels com fração (ponto fixo 16.16).
      */
-    double pos_x;
+    Fixed pos_x;
 
     /**
-     * Posição vertical precisa do objeto (em pixels ou unidades do mundo).
+     * Posição vertical precisa do objeto, em pixels com fração (ponto fixo 16.16).
      */
-    double pos_y;
+    Fixed pos_y;
 
     /**
      * Cor do objeto para colorização de sprites.
@@ -1,6 +1,7 @@
 #include "player.h"
 #include "../appconfig.h"
-#include "../soundmanager.h"
+#include "../eventbus.h"
+#include "../inputmanager.h"
 
 #include <iostream>
 #include <SDL2/SDL.h>
@@ -17,16 +18,8 @@ Player::Player(const PlayerKeys& keys, int idx)
     score = 0; // Pontuação inicial
     star_count = 0; // Nível de power-up (estrelas)
     m_shield = new Object(pos_x, pos_y, ST_SHIELD); // Cria o escudo do jogador
-    m_shield_time = 0; // Tempo de escudo inicial
-    m_controller = nullptr;
-    if(player_keys.type == Player::InputType::Controller || player_keys.type == Player::InputType::Hybrid)
-    {
-        // Verifica se há controles suficientes conectados
-        int num_joysticks = SDL_NumJoysticks();
-        if (idx < num_joysticks && SDL_IsGameController(idx)) {
-            m_controller = SDL_GameControllerOpen(idx);
-        }
-    }
+    m_controller_index = idx; // O controle é obtido do InputManager quando necessário
+    m_input_actions = IA_NONE; // Nenhuma ação até a primeira amostragem
     
     // Ajusta o tipo de input baseado na disponibilidade de controles
     adjustInputType(idx);
@@ -48,16 +41,8 @@ Player::Player(const PlayerKeys& keys, int player_idx, int controller_idx)
     score = 0; // Pontuação inicial
     star_count = 0; // Nível de power-up (estrelas)
     m_shield = new Object(pos_x, pos_y, ST_SHIELD); // Cria o escudo do jogador
-    m_shield_time = 0; // Tempo de escudo inicial
-    m_controller = nullptr;
-    if(player_keys.type == Player::InputType::Controller || player_keys.type == Player::InputType::Hybrid)
-    {
-        // Verifica se há controles suficientes conectados
-        int num_joysticks = SDL_NumJoysticks();
-        if (controller_idx < num_joysticks && SDL_IsGameController(controller_idx)) {
-            m_controller = SDL_GameControllerOpen(controller_idx);
-        }
-    }
+    m_controller_index = controller_idx; // O controle é obtido do InputManager quando necessário
+    m_input_actions = IA_NONE; // Nenhuma ação até a primeira amostragem
     
     // Ajusta o tipo de input baseado na disponibilidade de controles
     adjustInputType(player_idx);
@@ -70,7 +55,7 @@ Player::Player(const PlayerKeys& keys, int player_idx, int controller_idx)
 
 // Construtor parametrizado do jogador.
 // Permite definir posição e tipo do sprite.
-Player::Player(double x, double y, SpriteType type, int idx)
+Player::Player(Fixed x, Fixed y, SpriteType type, int idx)
     : Tank(x, y, type)
 {
    speed = 0;
@@ -79,16 +64,8 @@ Player::Player(double x, double y, SpriteType type, int idx)
    score = 0;
    star_count = 0;
    m_shield = new Object(x, y, ST_SHIELD);
-   m_shield_time = 0;
-   m_controller = nullptr;
-   if(player_keys.type == Player::InputType::Controller || player_keys.type == Player::InputType::Hybrid)
-   {
-       // Verifica se há controles suficientes conectados
-       int num_joysticks = SDL_NumJoysticks();
-       if (idx < num_joysticks && SDL_IsGameController(idx)) {
-           m_controller = SDL_GameControllerOpen(idx);
-       }
-   }
+   m_controller_index = idx;
+   m_input_actions = IA_NONE;
    
    // Define a cor do jogador baseada no índice
    setPlayerColor(getPlayerColor(idx));
@@ -97,14 +74,9 @@ Player::Player(double x, double y, SpriteType type, int idx)
 }
 
 // Destrutor do jogador.
-// Fecha o controle do jogador se aberto e libera o escudo se alocado.
+// Libera o escudo se alocado. O controle pertence ao InputManager e não é fechado aqui.
 Player::~Player()
 {
-    if(m_controller)
-    {
-        SDL_GameControllerClose(m_controller);
-        m_controller = nullptr;
-    }
     if(m_shield)
     {
         delete m_shield;
@@ -113,7 +85,7 @@ Player::~Player()
 }
 
 // Atualiza o estado do jogador a cada frame.
-// Processa entrada do teclado, movimentação, tiro e animação.
+// Consome a máscara de ações do tick (movimentação e tiro) e atualiza a animação.
 void Player::update(Uint32 dt)
 {
     Tank::update(dt); // Atualiza lógica base do tanque
@@ -121,270 +93,41 @@ void Player::update(Uint32 dt)
     // Só processa input se não estiver no menu
     if(!testFlag(TSF_MENU))
     {
-        // Ajusta dinamicamente o input baseado na disponibilidade de controles
-        // Se for o player 2, verifica se o player 1 está usando controle
-        int player_index = static_cast<int>(type) - static_cast<int>(ST_PLAYER_1);
-        if (player_index == 1) {
-            adjustInputType(player_index);
+        // Movimento: a máscara pode conter várias direções; a prioridade é cima, baixo, esquerda, direita
+        if(m_input_actions & IA_UP)
+        {
+            setDirection(D_UP);
+            speed = default_speed;
         }
-        
-        if(player_keys.type == Player::InputType::Keyboard)
+        else if(m_input_actions & IA_DOWN)
         {
-            const Uint8 *key_state = SDL_GetKeyboardState(NULL); // Estado atual do teclado
-            if(key_state != nullptr)
-            {
-                // Movimentação: verifica teclas direcionais
-                if(key_state[player_keys.up])
-                {
-                    setDirection(D_UP);
-                    speed = default_speed;
-                }
-                else if(key_state[player_keys.down])
-                {
-                    setDirection(D_DOWN);
-                    speed = default_speed;
-                }
-                else if(key_state[player_keys.left])
-                {
-                    setDirection(D_LEFT);
-                    speed = default_speed;
-                }
-                else if(key_state[player_keys.right])
-                {
-                    setDirection(D_RIGHT);
-                    speed = default_speed;
-                }
-                else
-                {
-                    // Se não está no gelo ou não está escorregando, para o tanque
-                    if(!testFlag(TSF_ON_ICE) || m_slip_time == 0)
-                        speed = 0.0;
-                }
-
-                // Disparo: verifica tecla de tiro e tempo de recarga
-                if(key_state[player_keys.fire] && m_fire_time > AppConfig::player_reload_time)
-                {
-                    fire();
-                    m_fire_time = 0;
-                }
-            }
+            setDirection(D_DOWN);
+            speed = default_speed;
         }
-        else if (player_keys.type == Player::InputType::Controller && m_controller)
+        else if(m_input_actions & IA_LEFT)
         {
-            bool moved = false;
-            
-            // --- Movimento usando analógicos ou D-pad ---
-            // Verifica se são analógicos (valores negativos indicam analógicos)
-            if (player_keys.axis_up < 0 || player_keys.axis_down < 0 || 
-                player_keys.axis_left < 0 || player_keys.axis_right < 0)
-            {
-                // Processa analógicos
-                // Zona morta otimizada para controle puro
-                const Sint16 DEADZONE = ANALOG_DEADZONE_CONTROLLER;
-                
-                // Lê os valores dos analógicos
-                Sint16 axis_y = SDL_GameControllerGetAxis(m_controller, SDL_CONTROLLER_AXIS_LEFTY);
-                Sint16 axis_x = SDL_GameControllerGetAxis(m_controller, SDL_CONTROLLER_AXIS_LEFTX);
-                
-                // Processa movimento vertical (eixo Y)
-                if (axis_y < -DEADZONE) {
-                    setDirection(D_UP);
-                    speed = default_speed;
-                    moved = true;
-                }
-                else if (axis_y > DEADZONE) {
-                    setDirection(D_DOWN);
-                    speed = default_speed;
-                    moved = true;
-                }
-                // Processa movimento horizontal (eixo X)
-                else if (axis_x < -DEADZONE) {
-                    setDirection(D_LEFT);
-                    speed = default_speed;
-                    moved = true;
-                }
-                else if (axis_x > DEADZONE) {
-                    setDirection(D_RIGHT);
-                    speed = default_speed;
-                    moved = true;
-                }
-            }
-            else
-            {
-                // Processa D-pad (botões)
-                if (SDL_GameControllerGetButton(m_controller, SDL_GameControllerButton(player_keys.axis_up))) {
-                    setDirection(D_UP);
-                    speed = default_speed;
-                    moved = true;
-                }
-                else if (SDL_GameControllerGetButton(m_controller, SDL_GameControllerButton(player_keys.axis_down))) {
-                    setDirection(D_DOWN);
-                    speed = default_speed;
-                    moved = true;
-                }
-                else if (SDL_GameControllerGetButton(m_controller, SDL_GameControllerButton(player_keys.axis_left))) {
-                    setDirection(D_LEFT);
-                    speed = default_speed;
-                    moved = true;
-                }
-                else if (SDL_GameControllerGetButton(m_controller, SDL_GameControllerButton(player_keys.axis_right))) {
-                    setDirection(D_RIGHT);
-                    speed = default_speed;
-                    moved = true;
-                }
-            }
-            
-            // Se não moveu, para o tanque (exceto se está escorregando no gelo)
-            if (!moved) {
-                if(!testFlag(TSF_ON_ICE) || m_slip_time == 0)
-                    speed = 0.0;
-            }
-            
-            // --- Disparo ---
-            if (player_keys.button_fire >= 0 &&
-                SDL_GameControllerGetButton(
-                    m_controller,
-                    SDL_GameControllerButton(player_keys.button_fire)
-                ) &&
-                m_fire_time > AppConfig::player_reload_time)
-            {
-                fire();
-                m_fire_time = 0;
-            }
+            setDirection(D_LEFT);
+            speed = default_speed;
         }
-        else if (player_keys.type == Player::InputType::Hybrid)
+        else if(m_input_actions & IA_RIGHT)
         {
-            // Processa input híbrido: teclado + controle
-            const Uint8 *key_state = SDL_GetKeyboardState(NULL);
-            bool moved = false;
-            bool keyboard_used = false;
-            
-            // --- Processa teclado primeiro (prioridade) ---
-            if(key_state != nullptr)
-            {
-                if(key_state[player_keys.up])
-                {
-                    setDirection(D_UP);
-                    speed = default_speed;
-                    moved = true;
-                    keyboard_used = true;
-                }
-                else if(key_state[player_keys.down])
-                {
-                    setDirection(D_DOWN);
-                    speed = default_speed;
-                    moved = true;
-                    keyboard_used = true;
-                }
-                else if(key_state[player_keys.left])
-                {
-                    setDirection(D_LEFT);
-                    speed = default_speed;
-                    moved = true;
-                    keyboard_used = true;
-                }
-                else if(key_state[player_keys.right])
-                {
-                    setDirection(D_RIGHT);
-                    speed = default_speed;
-                    moved = true;
-                    keyboard_used = true;
-                }
-
-                // Disparo do teclado
-                if(key_state[player_keys.fire] && m_fire_time > AppConfig::player_reload_time)
-                {
-                    fire();
-                    m_fire_time = 0;
-                }
-            }
-            
-            // --- Processa controle apenas se o teclado não foi usado ---
-            if(!keyboard_used && m_controller)
-            {
-                // --- Movimento usando analógicos ou D-pad ---
-                // Verifica se são analógicos (valores negativos indicam analógicos)
-                if (player_keys.axis_up < 0 || player_keys.axis_down < 0 || 
-                    player_keys.axis_left < 0 || player_keys.axis_right < 0)
-                {
-                    // Processa analógicos
-                    // Zona morta para input híbrido
-                    const Sint16 DEADZONE = ANALOG_DEADZONE_HYBRID;
-                    
-                    // Lê os valores dos analógicos
-                    Sint16 axis_y = SDL_GameControllerGetAxis(m_controller, SDL_CONTROLLER_AXIS_LEFTY);
-                    Sint16 axis_x = SDL_GameControllerGetAxis(m_controller, SDL_CONTROLLER_AXIS_LEFTX);
-                    
-                    // Processa movimento vertical (eixo Y)
-                    if (axis_y < -DEADZONE) {
-                        setDirection(D_UP);
-                        speed = default_speed;
-                        moved = true;
-                    }
-                    else if (axis_y > DEADZONE) {
-                        setDirection(D_DOWN);
-                        speed = default_speed;
-                        moved = true;
-                    }
-                    // Processa movimento horizontal (eixo X)
-                    else if (axis_x < -DEADZONE) {
-                        setDirection(D_LEFT);
-                        speed = default_speed;
-                        moved = true;
-                    }
-                    else if (axis_x > DEADZONE) {
-                        setDirection(D_RIGHT);
-                        speed = default_speed;
-                        moved = true;
-                    }
-                }
-                else
-                {
-                    // Processa D-pad (botões)
-                    if (SDL_GameControllerGetButton(m_controller, SDL_GameControllerButton(player_keys.axis_up))) {
-                        setDirection(D_UP);
-                        speed = default_speed;
-                        moved = true;
-                    }
-                    else if (SDL_GameControllerGetButton(m_controller, SDL_GameControllerButton(player_keys.axis_down))) {
-                        setDirection(D_DOWN);
-                        speed = default_speed;
-                        moved = true;
-                    }
-                    else if (SDL_GameControllerGetButton(m_controller, SDL_GameControllerButton(player_keys.axis_left))) {
-                        setDirection(D_LEFT);
-                        speed = default_speed;
-                        moved = true;
-                    }
-                    else if (SDL_GameControllerGetButton(m_controller, SDL_GameControllerButton(player_keys.axis_right))) {
-                        setDirection(D_RIGHT);
-                        speed = default_speed;
-                        moved = true;
-                    }
-                }
-                
-                // Disparo do controle (sempre processado)
-                if (player_keys.button_fire >= 0 &&
-                    SDL_GameControllerGetButton(
-                        m_controller,
-                        SDL_GameControllerButton(player_keys.button_fire)
-                    ) &&
-                    m_fire_time > AppConfig::player_reload_time)
-                {
-                    fire();
-                    m_fire_time = 0;
-                }
-            }
-            
-            // Se não moveu com nenhum input, para o tanque
-            if (!moved) {
-                if(!testFlag(TSF_ON_ICE) || m_slip_time == 0)
-                    speed = 0.0;
-            }
+            setDirection(D_RIGHT);
+            speed = default_speed;
+        }
+        else
+        {
+            // Se não está no gelo ou não está escorregando, para o tanque
+            if(!testFlag(TSF_ON_ICE) || !timerActive(TI_SLIP))
+                speed = 0;
         }
-    }
 
-    m_fire_time += dt; // Atualiza tempo desde o último tiro
+        // Disparo: verifica a ação de tiro e o tempo de recarga
+        if((m_input_actions & IA_FIRE) && !timerActive(TI_RELOAD))
+        {
+            fire();
+            startTimer(TI_RELOAD, AppConfig::player_reload_time);
+        }
+    }
 
     // Atualiza o frame do sprite conforme o estado de vida e power-up
     if(testFlag(TSF_LIFE))
@@ -415,15 +158,15 @@ void Player::respawn()
     }
 
     // Atualiza retângulo de destino do sprite
-    dest_rect.x = pos_x;
-    dest_rect.y = pos_y;
+    dest_rect.x = pos_x.toInt();
+    dest_rect.y = pos_y.toInt();
     dest_rect.h = m_sprite->rect.h;
     dest_rect.w = m_sprite->rect.w;
 
     setDirection(D_UP); // Sempre renasce apontando para cima
     Tank::respawn(); // Chama respawn da classe base
     setFlag(TSF_SHIELD); // Ativa escudo temporário
-    m_shield_time = AppConfig::tank_shield_time / 2; // Tempo reduzido de escudo
+    startTimer(TI_SHIELD, AppConfig::tank_shield_time - AppConfig::tank_shield_time / 2); // Tempo reduzido de escudo
     
     // Atualiza a posição e cor do escudo
     if(m_shield != nullptr)
@@ -438,8 +181,7 @@ void Player::respawn()
 // Considera escudo, barco e nível de estrela antes de destruir de fato.
 void Player::destroy()
 {
-    // sound
-    SoundManager::getInstance().playSound("player_exp");
+    EventBus::getInstance().emit(GE_HIT, type, pos_x.toInt(), pos_y.toInt());
 
     if(testFlag(TSF_SHIELD)) return; // Não destrói se estiver com escudo
     if(testFlag(TSF_BOAT))
@@ -466,10 +208,9 @@ Bullet* Player::fire()
     Bullet* b = Tank::fire();
     if(b != nullptr)
     {
-        // sound
-        SoundManager::getInstance().playSound("shoot");
+        EventBus::getInstance().emit(GE_SHOT, type, pos_x.toInt(), pos_y.toInt());
         // Se tem pelo menos uma estrela, aumenta a velocidade do tiro
-        if(star_count > 0) b->speed = AppConfig::bullet_default_speed * 1.3;
+        if(star_count > 0) b->speed = AppConfig::bullet_default_speed * 13 / 10;
         // Se está no nível máximo, o tiro causa mais dano
         if(star_count == 3) b->increased_damage = true;
     }
@@ -489,42 +230,38 @@ void Player::changeStarCountBy(int c)
     else m_bullet_max_size = 2;
 
     // Se tem pelo menos uma estrela, aumenta a velocidade padrão
-    if(star_count > 0) default_speed = AppConfig::tank_default_speed * 1.3;
+    if(star_count > 0) default_speed = AppConfig::tank_default_speed * 13 / 10;
     else default_speed = AppConfig::tank_default_speed;
 }
 
 void Player::addLife() {
     lives_count++;
-    SoundManager::getInstance().playSound("life");
+    EventBus::getInstance().emit(GE_LIFE, type, pos_x.toInt(), pos_y.toInt());
 }
 
 void Player::shieldHit() {
-    SoundManager::getInstance().playSound("shieldhit");
+    EventBus::getInstance().emit(GE_SHIELD_HIT, type, pos_x.toInt(), pos_y.toInt());
 }
 
 bool Player::isControllerActive(int controller_index) {
-    int num_joysticks = SDL_NumJoysticks();
-    if (controller_index < num_joysticks && SDL_IsGameController(controller_index)) {
-        SDL_GameController* controller = SDL_GameControllerOpen(controller_index);
-        if (controller) {
-            bool is_attached = SDL_GameControllerGetAttached(controller);
-            SDL_GameControllerClose(controller);
-            return is_attached;
-        }
-    }
-    return false;
+    // Consulta o cache do InputManager em vez de abrir e fechar o controle
+    return InputManager::getInstance().isControllerActive(controller_index);
 }
 
 void Player::adjustInputType(int player_index) {
-    // Função simplificada - apenas verifica disponibilidade sem logs
-    int num_joysticks = SDL_NumJoysticks();
-    int available_controllers = 0;
-    for (int i = 0; i < num_joysticks; ++i) {
-        if (SDL_IsGameController(i)) {
-            available_controllers++;
-        }
-    }
-    // Função mantida para compatibilidade, mas sem logs ou alterações automáticas
+    // Função mantida para compatibilidade, sem alterações automáticas.
+    // A disponibilidade dos controles vem do cache do InputManager (sem enumerar dispositivos).
+    (void)player_index;
+}
+
+void Player::setInputActions(Uint8 actions)
+{
+    m_input_actions = actions;
+}
+
+int Player::controllerIndex() const
+{
+    return m_controller_index;
 }
 
 void Player::setPlayerColor(SDL_Color player_color)
@@ -566,3 +303,19 @@ void Player::setFlag(TankStateFlag flag)
         m_shield->color = color;
     }
 }
+
+void Player::saveState(StateWriter &out) const
+{
+    Tank::saveState(out);
+    out.write(score);
+    out.write(star_count);
+    out.write(m_input_actions);
+}
+
+void Player::loadState(StateReader &in)
+{
+    Tank::loadState(in);
+    in.read(score);
+    in.read(star_count);
+    in.read(m_input_actions);
+}
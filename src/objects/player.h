@@ -93,12 +93,12 @@ public:
      * @param type - tipo do sprite do jogador
      * @param idx - índice do controle
      */
-    Player(double x, double y, SpriteType type, int idx);
+    Player(Fixed x, Fixed y, SpriteType type, int idx);
 
     /**
      * Atualiza o estado do jogador.
-     * Responsável por atualizar a animação do tanque, verificar o estado das teclas pressionadas
-     * e reagir aos comandos de movimento e disparo.
+     * Responsável por atualizar a animação do tanque e reagir às ações de movimento e disparo
+     * da máscara definida em setInputActions().
      * @param dt - tempo (em ms) desde a última chamada, usado para controlar a animação
      */
     void update(Uint32 dt);
@@ -155,7 +155,7 @@ public:
     void shieldHit();
 
     /**
-     * Verifica se um controle está conectado e ativo.
+     * Verifica se um controle está conectado e ativo, consultando o cache do InputManager.
      * @param controller_index - índice do controle a verificar
      * @return true se o controle estiver conectado e ativo
      */
@@ -168,6 +168,18 @@ public:
      */
     void adjustInputType(int player_index);
 
+    /**
+     * Define a máscara de ações do tick atual, consumida em update().
+     * @param actions - máscara de bits com valores de InputAction
+     */
+    void setInputActions(Uint8 actions);
+
+    /**
+     * Retorna o índice do controle físico do jogador.
+     * @return slot do controle no InputManager
+     */
+    int controllerIndex() const;
+
     /**
      * Define a cor do tanque do jogador.
      * @param player_color - cor a ser aplicada ao tanque
@@ -186,22 +198,32 @@ public:
      */
     void setFlag(TankStateFlag flag);
 
+    /**
+     * Salva o estado do jogador (tanque, pontuação, estrelas e recarga).
+     * @param out - escritor do buffer de estado
+     */
+    void saveState(StateWriter& out) const;
+
+    /**
+     * Restaura o estado salvo por saveState().
+     * @param in - leitor do buffer de estado
+     */
+    void loadState(StateReader& in);
+
 private:
     /**
-     * Ponteiro para o controle do jogador (caso use controle).
+     * Índice do controle físico do jogador (slot no InputManager).
+     */
+    int m_controller_index;
+    /**
+     * Máscara de ações (InputAction) amostrada para o tick atual.
      */
-    SDL_GameController* m_controller = nullptr;
+    Uint8 m_input_actions;
     /**
      * Quantidade atual de estrelas do jogador; varia de 0 a 3.
      * Estrelas aumentam habilidades do tanque.
      */
     int star_count;
-
-    /**
-     * Tempo decorrido desde o último disparo do jogador.
-     * Usado para controlar o tempo de recarga.
-     */
-    Uint32 m_fire_time;
 };
 
 #endif // PLAYER_H
@@ -1,6 +1,6 @@
 #include "tank.h"
 #include "../appconfig.h"
-#include "../soundmanager.h"
+#include "../eventbus.h"
 #include <algorithm>
 
 
@@ -9,27 +9,31 @@ Tank::Tank()
     : Object(AppConfig::enemy_starting_point.at(0).x, AppConfig::enemy_starting_point.at(0).y, ST_TANK_A)
 {
     direction = D_UP;
-    m_slip_time = 0;
+    new_direction = D_UP;
+    stop = false;
+    m_flags = 0;
+    lives_count = 1;
+    m_bullet_max_size = 1;
     default_speed = AppConfig::tank_default_speed;
-    speed = 0.0;
+    speed = 0;
     m_shield = nullptr;
     m_boat = nullptr;
-    m_shield_time = 0;
-    m_frozen_time = 0;
 }
 
 // Construtor parametrizado do Tank. Inicializa o tanque em (x, y) com o tipo de sprite fornecido.
-Tank::Tank(double x, double y, SpriteType type)
+Tank::Tank(Fixed x, Fixed y, SpriteType type)
     : Object(x, y, type)
 {
     direction = D_UP;
-    m_slip_time = 0;
+    new_direction = D_UP;
+    stop = false;
+    m_flags = 0;
+    lives_count = 1;
+    m_bullet_max_size = 1;
     default_speed = AppConfig::tank_default_speed;
-    speed = 0.0;
+    speed = 0;
     m_shield = nullptr;
     m_boat = nullptr;
-    m_shield_time = 0;
-    m_frozen_time = 0;
 }
 
 // Destrutor do Tank. Libera memória dos projéteis, escudo e barco.
@@ -67,6 +71,13 @@ void Tank::draw()
 void Tank::update(Uint32 dt)
 {
     if(to_erase) return;
+    updateTank(dt);
+    updateBullets(dt);
+}
+
+// Atualiza posição, animação e efeitos do tanque.
+void Tank::updateTank(Uint32 dt)
+{
     if(testFlag(TSF_LIFE))
     {
         // Atualiza posição do tanque se não estiver parado ou congelado
@@ -90,8 +101,8 @@ void Tank::update(Uint32 dt)
         }
 
         // Atualiza retângulo de destino e colisão
-        dest_rect.x = pos_x;
-        dest_rect.y = pos_y;
+        dest_rect.x = pos_x.toInt();
+        dest_rect.y = pos_y.toInt();
         dest_rect.h = m_sprite->rect.h;
         dest_rect.w = m_sprite->rect.w;
 
@@ -101,26 +112,12 @@ void Tank::update(Uint32 dt)
         collision_rect.w = dest_rect.w - 4;
     }
 
-    // Efeito de deslize no gelo
-    if(testFlag(TSF_ON_ICE) && m_slip_time > 0)
-    {
-        m_slip_time -= dt;
-        if(m_slip_time <= 0)
-        {
-            clearFlag(TSF_ON_ICE);
-            m_slip_time = 0;
-            direction = new_direction;
-        }
-    }
-
     // Atualiza escudo se ativo
     if(testFlag(TSF_SHIELD) && m_shield != nullptr)
     {
-        m_shield_time += dt;
         m_shield->pos_x = pos_x;
         m_shield->pos_y = pos_y;
         m_shield->update(dt);
-        if(m_shield_time > AppConfig::tank_shield_time) clearFlag(TSF_SHIELD);
     }
     // Atualiza barco se ativo
     if(testFlag(TSF_BOAT) && m_boat != nullptr)
@@ -129,12 +126,6 @@ void Tank::update(Uint32 dt)
         m_boat->pos_y = pos_y;
         m_boat->update(dt);
     }
-    // Atualiza efeito de congelamento
-    if(testFlag(TSF_FROZEN))
-    {
-        m_frozen_time += dt;
-        if(m_frozen_time > AppConfig::tank_frozen_time) clearFlag(TSF_FROZEN);
-    }
 
     // Animação do sprite do tanque (não anima se o tanque não está se movendo)
     if(m_sprite->frames_count > 1 && (testFlag(TSF_LIFE) ? speed > 0 : true)) // sem animação se o tanque não tenta andar
@@ -163,20 +154,55 @@ void Tank::update(Uint32 dt)
             }
         }
     }
+}
 
-    // Atualiza todos os projéteis e remove os que devem ser apagados
+// Atualiza todos os projéteis e remove os que devem ser apagados
+void Tank::updateBullets(Uint32 dt)
+{
+    moveBullets(dt);
+    eraseBullets();
+}
+
+void Tank::moveBullets(Uint32 dt)
+{
     for(auto bullet : bullets) bullet->update(dt);
+}
+
+void Tank::eraseBullets()
+{
     bullets.erase(std::remove_if(bullets.begin(), bullets.end(), [](Bullet*b){
         if(b->to_erase) {delete b; return true;}
         return false;
     }), bullets.end());
 }
 
+// Encerra os efeitos temporários do tanque.
+void Tank::onTimer(int timer_id)
+{
+    switch(timer_id)
+    {
+    case TI_SHIELD:
+        clearFlag(TSF_SHIELD);
+        break;
+    case TI_FROZEN:
+        clearFlag(TSF_FROZEN);
+        break;
+    case TI_SLIP:
+        // Fim do deslize: o tanque passa a andar na direção para onde aponta
+        if(testFlag(TSF_ON_ICE))
+        {
+            clearFlag(TSF_ON_ICE);
+            direction = new_direction;
+        }
+        break;
+    }
+}
+
 // Cria e dispara um novo projétil, se permitido.
 Bullet* Tank::fire()
 {
     if(!testFlag(TSF_LIFE)) return nullptr;
-    if(bullets.size() < m_bullet_max_size)
+    if(bullets.size() < m_bullet_max_size && !bullets.full())
     {
 
         // sound
@@ -211,7 +237,7 @@ Bullet* Tank::fire()
         bullet->direction = tmp_d;
         // Ajusta a velocidade do projétil dependendo do tipo do tanque
         if(type == ST_TANK_C)
-            bullet->speed = AppConfig::bullet_default_speed * 1.3;
+            bullet->speed = AppConfig::bullet_default_speed * 13 / 10;
         else
             bullet->speed = AppConfig::bullet_default_speed;
 
@@ -232,18 +258,18 @@ SDL_Rect Tank::nextCollisionRect(Uint32 dt)
     {
     case D_UP:
         r.x = collision_rect.x;
-        r.y = collision_rect.y - default_speed * dt - a;
+        r.y = (collision_rect.y - default_speed * dt - a).toInt();
         break;
     case D_RIGHT:
-        r.x = collision_rect.x + default_speed * dt + a;
+        r.x = (collision_rect.x + default_speed * dt + a).toInt();
         r.y = collision_rect.y;
         break;
     case D_DOWN:
         r.x = collision_rect.x;
-        r.y = collision_rect.y + default_speed * dt + a;
+        r.y = (collision_rect.y + default_speed * dt + a).toInt();
         break;
     case D_LEFT:
-        r.x = collision_rect.x - default_speed * dt - a;
+        r.x = (collision_rect.x - default_speed * dt - a).toInt();
         r.y = collision_rect.y;
         break;
     }
@@ -259,10 +285,11 @@ void Tank::setDirection(Direction d)
     if(!(testFlag(TSF_LIFE) || testFlag(TSF_CREATE))) return;
     if(testFlag(TSF_ON_ICE))
     {
+        bool slipping = timerActive(TI_SLIP);
         new_direction = d;
-        if(speed == 0.0 || m_slip_time == 0.0) direction = d;
-        if((m_slip_time != 0 && direction == new_direction) || m_slip_time == 0)
-            m_slip_time = AppConfig::slip_time;
+        if(speed == 0 || !slipping) direction = d;
+        if((slipping && direction == new_direction) || !slipping)
+            startTimer(TI_SLIP, AppConfig::slip_time);
     }
     else
         direction = d;
@@ -270,19 +297,19 @@ void Tank::setDirection(Direction d)
     // Alinha o tanque à grade do mapa se não estiver parado
     if(!stop)
     {
-        double epsilon = 5;
+        Fixed epsilon = 5;
         int pos_x_tile, pos_y_tile;
         switch (direction)
         {
         case D_UP:
         case D_DOWN:
-            pos_x_tile = ((int)(pos_x / AppConfig::tile_rect.w)) * AppConfig::tile_rect.w;
+            pos_x_tile = (pos_x.toInt() / AppConfig::tile_rect.w) * AppConfig::tile_rect.w;
             if(pos_x - pos_x_tile < epsilon) pos_x = pos_x_tile;
             else if(pos_x_tile + AppConfig::tile_rect.w - pos_x < epsilon) pos_x = pos_x_tile + AppConfig::tile_rect.w;
             break;
         case D_RIGHT:
         case D_LEFT:
-            pos_y_tile = ((int)(pos_y / AppConfig::tile_rect.h)) * AppConfig::tile_rect.h;
+            pos_y_tile = (pos_y.toInt() / AppConfig::tile_rect.h) * AppConfig::tile_rect.h;
             if(pos_y - pos_y_tile < epsilon) pos_y = pos_y_tile;
             else if(pos_y_tile + AppConfig::tile_rect.h - pos_y < epsilon) pos_y = pos_y_tile + AppConfig::tile_rect.h;
             break;
@@ -300,7 +327,7 @@ void Tank::collide(SDL_Rect &intersect_rect)
                 (direction == D_DOWN && (intersect_rect.y + intersect_rect.h) >= (collision_rect.y + collision_rect.h)))
         {
             stop = true;
-            m_slip_time = 0;
+            stopTimer(TI_SLIP);
         }
     }
     // Colisão pela horizontal (esquerda ou direita)
@@ -310,7 +337,7 @@ void Tank::collide(SDL_Rect &intersect_rect)
                 (direction == D_RIGHT && (intersect_rect.x + intersect_rect.w) >= (collision_rect.x + collision_rect.w)))
         {
             stop = true;
-            m_slip_time = 0;
+            stopTimer(TI_SLIP);
         }
     }
 }
@@ -320,8 +347,7 @@ void Tank::destroy()
 {
     if(!testFlag(TSF_LIFE)) return;
 
-    // sound
-    SoundManager::getInstance().playSound("shell_exp");
+    EventBus::getInstance().emit(GE_KILL, type, pos_x.toInt(), pos_y.toInt());
 
     stop = true;
     m_flags = TSF_DESTROYED;
@@ -330,7 +356,9 @@ void Tank::destroy()
     m_current_frame = 0;
     direction = D_UP;
     speed = 0;
-    m_slip_time = 0;
+    stopTimer(TI_SHIELD);
+    stopTimer(TI_FROZEN);
+    stopTimer(TI_SLIP);
     m_sprite = Engine::getEngine().getSpriteConfig()->getSpriteData(ST_DESTROY_TANK);
 
     // Zera retângulo de colisão
@@ -340,15 +368,69 @@ void Tank::destroy()
     collision_rect.w = 0;
 
     // Centraliza sprite de destruição
-    dest_rect.x = pos_x + (dest_rect.w - m_sprite->rect.w)/2;
-    dest_rect.y = pos_y + (dest_rect.h - m_sprite->rect.h)/2;
+    dest_rect.x = pos_x.toInt() + (dest_rect.w - m_sprite->rect.w)/2;
+    dest_rect.y = pos_y.toInt() + (dest_rect.h - m_sprite->rect.h)/2;
     dest_rect.h = m_sprite->rect.h;
     dest_rect.w = m_sprite->rect.w;
+}
+
+// Salva o estado do tanque e dos objetos que ele possui
+void Tank::saveState(StateWriter &out) const
+{
+    Object::saveState(out);
+    out.write(default_speed);
+    out.write(speed);
+    out.write(stop);
+    out.write(direction);
+    out.write(lives_count);
+    out.write(m_flags);
+    out.write(new_direction);
+    out.write(m_bullet_max_size);
+    saveTimers(out);
+
+    out.write(m_shield != nullptr);
+    if(m_shield != nullptr) m_shield->saveState(out);
+    out.write(m_boat != nullptr);
+    if(m_boat != nullptr) m_boat->saveState(out);
+
+    out.write(static_cast<Uint32>(bullets.size()));
+    for(auto bullet : bullets) bullet->saveState(out);
+}
 
-    // No método destroy, se for inimigo:
-    if (type == ST_TANK_A || type == ST_TANK_B || type == ST_TANK_C || type == ST_TANK_D) {
-        SoundManager::getInstance().playSound("eexplosion");
+// Restaura o estado do tanque, reaproveitando os objetos já alocados
+void Tank::loadState(StateReader &in)
+{
+    Object::loadState(in);
+    in.read(default_speed);
+    in.read(speed);
+    in.read(stop);
+    in.read(direction);
+    in.read(lives_count);
+    in.read(m_flags);
+    in.read(new_direction);
+    in.read(m_bullet_max_size);
+    loadTimers(in);
+
+    bool has_shield, has_boat;
+    in.read(has_shield);
+    if(has_shield && m_shield == nullptr) m_shield = new Object();
+    else if(!has_shield && m_shield != nullptr) { delete m_shield; m_shield = nullptr; }
+    if(m_shield != nullptr) m_shield->loadState(in);
+
+    in.read(has_boat);
+    if(has_boat && m_boat == nullptr) m_boat = new Object();
+    else if(!has_boat && m_boat != nullptr) { delete m_boat; m_boat = nullptr; }
+    if(m_boat != nullptr) m_boat->loadState(in);
+
+    Uint32 bullet_count;
+    in.read(bullet_count);
+    while(bullets.size() > bullet_count)
+    {
+        delete bullets.back();
+        bullets.pop_back();
     }
+    while(bullets.size() < bullet_count && !bullets.full() && in.ok()) bullets.push_back(new Bullet());
+    for(auto bullet : bullets) bullet->loadState(in);
 }
 
 // Seta uma flag de estado do tanque e inicializa efeitos especiais.
@@ -357,14 +439,14 @@ void Tank::setFlag(TankStateFlag flag)
     // Se ativando efeito de gelo, salva direção atual
     if(!testFlag(flag) && flag == TSF_ON_ICE) {
         new_direction = direction;
-        SoundManager::getInstance().playSound("ice");
+        EventBus::getInstance().emit(GE_ICE, type, pos_x.toInt(), pos_y.toInt());
     }
 
     // Ativa escudo
     if(flag == TSF_SHIELD)
     {
         if(m_shield == nullptr) m_shield = new Object(pos_x, pos_y, ST_SHIELD);
-         m_shield_time = 0;
+        startTimer(TI_SHIELD, AppConfig::tank_shield_time);
     }
     // Ativa barco
     if(flag == TSF_BOAT)
@@ -374,7 +456,7 @@ void Tank::setFlag(TankStateFlag flag)
     // Ativa congelamento
     if(flag == TSF_FROZEN)
     {
-        m_frozen_time = 0;
+        startTimer(TI_FROZEN, AppConfig::tank_frozen_time);
     }
     m_flags |= flag;
 }
@@ -386,7 +468,7 @@ void Tank::clearFlag(TankStateFlag flag)
     {
          if(m_shield != nullptr) delete m_shield;
          m_shield = nullptr;
-         m_shield_time = 0;
+         stopTimer(TI_SHIELD);
     }
     if(flag == TSF_BOAT)
     {
@@ -395,7 +477,7 @@ void Tank::clearFlag(TankStateFlag flag)
     }
     if(flag == TSF_FROZEN)
     {
-        m_frozen_time = 0;
+        stopTimer(TI_FROZEN);
     }
     m_flags &= ~flag;
 }
@@ -410,9 +492,10 @@ bool Tank::testFlag(TankStateFlag flag)
 void Tank::respawn()
 {
     m_sprite = Engine::getEngine().getSpriteConfig()->getSpriteData(ST_CREATE);
-    speed = 0.0;
+    speed = 0;
     stop = false;
-    m_slip_time = 0;
+    stopTimer(TI_FROZEN);
+    stopTimer(TI_SLIP);
 
     clearFlag(TSF_SHIELD);
     clearFlag(TSF_BOAT);
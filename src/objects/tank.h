@@ -4,6 +4,8 @@
 #include "object.h"
 #include "bullet.h"
 #include "../type.h"
+#include "../engine/timerwheel.h"
+#include "../engine/fixedvector.h"
 
 #include <vector>
 
@@ -12,8 +14,9 @@ typedef unsigned TankStateFlags;
 /**
  * @brief
  * Classe responsável pela mecânica básica dos tanques: movimentação e disparo.
+ * A duração do escudo, do congelamento e do deslize no gelo é controlada por temporizadores (@a TimerListener).
  */
-class Tank : public Object
+class Tank : public Object, public TimerListener
 {
 public:
     /**
@@ -30,7 +33,7 @@ public:
      * @param y - posição vertical inicial
      * @param type - tipo do tanque
      */
-    Tank(double x, double y, SpriteType type);
+    Tank(Fixed x, Fixed y, SpriteType type);
 
     /**
      * Destrutor virtual.
@@ -49,11 +52,34 @@ public:
      * Atualiza o estado do tanque.
      * Atualiza posição, retângulos de destino e colisão, posição do escudo/barco, animação,
      * atualiza os projéteis e remove projéteis destruídos.
-     * Controla o tempo de escudo e congelamento, desativando as flags quando necessário.
      * @param dt - tempo desde a última chamada (em ms), usado para animação
      */
     void update(Uint32 dt);
 
+    /**
+     * Atualiza os projéteis e remove os destruídos.
+     * @param dt - tempo desde a última chamada (em ms)
+     */
+    void updateBullets(Uint32 dt);
+
+    /**
+     * Primeira parte de updateBullets(): apenas move e anima os projéteis, sem liberar memória.
+     * Toca só os projéteis deste tanque, então pode rodar em paralelo com outros tanques (ver Game::update).
+     * @param dt - tempo desde a última chamada (em ms)
+     */
+    void moveBullets(Uint32 dt);
+
+    /**
+     * Segunda parte de updateBullets(): remove e libera os projéteis destruídos.
+     */
+    void eraseBullets();
+
+    /**
+     * Desativa o escudo (TI_SHIELD), o congelamento (TI_FROZEN) ou o deslize no gelo (TI_SLIP) quando o tempo termina.
+     * @param timer_id - temporizador que expirou
+     */
+    void onTimer(int timer_id);
+
     /**
      * Cria um novo projétil se ainda não atingiu o limite máximo.
      * @return ponteiro para o projétil criado, ou nullptr se não for possível criar
@@ -91,8 +117,21 @@ public:
      */
     virtual void destroy();
 
+    /**
+     * Salva o estado do tanque, incluindo escudo, barco, projéteis e temporizadores.
+     * @param out - escritor do buffer de estado
+     */
+    void saveState(StateWriter& out) const;
+
+    /**
+     * Restaura o estado do tanque, criando ou liberando escudo, barco e projéteis conforme necessário.
+     * @param in - leitor do buffer de estado
+     */
+    void loadState(StateReader& in);
+
     /**
      * Seta uma flag de estado do tanque.
+     * O escudo e o congelamento iniciam seus temporizadores.
      * @param flag - flag a ser ativada
      */
     void setFlag(TankStateFlag flag);
@@ -114,12 +153,12 @@ public:
      * Velocidade padrão do tanque.
      * Pode variar conforme o tipo do tanque ou bônus coletados.
      */
-    double default_speed;
+    Fixed default_speed;
 
     /**
      * Velocidade atual do tanque.
      */
-    double speed;
+    Fixed speed;
 
     /**
      * Indica se o tanque está parado.
@@ -132,9 +171,14 @@ public:
     Direction direction;
 
     /**
-     * Vetor com os projéteis disparados pelo tanque.
+     * Quantidade máxima de projéteis de um tanque ao mesmo tempo, independentemente dos bônus.
+     */
+    static const std::size_t MAX_BULLETS = 8;
+
+    /**
+     * Projéteis disparados pelo tanque (capacidade fixa, sem alocação).
      */
-    std::vector<Bullet*> bullets;
+    FixedVector<Bullet*, MAX_BULLETS> bullets;
 
     /**
      * Número de vidas do jogador ou nível de armadura do tanque inimigo.
@@ -147,11 +191,6 @@ protected:
      */
     TankStateFlags m_flags;
 
-    /**
-     * Tempo desde o início do deslize (gelo).
-     */
-    Sint32 m_slip_time;
-
     /**
      * Direção visual do tanque durante o deslize, pode ser diferente da direção real de movimento.
      */
@@ -162,6 +201,12 @@ protected:
      */
     unsigned m_bullet_max_size;
 
+    /**
+     * Parte de update() sem os projéteis: posição, retângulos de destino e colisão, escudo, barco e animação.
+     * @param dt - tempo desde a última chamada (em ms)
+     */
+    void updateTank(Uint32 dt);
+
     /**
      * Ponteiro para o escudo do tanque. nullptr se não houver escudo.
      */
@@ -171,16 +216,6 @@ protected:
      * Ponteiro para o barco do tanque. nullptr se não houver barco.
      */
     Object* m_boat;
-
-    /**
-     * Tempo desde que o escudo foi adquirido.
-     */
-    Uint32 m_shield_time;
-
-    /**
-     * Tempo desde que o tanque foi congelado.
-     */
-    Uint32 m_frozen_time;
 };
 
 #endif // TANK_H
@@ -0,0 +1,302 @@
+#include "replay.h"
+#include "appconfig.h"
+#include "app_state/game.h"
+#include "eventbus.h"
+#include "engine/engine.h"
+#include "engine/random.h"
+#include "engine/statebuffer.h"
+
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <iterator>
+
+// Identificação do formato do arquivo de replay ("TKRP")
+static const Uint32 REPLAY_MAGIC = 0x50524B54;
+static const Uint32 REPLAY_VERSION = 2;
+// Passo de tempo fixo dos replays (~60 ticks por segundo)
+static const Uint32 REPLAY_DT = 16;
+
+// Hash FNV-1a de 32 bits de um trecho do estado
+static Uint32 hashBytes(const Uint8* data, std::size_t size)
+{
+    Uint32 hash = 2166136261u;
+    for(std::size_t i = 0; i < size; i++)
+    {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+Replay::Replay()
+{
+    m_seed = 0;
+    m_level = 1;
+    m_player_count = 1;
+    m_dt = REPLAY_DT;
+    m_ticks = 0;
+    m_settings = currentSettings();
+}
+
+// Entrada de um "jogador" simples: mantém uma direção (ou fica parado) por 8 a 64 ticks e atira em ~1/4 dos ticks
+void Replay::generate(int level, int player_count, Uint32 ticks, Uint64 seed)
+{
+    m_settings = currentSettings();
+    m_seed = seed;
+    m_level = level;
+    m_player_count = player_count;
+    m_dt = REPLAY_DT;
+    m_ticks = ticks;
+    m_actions.assign(ticks * player_count, IA_NONE);
+    m_hashes.clear();
+
+    static const Uint8 directions[] = {IA_NONE, IA_UP, IA_DOWN, IA_LEFT, IA_RIGHT};
+    Random& random = Random::getInstance();
+    random.seed(seed ^ 0x5245504C4159ULL);
+    for(int p = 0; p < player_count; p++)
+    {
+        Uint8 direction = IA_NONE;
+        int hold = 0;
+        for(Uint32 t = 0; t < ticks; t++)
+        {
+            if(hold-- <= 0)
+            {
+                direction = directions[random.nextInt(5)];
+                hold = 8 + random.nextInt(57);
+            }
+            Uint8 actions = direction;
+            if(random.nextInt(4) == 0) actions |= IA_FIRE;
+            m_actions[t * player_count + p] = actions;
+        }
+    }
+}
+
+void Replay::record()
+{
+    std::string report;
+    run(false, report);
+}
+
+bool Replay::verify(std::string& report)
+{
+    if(m_hashes.size() != m_ticks * SS_COUNT)
+    {
+        report = "replay sem hashes de referencia";
+        return false;
+    }
+    return run(true, report);
+}
+
+// Reproduz a rodada sem janela: semente, passo de tempo e opções da simulação do replay, entrada lida do replay
+bool Replay::run(bool verify, std::string& report)
+{
+    if(!verify) m_hashes.assign(m_ticks * SS_COUNT, 0);
+
+    Settings previous = currentSettings();
+    applySettings(m_settings);
+    Random::getInstance().seed(m_seed);
+    Game* game = new Game(m_player_count, m_level);
+    std::vector<Uint8> state;
+    std::size_t sections[SS_COUNT];
+    bool ok = true;
+
+    for(Uint32 t = 0; t < m_ticks && ok; t++)
+    {
+        game->setScriptedInput(&m_actions[t * m_player_count]);
+        game->update(m_dt);
+        EventBus::getInstance().clear(); // sem consumidores: sons e estatísticas ficam de fora
+
+        StateWriter out(state);
+        game->saveState(out, sections);
+        std::size_t begin = 0;
+        for(int s = 0; s < SS_COUNT; s++)
+        {
+            Uint32 hash = hashBytes(state.data() + begin, sections[s] - begin);
+            begin = sections[s];
+
+            Uint32& golden = m_hashes[t * SS_COUNT + s];
+            if(!verify)
+                golden = hash;
+            else if(hash != golden)
+            {
+                std::ostringstream text;
+                text << "divergencia no tick " << t << ", subsistema " << sectionName(s) << std::hex << std::setfill('0')
+                     << " (esperado " << std::setw(8) << golden << ", obtido " << std::setw(8) << hash << ")";
+                report = text.str();
+                ok = false;
+                break;
+            }
+        }
+    }
+
+    delete game;
+    applySettings(previous);
+    return ok;
+}
+
+Replay::Settings Replay::currentSettings()
+{
+    Settings settings;
+    settings.level_file = AppConfig::level_file;
+    settings.level_chunk_cache = AppConfig::level_chunk_cache;
+    settings.horde_size = AppConfig::horde_size;
+    settings.enemy_start_count = AppConfig::enemy_start_count;
+    settings.enemy_max_count_on_map = AppConfig::enemy_max_count_on_map;
+    settings.lod_distance = AppConfig::lod_distance;
+    return settings;
+}
+
+void Replay::applySettings(const Settings& settings)
+{
+    AppConfig::level_file = settings.level_file;
+    AppConfig::level_chunk_cache = settings.level_chunk_cache;
+    AppConfig::horde_size = settings.horde_size;
+    AppConfig::enemy_start_count = settings.enemy_start_count;
+    AppConfig::enemy_max_count_on_map = settings.enemy_max_count_on_map;
+    AppConfig::lod_distance = settings.lod_distance;
+}
+
+std::string Replay::describeSettings() const
+{
+    std::ostringstream text;
+    if(!m_settings.level_file.empty()) text << "--level " << m_settings.level_file << " ";
+    if(m_settings.horde_size > 0) text << "--horde " << m_settings.horde_size << " ";
+    text << "--chunk-cache " << m_settings.level_chunk_cache << " --lod-distance " << m_settings.lod_distance;
+    return text.str();
+}
+
+bool Replay::load(const std::string& path)
+{
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    if(!file.is_open()) return false;
+    std::vector<Uint8> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    StateReader in(data.data(), data.size());
+    Uint32 magic, version;
+    in.read(magic);
+    in.read(version);
+    if(!in.ok() || magic != REPLAY_MAGIC || version != REPLAY_VERSION) return false;
+    in.read(m_seed);
+    in.read(m_level);
+    in.read(m_player_count);
+    in.read(m_dt);
+    in.read(m_ticks);
+
+    Uint32 length = 0;
+    in.read(length);
+    if(!in.ok() || length > data.size()) return false;
+    m_settings.level_file.assign(length, '\0');
+    if(length > 0) in.readBytes(reinterpret_cast<Uint8*>(&m_settings.level_file[0]), length);
+    in.read(m_settings.level_chunk_cache);
+    in.read(m_settings.horde_size);
+    in.read(m_settings.enemy_start_count);
+    in.read(m_settings.enemy_max_count_on_map);
+    in.read(m_settings.lod_distance);
+    if(!in.ok() || m_player_count < 1 || m_player_count > 4 || data.size() < m_ticks * (m_player_count + SS_COUNT * sizeof(Uint32))) return false;
+
+    m_actions.resize(m_ticks * m_player_count);
+    for(auto& actions : m_actions) in.read(actions);
+    m_hashes.resize(m_ticks * SS_COUNT);
+    for(auto& hash : m_hashes) in.read(hash);
+    return in.ok();
+}
+
+bool Replay::save(const std::string& path) const
+{
+    std::vector<Uint8> data;
+    StateWriter out(data);
+    out.write(REPLAY_MAGIC);
+    out.write(REPLAY_VERSION);
+    out.write(m_seed);
+    out.write(m_level);
+    out.write(m_player_count);
+    out.write(m_dt);
+    out.write(m_ticks);
+    out.write(static_cast<Uint32>(m_settings.level_file.size()));
+    out.writeBytes(reinterpret_cast<const Uint8*>(m_settings.level_file.data()), m_settings.level_file.size());
+    out.write(m_settings.level_chunk_cache);
+    out.write(m_settings.horde_size);
+    out.write(m_settings.enemy_start_count);
+    out.write(m_settings.enemy_max_count_on_map);
+    out.write(m_settings.lod_distance);
+    for(auto actions : m_actions) out.write(actions);
+    for(auto hash : m_hashes) out.write(hash);
+
+    std::ofstream file(path, std::ios::out | std::ios::binary);
+    if(!file.is_open()) return false;
+    file.write(reinterpret_cast<const char*>(data.data()), data.size());
+    return file.good();
+}
+
+// Executa (ou grava) os replays das 35 rodadas
+bool Replay::runSuite(const std::string& dir, bool generate)
+{
+    Engine::getEngine().initModules();
+
+    // Um único arquivo: apenas verifica
+    if(!generate && dir.size() > 4 && dir.compare(dir.size() - 4, 4, ".rpl") == 0)
+    {
+        Replay replay;
+        std::string report = "arquivo ausente ou invalido";
+        bool ok = replay.load(dir) && replay.verify(report);
+        // As opções gravadas valem no lugar das da linha de comando: exibidas para repetir o caso no jogo
+        std::cout << dir << " (" << replay.describeSettings() << "): " << (ok ? "ok" : report) << "\n";
+        Engine::getEngine().destroyModules();
+        return ok;
+    }
+
+    int failed = 0;
+    for(int level = 1; level <= 35; level++)
+    {
+        std::string path = dir + "level_" + (level < 10 ? "0" : "") + Engine::intToString(level) + ".rpl";
+        Replay replay;
+        std::string report;
+        if(generate)
+        {
+            // Dois jogadores para cobrir a interação entre eles
+            replay.generate(level, 2, AppConfig::replay_ticks, level);
+            replay.record();
+            if(!replay.save(path))
+            {
+                report = "nao foi possivel gravar";
+                failed++;
+            }
+        }
+        else if(!replay.load(path))
+        {
+            report = "arquivo ausente ou invalido";
+            failed++;
+        }
+        else if(!replay.verify(report))
+            failed++;
+
+        if(!report.empty()) std::cout << path << ": " << report << "\n";
+    }
+    std::cout << "Replays: " << 35 - failed << " ok, " << failed << " com falha\n";
+
+    Engine::getEngine().destroyModules();
+    return failed == 0;
+}
+
+const Uint8* Replay::actions(Uint32 tick) const
+{
+    return &m_actions[tick * m_player_count];
+}
+
+Uint32 Replay::ticks() const
+{
+    return m_ticks;
+}
+
+Uint32 Replay::dt() const
+{
+    return m_dt;
+}
+
+const char* Replay::sectionName(int section)
+{
+    static const char* names[SS_COUNT] = {"globals", "level", "eagle", "players", "enemies", "bonuses"};
+    return section >= 0 && section < SS_COUNT ? names[section] : "?";
+}
@@ -0,0 +1,143 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "type.h"
+
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+
+/**
+ * @brief
+ * Replay de regressão: entrada gravada de uma rodada (máscaras de @a InputAction por tick e por jogador)
+ * e os hashes de referência do estado da simulação após cada tick, um por @a StateSection.
+ * O arquivo também guarda as opções que mudam a simulação (--level, --chunk-cache, --horde, --lod-distance), que
+ * valem durante a reprodução no lugar das da linha de comando.
+ * A partida é reproduzida sem janela e sem som; como a simulação é determinística (semente fixa e
+ * passo de tempo fixo), qualquer diferença de hash indica mudança de comportamento, e o primeiro
+ * tick e subsistema divergentes são informados.
+ */
+class Replay
+{
+public:
+    Replay();
+
+    /**
+     * Cria uma entrada pseudoaleatória reprodutível (cada jogador mantém uma direção por alguns ticks e atira de vez em quando).
+     * Os hashes de referência são descartados; use record() para gerá-los. As opções atuais da simulação são guardadas.
+     * @param level - rodada (1 a 35)
+     * @param player_count - quantidade de jogadores
+     * @param ticks - quantidade de ticks
+     * @param seed - semente da entrada e da simulação
+     */
+    void generate(int level, int player_count, Uint32 ticks, Uint64 seed);
+
+    /**
+     * Reproduz a entrada e grava os hashes de cada tick como referência.
+     */
+    void record();
+
+    /**
+     * Reproduz a entrada e compara os hashes de cada tick com a referência.
+     * @param report - recebe a descrição da primeira divergência
+     * @return @a false se algum tick divergir
+     */
+    bool verify(std::string& report);
+
+    /**
+     * Lê um replay gravado por save().
+     * @param path - caminho do arquivo
+     * @return @a false se o arquivo não existir ou for inválido
+     */
+    bool load(const std::string& path);
+
+    /**
+     * Grava o replay (entrada e hashes de referência) em um arquivo binário.
+     * @param path - caminho do arquivo
+     * @return @a false se não for possível gravar
+     */
+    bool save(const std::string& path) const;
+
+    /**
+     * Executa o conjunto de replays das 35 rodadas sem janela.
+     * @param dir - pasta dos arquivos level_NN.rpl, ou um único arquivo .rpl a verificar (ex.: um pior caso de @a FrameSearch)
+     * @param generate - @a true grava novos replays e referências; @a false verifica os existentes
+     * @return @a false se algum replay estiver ausente ou divergir
+     */
+    static bool runSuite(const std::string& dir, bool generate);
+
+    /**
+     * Retorna a entrada gravada de um tick.
+     * @param tick - tick (menor que ticks())
+     * @return máscaras de @a InputAction dos jogadores, no formato de Game::setScriptedInput()
+     */
+    const Uint8* actions(Uint32 tick) const;
+
+    /**
+     * @return quantidade de ticks gravados
+     */
+    Uint32 ticks() const;
+
+    /**
+     * @return passo de tempo de cada tick em milissegundos
+     */
+    Uint32 dt() const;
+
+    /**
+     * Retorna o nome de uma seção do estado, usado nos relatórios.
+     * @param section - seção
+     * @return nome do subsistema
+     */
+    static const char* sectionName(int section);
+
+private:
+    friend class FrameSearch;
+
+    /**
+     * @brief Opções de @a AppConfig que mudam a simulação, gravadas no replay.
+     */
+    struct Settings
+    {
+        std::string level_file;         ///< AppConfig::level_file.
+        unsigned level_chunk_cache;     ///< AppConfig::level_chunk_cache.
+        unsigned horde_size;            ///< AppConfig::horde_size.
+        unsigned enemy_start_count;     ///< AppConfig::enemy_start_count (muda com a horda).
+        int enemy_max_count_on_map;     ///< AppConfig::enemy_max_count_on_map (muda com a horda).
+        unsigned lod_distance;          ///< AppConfig::lod_distance.
+    };
+
+    /**
+     * @return opções atuais de @a AppConfig
+     */
+    static Settings currentSettings();
+
+    /**
+     * Aplica opções em @a AppConfig.
+     * @param settings - opções
+     */
+    static void applySettings(const Settings& settings);
+
+    /**
+     * @return opções gravadas no formato da linha de comando, usadas nos relatórios
+     */
+    std::string describeSettings() const;
+
+    /**
+     * Reproduz a entrada; em cada tick grava o hash (@a verify falso) ou o compara com a referência.
+     * @param verify - compara em vez de gravar
+     * @param report - recebe a descrição da primeira divergência
+     * @return @a false na primeira divergência
+     */
+    bool run(bool verify, std::string& report);
+
+    Settings m_settings;            ///< Opções da simulação usadas na gravação.
+    Uint64 m_seed;                  ///< Semente da simulação.
+    int m_level;                    ///< Rodada reproduzida.
+    int m_player_count;             ///< Quantidade de jogadores.
+    Uint32 m_dt;                    ///< Passo de tempo de cada tick em milissegundos.
+    Uint32 m_ticks;                 ///< Quantidade de ticks.
+    std::vector<Uint8> m_actions;   ///< Máscaras de entrada: m_ticks x m_player_count.
+    std::vector<Uint32> m_hashes;   ///< Hashes de referência: m_ticks x SS_COUNT.
+};
+
+#endif // REPLAY_H
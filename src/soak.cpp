@@ -0,0 +1,316 @@
+#include "soak.h"
+#include "app.h"
+#include "appconfig.h"
+#include "app_state/game.h"
+#include "app_state/menu.h"
+#include "app_state/scores.h"
+#include "app_state/pausemenu.h"
+#include "engine/engine.h"
+#include "engine/memorystats.h"
+#include "engine/random.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+Uint64 Soak::m_random_state = 0;
+Uint8 Soak::m_actions[4] = {};
+Uint8 Soak::m_directions[4] = {};
+Uint32 Soak::m_hold[4] = {};
+Uint32 Soak::m_rewind_hold = 0;
+
+// Nomes dos estados no relatório, na ordem de StateKind
+static const char* const STATE_NAMES[] = {"menu", "partida", "placar", "pausa", "confirmacao"};
+
+bool Soak::run(unsigned minutes)
+{
+    Engine::getEngine().initModules();
+    // Uma semente para a entrada e outra, derivada dela, para a simulação
+    Uint64 seed = AppConfig::soak_seed != 0 ? AppConfig::soak_seed : SDL_GetPerformanceCounter();
+    Random& random = Random::getInstance();
+    random.seed(seed);
+    m_random_state = random.state();
+    random.seed(seed + 1);
+    std::cout << "Teste de longa duracao: semente " << seed << " (repetir com --soak " << minutes << " " << seed << ")\n";
+
+    // A mesma pilha de estados da aplicação, sem janela
+    App* app = new App;
+    app->m_states.push_back(new Menu);
+    MemoryStats::markBaseline();
+
+    double frequency = SDL_GetPerformanceFrequency() / 1000000.0;
+    double duration_us = minutes * 60.0 * 1000000.0;
+    double window_us = std::max(duration_us / WINDOWS, MIN_WINDOW_S * 1000000.0);
+    std::vector<double> frames, transitions[SK_COUNT];
+    std::vector<Window> windows;
+    std::vector<Uint64> menu_resident;
+    bool levels[36] = {};
+    Uint64 start = SDL_GetPerformanceCounter(), window_start = start;
+
+    while(true)
+    {
+        Uint64 now = SDL_GetPerformanceCounter();
+        if((now - window_start) / frequency >= window_us)
+        {
+            Window window = closeWindow(frames, transitions);
+            windows.push_back(window);
+            window_start = now;
+
+            int visited = 0;
+            for(int level = 1; level <= 35; level++) visited += levels[level];
+            std::cout << std::fixed << std::setprecision(1) << "[" << std::setw(5) << (now - start) / frequency / 1000000.0
+                      << " s] " << window.frames << " frames da partida, p50 " << window.frame_p50 << " us, p99 " << window.frame_p99
+                      << " us, max " << window.frame_max << " us, trocas";
+            for(int k = 0; k < SK_COUNT; k++) std::cout << " " << STATE_NAMES[k] << " " << window.transitions[k];
+            std::cout << ", RSS " << window.resident / 1024.0 / 1024.0 << " MB, rodadas " << visited << "/35\n";
+
+            if((now - start) / frequency >= duration_us) break;
+        }
+
+        // Troca de estado, como no início de cada frame do App
+        AppState* top = app->m_states.back();
+        bool finishing = top->finished();
+        std::size_t depth = app->m_states.size();
+        Uint64 transition_start = SDL_GetPerformanceCounter();
+        app->updateStack();
+        // "Exit" ou Escape no menu encerram a aplicação: o teste abre outro menu
+        if(app->m_states.empty()) app->m_states.push_back(new Menu);
+        if(finishing || app->m_states.size() != depth)
+        {
+            StateKind next = kind(app->m_states.back());
+            transitions[next].push_back((SDL_GetPerformanceCounter() - transition_start) / frequency);
+            // A memória da primeira janela inclui o aquecimento (rodadas lidas pela primeira vez, caches vazios)
+            if(next == SK_MENU && !windows.empty()) menu_resident.push_back(residentBytes());
+        }
+
+        top = app->m_states.back();
+        input(top);
+
+        Uint64 frame_start = SDL_GetPerformanceCounter();
+        top->update(TICK);
+        app->dispatchEvents();
+        app->drawStates();
+        double frame_time = (SDL_GetPerformanceCounter() - frame_start) / frequency;
+
+        // Os tempos de frame são os da partida: menus, placar e a tela STAGE (em que Game::update não faz nada) custam
+        // pouco e mudariam a mediana conforme a mistura
+        Game* game = dynamic_cast<Game*>(top);
+        if(game == nullptr || game->m_level_start_screen) continue;
+        frames.push_back(frame_time);
+        if(game->m_current_level >= 0 && game->m_current_level <= 35) levels[game->m_current_level] = true;
+    }
+
+    delete app;
+    bool ok = MemoryStats::checkLeaks("fim do teste", true);
+    Engine::getEngine().destroyModules();
+
+    // Resultado: vazamentos, crescimento da memória na volta ao menu e aumento dos tempos
+    Uint64 frame_count = 0;
+    unsigned transition_count = 0;
+    int visited = 0;
+    for(const Window& window : windows)
+    {
+        frame_count += window.frames;
+        for(int k = 0; k < SK_COUNT; k++) transition_count += window.transitions[k];
+    }
+    for(int level = 1; level <= 35; level++) visited += levels[level];
+    std::cout << "Teste de longa duracao: " << frame_count << " frames da partida, " << transition_count << " trocas de estado, "
+              << menu_resident.size() << " voltas ao menu, rodadas visitadas " << visited << "/35\n";
+
+    if(MemoryStats::leaks() > 0)
+    {
+        std::cout << "FALHA: " << MemoryStats::leaks() << " vazamentos de objetos do jogo\n";
+        ok = false;
+    }
+
+    std::size_t third = menu_resident.size() / 3;
+    if(third > 0 && menu_resident.front() > 0)
+    {
+        Uint64 minimum[3];
+        for(int part = 0; part < 3; part++)
+        {
+            std::size_t begin = part * third, end = part == 2 ? menu_resident.size() : begin + third;
+            minimum[part] = *std::min_element(menu_resident.begin() + begin, menu_resident.begin() + end);
+        }
+        if(minimum[0] < minimum[1] && minimum[1] < minimum[2] && minimum[2] - minimum[0] > GROWTH_SLACK_KB * 1024ULL)
+        {
+            std::cout << std::fixed << std::setprecision(1) << "FALHA: memoria residente crescendo na volta ao menu ("
+                      << minimum[0] / 1024.0 / 1024.0 << " -> " << minimum[1] / 1024.0 / 1024.0 << " -> "
+                      << minimum[2] / 1024.0 / 1024.0 << " MB)\n";
+            ok = false;
+        }
+    }
+
+    double before, after;
+    std::vector<double> series;
+    for(const Window& window : windows) series.push_back(window.frame_p50);
+    if(drifted(series, before, after))
+    {
+        std::cout << std::fixed << std::setprecision(1) << "FALHA: mediana do frame subiu de " << before << " para " << after << " us\n";
+        ok = false;
+    }
+    for(int k = 0; k < SK_COUNT; k++)
+    {
+        series.clear();
+        for(const Window& window : windows) series.push_back(window.transition_p50[k]);
+        if(drifted(series, before, after))
+        {
+            std::cout << std::fixed << std::setprecision(1) << "FALHA: mediana da troca para " << STATE_NAMES[k] << " subiu de "
+                      << before << " para " << after << " us\n";
+            ok = false;
+        }
+    }
+
+    if(ok) std::cout << "Teste de longa duracao: ok\n";
+    return ok;
+}
+
+Soak::StateKind Soak::kind(AppState* state)
+{
+    if(dynamic_cast<Game*>(state) != nullptr) return SK_GAME;
+    if(dynamic_cast<Scores*>(state) != nullptr) return SK_SCORES;
+    if(dynamic_cast<PauseMenu*>(state) != nullptr) return SK_PAUSE;
+    if(dynamic_cast<Menu*>(state) != nullptr) return SK_MENU;
+    return SK_CONFIRM;
+}
+
+// Frequências pensadas para visitar todos os caminhos: a cada ~2 s de jogo uma rodada é pulada com N (ou B, que a partir
+// da rodada 1 volta para as últimas)
+void Soak::input(AppState* state)
+{
+    static const SDL_Keycode MENU_KEYS[] = {SDLK_UP, SDLK_DOWN, SDLK_DOWN, SDLK_RETURN, SDLK_RETURN};
+    static const SDL_Keycode WINDOW_KEYS[] = {SDLK_UP, SDLK_DOWN, SDLK_LEFT, SDLK_RETURN, SDLK_ESCAPE};
+    static const Uint8 DIRECTIONS[] = {IA_NONE, IA_UP, IA_DOWN, IA_LEFT, IA_RIGHT};
+
+    switch(kind(state))
+    {
+    case SK_MENU:
+        if(nextInt(8) == 0) press(state, nextInt(40) == 0 ? SDLK_ESCAPE : MENU_KEYS[nextInt(5)]);
+        break;
+    case SK_SCORES:
+        if(nextInt(20) == 0) press(state, SDLK_RETURN);
+        break;
+    case SK_PAUSE:
+    case SK_CONFIRM:
+        if(nextInt(20) == 0) press(state, WINDOW_KEYS[nextInt(5)]);
+        break;
+    case SK_GAME:
+    {
+        // Cada jogador mantém uma direção sorteada por 8 a 60 ticks e atira em ~1/4 dos ticks
+        Game* game = static_cast<Game*>(state);
+        for(int i = 0; i < 4; i++)
+        {
+            if(m_hold[i] == 0)
+            {
+                m_hold[i] = 8 + nextInt(53);
+                m_directions[i] = DIRECTIONS[nextInt(5)];
+            }
+            m_hold[i]--;
+            m_actions[i] = m_directions[i] | (nextInt(4) == 0 ? IA_FIRE : 0);
+        }
+        game->setScriptedInput(m_actions);
+
+        if(m_rewind_hold > 0 && --m_rewind_hold == 0) press(game, SDLK_BACKSPACE, SDL_KEYUP);
+        if(game->m_pause)
+        {
+            if(nextInt(100) == 0) press(game, SDLK_RETURN);
+            break;
+        }
+        // Teclas só depois da tela STAGE, para que as rodadas sejam jogadas antes de serem puladas
+        if(game->m_level_start_screen) break;
+
+        int roll = nextInt(4000);
+        if(roll < 30) press(game, SDLK_n);
+        else if(roll < 40) press(game, SDLK_b);
+        else if(roll < 43) press(game, SDLK_ESCAPE);
+        else if(roll < 44) press(game, SDLK_RETURN);
+        else if(roll < 46 && m_rewind_hold == 0)
+        {
+            press(game, SDLK_BACKSPACE);
+            m_rewind_hold = 30 + nextInt(90);
+        }
+        else if(roll == 46) press(game, SDLK_m);
+        else if(roll == 47) press(game, SDLK_t);
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+void Soak::press(AppState* state, SDL_Keycode key, Uint32 type)
+{
+    SDL_Event event = {};
+    event.type = type;
+    event.key.type = type;
+    event.key.state = type == SDL_KEYDOWN ? SDL_PRESSED : SDL_RELEASED;
+    event.key.keysym.sym = key;
+    state->eventProcess(&event);
+}
+
+Soak::Window Soak::closeWindow(std::vector<double>& frames, std::vector<double>* transitions)
+{
+    Window window;
+    window.frames = frames.size();
+    window.frame_p50 = percentile(frames, 50);
+    window.frame_p99 = percentile(frames, 99);
+    window.frame_max = percentile(frames, 100);
+    for(int k = 0; k < SK_COUNT; k++)
+    {
+        window.transitions[k] = transitions[k].size();
+        window.transition_p50[k] = percentile(transitions[k], 50);
+        transitions[k].clear();
+    }
+    window.resident = residentBytes();
+    frames.clear();
+    return window;
+}
+
+// A primeira janela fica de fora, como na memória
+bool Soak::drifted(const std::vector<double>& series, double& before, double& after)
+{
+    if(series.size() < 4) return false;
+    std::vector<double> first, last;
+    std::size_t third = (series.size() - 1) / 3;
+    for(std::size_t i = 1; i <= third; i++) if(series[i] >= 0) first.push_back(series[i]);
+    for(std::size_t i = series.size() - third; i < series.size(); i++) if(series[i] >= 0) last.push_back(series[i]);
+    if(first.empty() || last.empty()) return false;
+
+    before = percentile(first, 50);
+    after = percentile(last, 50);
+    return after > before * (100 + DRIFT_PERCENT) / 100 + DRIFT_SLACK_US;
+}
+
+double Soak::percentile(std::vector<double>& values, unsigned percent)
+{
+    if(values.empty()) return -1;
+    std::size_t index = std::min(values.size() - 1, values.size() * percent / 100);
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+// Segundo campo de /proc/self/statm: páginas residentes
+Uint64 Soak::residentBytes()
+{
+#ifdef __linux__
+    std::ifstream statm("/proc/self/statm");
+    Uint64 pages = 0, resident = 0;
+    if(statm >> pages >> resident) return resident * static_cast<Uint64>(sysconf(_SC_PAGESIZE));
+#endif
+    return 0;
+}
+
+int Soak::nextInt(int max)
+{
+    Random& random = Random::getInstance();
+    Uint64 game_state = random.state();
+    random.setState(m_random_state);
+    int value = random.nextInt(max);
+    m_random_state = random.state();
+    random.setState(game_state);
+    return value;
+}
@@ -0,0 +1,133 @@
+#ifndef SOAK_H
+#define SOAK_H
+
+#include "app_state/appstate.h"
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+/**
+ * @brief
+ * Teste de longa duração sem janela (opção --soak [minutos [semente]]). Percorre a mesma pilha de estados do @a App
+ * (menu, partida, placar, menu de pausa, confirmação) com entrada aleatória: escolhas no menu, tanques dirigidos por
+ * entrada sorteada, rodadas puladas com N e B, pausa, retrocesso e saída pelo menu de pausa. A partida avança em ticks
+ * de 16 ms sem esperar pelo relógio, então uma hora de teste cobre muitas horas de jogo.
+ *
+ * A semente da entrada e da simulação é impressa no início (@a AppConfig::soak_seed repete a sequência).
+ *
+ * O tempo é dividido em janelas; em cada uma são medidos os tempos de frame da partida fora da tela STAGE (update + draw), a latência das trocas de
+ * estado (montagem da partida, carga da rodada seguinte, placar...) e a memória residente do processo. O teste falha se:
+ *   - algum objeto do jogo continuar vivo quando o menu volta (@a MemoryStats::checkLeaks);
+ *   - a memória residente medida na volta ao menu crescer de terço em terço do teste;
+ *   - a mediana dos frames ou das trocas de estado no último terço ficar muito acima da do primeiro terço.
+ */
+class Soak
+{
+public:
+    /**
+     * Executa o teste.
+     * @param minutes - duração em minutos (tempo real)
+     * @return @a false se houver vazamento, crescimento de memória ou aumento dos tempos
+     */
+    static bool run(unsigned minutes);
+
+private:
+    static const Uint32 TICK = 16;              ///< Passo de tempo de cada tick em milissegundos.
+    static const unsigned WINDOWS = 20;         ///< Janelas de medição do teste.
+    static const unsigned MIN_WINDOW_S = 5;     ///< Duração mínima de uma janela em segundos.
+    static const unsigned DRIFT_PERCENT = 50;   ///< Aumento tolerado da mediana entre o primeiro e o último terço.
+    static const unsigned DRIFT_SLACK_US = 200; ///< Aumento tolerado em microssegundos, além de @a DRIFT_PERCENT.
+    static const unsigned GROWTH_SLACK_KB = 4096; ///< Crescimento tolerado da memória residente na volta ao menu.
+
+    /**
+     * @brief Estados da pilha, para separar as medições das trocas pelo estado que passa ao topo.
+     */
+    enum StateKind
+    {
+        SK_MENU,
+        SK_GAME,
+        SK_SCORES,
+        SK_PAUSE,
+        SK_CONFIRM,
+        SK_COUNT
+    };
+
+    /**
+     * @brief Medições de uma janela, em microssegundos (-1: nenhuma troca do tipo na janela).
+     */
+    struct Window
+    {
+        Uint64 frames;                      ///< Frames da partida executados.
+        double frame_p50;                   ///< Mediana dos frames.
+        double frame_p99;                   ///< Percentil 99 dos frames.
+        double frame_max;                   ///< Frame mais lento.
+        unsigned transitions[SK_COUNT];     ///< Trocas de estado por estado que passou ao topo.
+        double transition_p50[SK_COUNT];    ///< Mediana das trocas de estado.
+        Uint64 resident;                    ///< Memória residente no fim da janela, em bytes.
+    };
+
+    /**
+     * @param state - estado do topo da pilha
+     * @return tipo do estado
+     */
+    static StateKind kind(AppState* state);
+
+    /**
+     * Sorteia a entrada do frame para o estado do topo: teclas enviadas a eventProcess() e, na partida, as ações dos
+     * jogadores (Game::setScriptedInput).
+     * @param state - estado do topo da pilha
+     */
+    static void input(AppState* state);
+
+    /**
+     * Entrega ao estado um evento de tecla.
+     * @param state - destino
+     * @param key - tecla
+     * @param type - SDL_KEYDOWN ou SDL_KEYUP
+     */
+    static void press(AppState* state, SDL_Keycode key, Uint32 type = SDL_KEYDOWN);
+
+    /**
+     * Fecha uma janela: calcula as medianas e percentis e esvazia as amostras.
+     * @param frames - tempos de frame da janela (reordenados)
+     * @param transitions - latências das trocas de estado da janela, por tipo (esvaziadas)
+     * @return medições da janela
+     */
+    static Window closeWindow(std::vector<double>& frames, std::vector<double>* transitions);
+
+    /**
+     * Compara a mediana dos valores do último terço da série com a do primeiro terço; valores negativos são ignorados.
+     * @param series - um valor por janela
+     * @param before - recebe a mediana do primeiro terço
+     * @param after - recebe a mediana do último terço
+     * @return @a true se o aumento passar de @a DRIFT_PERCENT e @a DRIFT_SLACK_US
+     */
+    static bool drifted(const std::vector<double>& series, double& before, double& after);
+
+    /**
+     * @param values - amostras (reordenadas)
+     * @param percent - percentil desejado
+     * @return valor do percentil, ou -1 sem amostras
+     */
+    static double percentile(std::vector<double>& values, unsigned percent);
+
+    /**
+     * @return memória residente do processo em bytes (0 se não puder ser lida neste sistema)
+     */
+    static Uint64 residentBytes();
+
+    /**
+     * Sorteios da entrada, com estado próprio para não mexer na sequência do gerador da simulação.
+     * @param max - limite superior (exclusivo)
+     * @return inteiro em [0, max)
+     */
+    static int nextInt(int max);
+
+    static Uint64 m_random_state;   ///< Estado do gerador da entrada.
+    static Uint8 m_actions[4];      ///< Ações dos jogadores no tick (máscaras @a InputAction).
+    static Uint8 m_directions[4];   ///< Direção mantida por cada jogador.
+    static Uint32 m_hold[4];        ///< Ticks restantes da direção de cada jogador.
+    static Uint32 m_rewind_hold;    ///< Ticks restantes com o retrocesso (Backspace) pressionado.
+};
+
+#endif // SOAK_H
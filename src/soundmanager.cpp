@@ -1,5 +1,6 @@
 // sound_manager.cpp
 #include "soundmanager.h"
+#include "engine/memorystats.h"
 #include <iostream>
 
 SoundManager& SoundManager::getInstance() {
@@ -38,24 +39,53 @@ void SoundManager::loadSounds() {
             std::cerr << "Erro ao carregar som [" << name << "]: " << Mix_GetError() << "\n";
         } else {
             Mix_VolumeChunk(chunk, 64);  // 50% volume
+            MemoryStats::allocated(MT_SOUNDS, sizeof(Mix_Chunk) + chunk->alen);
         }
     }
 }
 
-void SoundManager::playSound(const std::string& name, int loops) {
+void SoundManager::playSound(const char* name, int loops) {
+    if (m_muted) return;
     auto it = m_sounds.find(name);
     if (it != m_sounds.end() && it->second) {
         Mix_PlayChannel(-1, it->second, loops);
     }
 }
 
+void SoundManager::playEvent(const GameEvent& event) {
+    switch (event.type) {
+    case GE_SHOT: playSound("shoot"); break;
+    case GE_HIT: playSound("player_exp"); break;
+    case GE_SHIELD_HIT: playSound("shieldhit"); break;
+    case GE_KILL:
+        playSound("shell_exp");
+        if (event.source >= ST_TANK_A && event.source <= ST_TANK_D) playSound("eexplosion");
+        break;
+    case GE_BRICK_HIT:
+        playSound("brick_hit");
+        if (event.source == ST_STONE_WALL) playSound("steelhit");
+        break;
+    case GE_ICE: playSound("ice"); break;
+    case GE_BONUS_PICKED: playSound("bonus"); break;
+    case GE_LIFE: playSound("life"); break;
+    case GE_LEVEL_START: playSound("level_starting"); break;
+    case GE_LEVEL_END: playSound("game_over"); break;
+    default: break; // events without sound
+    }
+}
+
 void SoundManager::setVolume(int volume) {
     for (auto& [_, chunk] : m_sounds)
         Mix_VolumeChunk(chunk, volume);
 }
 
+void SoundManager::setMuted(bool muted) {
+    m_muted = muted;
+}
+
 void SoundManager::cleanup() {
     for (auto& [_, chunk] : m_sounds) {
+        if (chunk) MemoryStats::released(MT_SOUNDS, sizeof(Mix_Chunk) + chunk->alen);
         Mix_FreeChunk(chunk);
     }
     m_sounds.clear();
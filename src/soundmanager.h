@@ -1,5 +1,6 @@
 // soundmanager.h
 #pragma once
+#include "eventbus.h"
 #include <SDL2/SDL_mixer.h>
 #include <string>
 #include <map>
@@ -12,8 +13,13 @@ public:
     void loadSounds();
     // Plays the sound associated with 'name'. 
     // 'loops' specifies the number of times to loop the sound (0 = play once, -1 = infinite).
-    void playSound(const std::string& name, int loops = 0);
+    // The lookup compares 'name' directly with the keys, without building a std::string.
+    void playSound(const char* name, int loops = 0);
+    // Plays the sounds of a gameplay event drained from the EventBus.
+    void playEvent(const GameEvent& event);
     void setVolume(int volume);
+    // While muted, playSound() does nothing (used by the turbo mode to decimate sounds).
+    void setMuted(bool muted);
     void cleanup();
 
 private:
@@ -22,5 +28,6 @@ private:
     SoundManager(const SoundManager&) = delete;
     SoundManager& operator=(const SoundManager&) = delete;
 
-    std::map<std::string, Mix_Chunk*> m_sounds;
+    std::map<std::string, Mix_Chunk*, std::less<>> m_sounds;
+    bool m_muted = false;
 };
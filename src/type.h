@@ -83,4 +83,88 @@ enum Direction
     D_LEFT = 3    // Esquerda
 };
 
+/**
+ * @brief Enum das ações de entrada de um jogador em um tick.
+ * Usado como máscara de bits: todos os dispositivos são amostrados uma vez por tick
+ * e o resultado é entregue ao jogador como uma única máscara.
+ */
+enum InputAction
+{
+    IA_NONE         = 0,      // Nenhuma ação
+    IA_UP           = 1 << 0, // Mover para cima
+    IA_DOWN         = 1 << 1, // Mover para baixo
+    IA_LEFT         = 1 << 2, // Mover para a esquerda
+    IA_RIGHT        = 1 << 3, // Mover para a direita
+    IA_FIRE         = 1 << 4  // Disparar
+};
+
+/**
+ * @brief Enum das seções do estado salvo por Game::saveState, na ordem em que são gravadas.
+ * Cada seção corresponde a um subsistema da simulação e recebe seu próprio hash nos replays,
+ * o que permite apontar qual subsistema divergiu.
+ */
+enum StateSection
+{
+    SS_GLOBALS,       // Gerador aleatório, rodada e temporizadores
+    SS_LEVEL,         // Mapa (tijolos, pedras, água, gelo) e arbustos
+    SS_EAGLE,         // Águia
+    SS_PLAYERS,       // Jogadores e seus projéteis
+    SS_ENEMIES,       // Inimigos e seus projéteis
+    SS_BONUSES,       // Bônus no mapa
+    SS_COUNT          // Quantidade de seções
+};
+
+/**
+ * @brief Enum das fases de Game::update, na ordem em que são executadas, medidas separadamente na busca do pior frame
+ * (ver Game::measurePhases).
+ */
+enum UpdatePhase
+{
+    UP_INPUT,         // Trechos da rodada e entrada dos jogadores
+    UP_COLLISIONS,    // Colisões entre tanques, projéteis, cenário e bônus
+    UP_TARGETS,       // Alvo dos inimigos
+    UP_TIMERS,        // Temporizadores (IA dos inimigos, escudos, bônus, eventos da rodada)
+    UP_OBJECTS,       // Atualização dos objetos, remoções e entrada de inimigos
+    UP_REWIND,        // Estado do tick guardado para o retrocesso
+    UP_COUNT          // Quantidade de fases
+};
+
+/**
+ * @brief Enum dos temporizadores agendados na roda de temporizadores da partida (TimerWheel).
+ * Cada objeto usa apenas os seus; o total não pode passar de TimerListener::MAX_TIMERS.
+ */
+enum TimerId
+{
+    TI_SHIELD,          // Fim do escudo do tanque
+    TI_FROZEN,          // Fim do congelamento do tanque
+    TI_SLIP,            // Fim do deslize no gelo
+    TI_RELOAD,          // Fim da recarga do jogador
+    TI_DIRECTION,       // Troca de direção do inimigo
+    TI_MOVE,            // Inimigo volta a andar
+    TI_FIRE,            // Tentativa de disparo do inimigo
+    TI_BONUS_SHOW,      // Fim da exibição do bônus
+    TI_BONUS_BLINK,     // Próxima troca de visibilidade do bônus (piscar)
+    TI_ENEMY_SPAWN,     // Próximo inimigo pode entrar no mapa
+    TI_LEVEL_END,       // Fim da rodada após eliminar todos os inimigos
+    TI_PROTECT_EAGLE,   // Fim da proteção de pedra da águia
+    TI_COUNT            // Quantidade de temporizadores
+};
+
+/**
+ * @brief Enum das categorias de memória contabilizadas por MemoryStats.
+ * Cada alocação é registrada na categoria do subsistema que a fez.
+ */
+enum MemoryTag
+{
+    MT_TERRAIN,       // Tijolos, pedras, água, gelo, arbustos e águia
+    MT_TANKS,         // Jogadores, inimigos, escudos e barcos
+    MT_BULLETS,       // Projéteis
+    MT_BONUSES,       // Bônus no mapa
+    MT_TEXTURES,      // Textura dos sprites
+    MT_FONTS,         // Fontes (tamanho do arquivo, aproximado)
+    MT_SOUNDS,        // Sons carregados
+    MT_TEXT,          // Texturas de texto
+    MT_COUNT          // Quantidade de categorias
+};
+
 #endif // TYPE_H